@@ -0,0 +1,140 @@
+#include <cstdio>
+
+#include <highfive/H5File.hpp>
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+
+#include "benchmark.h"
+#include "synthetic.h"
+
+namespace {
+
+/**
+   Rewrite the h5 v1.1 file source, as written by MorphIO, in the older layouts: v1 is the same
+   without the metadata group, v2 moves everything under /neuron1 with the section types in
+   their own dataset
+**/
+void convertH5(const std::string& source, const std::string& path, bool v2) {
+    std::vector<std::vector<morphio::floatType>> points;
+    std::vector<std::vector<int>> structure;
+    {
+        HighFive::File input(source, HighFive::File::ReadOnly);
+        input.getDataSet("/points").read(points);
+        input.getDataSet("/structure").read(structure);
+    }
+
+    HighFive::File output(path,
+                          HighFive::File::ReadWrite | HighFive::File::Create |
+                              HighFive::File::Truncate);
+    if (!v2) {
+        output.createDataSet<morphio::floatType>("/points", HighFive::DataSpace::From(points))
+            .write(points);
+        output.createDataSet<int>("/structure", HighFive::DataSpace::From(structure))
+            .write(structure);
+        return;
+    }
+
+    // v1 structure rows are (first point, type, parent), v2 ones (first point, parent)
+    std::vector<std::vector<int>> v2Structure;
+    std::vector<int> types;
+    for (const auto& row : structure) {
+        v2Structure.push_back({row[0], row[2]});
+        types.push_back(row[1]);
+    }
+    HighFive::Group root = output.createGroup("neuron1");
+    root.createGroup("repaired")
+        .createDataSet<morphio::floatType>("points", HighFive::DataSpace::From(points))
+        .write(points);
+    HighFive::Group group = root.createGroup("structure");
+    group.createDataSet<int>("repaired", HighFive::DataSpace::From(v2Structure))
+        .write(v2Structure);
+    group.createDataSet<int>("sectiontype", HighFive::DataSpace::From(types)).write(types);
+}
+
+/**
+   Write a synthetic neuron of nSections sections of 20 points in the given format and return
+   the file name. Formats are file extensions, plus "h5v1" and "h5v2" for the older h5 layouts
+**/
+std::string neuronFile(const std::string& format, uint32_t nSections) {
+    const std::string prefix = "morphio_bench_load_" + std::to_string(nSections);
+    auto neuron = bench::syntheticNeuron(nSections, 20);
+    if (format == "h5v1" || format == "h5v2") {
+        const std::string source = prefix + "_v11.h5";
+        const std::string path = prefix + "_" + format + ".h5";
+        neuron.write(source);
+        convertH5(source, path, format == "h5v2");
+        std::remove(source.c_str());
+        return path;
+    }
+    const std::string path = prefix + "." + format;
+    neuron.write(path);
+    return path;
+}
+
+void benchmarkLoad(bench::State& state,
+                   const std::string& format,
+                   uint32_t nSections,
+                   unsigned int options = 0) {
+    const bench::TemporaryFile file(neuronFile(format, nSections));
+    size_t points = 0;
+    state.measure([&]() { points = morphio::Morphology(file.path, options).points().size(); });
+    state.counter("points", static_cast<double>(points));
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(load_swc_1k) {
+    benchmarkLoad(state, "swc", 1000);
+}
+
+MORPHIO_BENCHMARK(load_swc_10k) {
+    benchmarkLoad(state, "swc", 10000);
+}
+
+MORPHIO_BENCHMARK(load_asc_1k) {
+    benchmarkLoad(state, "asc", 1000);
+}
+
+MORPHIO_BENCHMARK(load_asc_10k) {
+    benchmarkLoad(state, "asc", 10000);
+}
+
+MORPHIO_BENCHMARK(load_h5v1_1k) {
+    benchmarkLoad(state, "h5v1", 1000);
+}
+
+MORPHIO_BENCHMARK(load_h5v1_10k) {
+    benchmarkLoad(state, "h5v1", 10000);
+}
+
+MORPHIO_BENCHMARK(load_h5v11_1k) {
+    benchmarkLoad(state, "h5", 1000);
+}
+
+MORPHIO_BENCHMARK(load_h5v11_10k) {
+    benchmarkLoad(state, "h5", 10000);
+}
+
+MORPHIO_BENCHMARK(load_h5v2_1k) {
+    benchmarkLoad(state, "h5v2", 1000);
+}
+
+MORPHIO_BENCHMARK(load_h5v2_10k) {
+    benchmarkLoad(state, "h5v2", 10000);
+}
+
+MORPHIO_BENCHMARK(load_mbin_1k) {
+    benchmarkLoad(state, "mbin", 1000);
+}
+
+MORPHIO_BENCHMARK(load_mbin_10k) {
+    benchmarkLoad(state, "mbin", 10000);
+}
+
+MORPHIO_BENCHMARK(load_mbin_modifiers) {
+    benchmarkLoad(state, "mbin", 5000, morphio::NO_DUPLICATES | morphio::NRN_ORDER);
+}
+
+MORPHIO_BENCHMARK(load_swc_modifiers) {
+    benchmarkLoad(state, "swc", 5000, morphio::NO_DUPLICATES | morphio::NRN_ORDER);
+}
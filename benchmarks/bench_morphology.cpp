@@ -0,0 +1,150 @@
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/quantized_point_level.h>
+#include <morphio/section.h>
+#include <morphio/tools.h>
+
+#include "benchmark.h"
+#include "synthetic.h"
+
+namespace {
+
+const morphio::Morphology& neuron10k() {
+    static const morphio::Morphology morphology(bench::syntheticNeuron(10000, 10));
+    return morphology;
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(traverse_depth_10k) {
+    size_t visited = 0;
+    state.measure([&]() {
+        visited = 0;
+        for (auto it = neuron10k().depth_begin(); it != neuron10k().depth_end(); ++it) {
+            ++visited;
+        }
+    });
+    state.counter("visited", static_cast<double>(visited));
+}
+
+MORPHIO_BENCHMARK(traverse_breadth_10k) {
+    size_t visited = 0;
+    state.measure([&]() {
+        visited = 0;
+        for (auto it = neuron10k().breadth_begin(); it != neuron10k().breadth_end(); ++it) {
+            ++visited;
+        }
+    });
+    state.counter("visited", static_cast<double>(visited));
+}
+
+MORPHIO_BENCHMARK(traverse_upstream_10k) {
+    // From every section back to its root
+    size_t visited = 0;
+    state.measure([&]() {
+        visited = 0;
+        for (const auto& section : neuron10k().sections()) {
+            for (auto it = section.upstream_begin(); it != section.upstream_end(); ++it) {
+                ++visited;
+            }
+        }
+    });
+    state.counter("visited", static_cast<double>(visited));
+}
+
+MORPHIO_BENCHMARK(feature_section_path_lengths_10k) {
+    std::vector<morphio::floatType> lengths;
+    state.measure([&]() {
+        const auto sections = neuron10k().sections();
+        lengths.assign(sections.size(), 0);
+        for (const auto& section : sections) {
+            const auto points = section.points();
+            for (size_t i = 1; i < points.size(); ++i) {
+                lengths[section.id()] += morphio::distance(points[i - 1], points[i]);
+            }
+        }
+    });
+    state.counter("sections", static_cast<double>(lengths.size()));
+}
+
+MORPHIO_BENCHMARK(feature_branch_orders_10k) {
+    std::vector<uint32_t> orders;
+    state.measure([&]() {
+        orders.assign(neuron10k().sections().size(), 0);
+        for (auto it = neuron10k().breadth_begin(); it != neuron10k().breadth_end(); ++it) {
+            const auto& section = *it;
+            if (!section.isRoot()) {
+                orders[section.id()] = orders[section.parent().id()] + 1;
+            }
+        }
+    });
+    state.counter("sections", static_cast<double>(orders.size()));
+}
+
+namespace {
+
+morphio::Property::PointLevel pointLevel10k() {
+    const auto& morphology = neuron10k();
+    return {morphio::Points(morphology.points().begin(), morphology.points().end()),
+            std::vector<morphio::floatType>(morphology.diameters().begin(),
+                                            morphology.diameters().end())};
+}
+
+const morphio::Property::QuantizedPointLevel& quantized10k() {
+    static const morphio::Property::QuantizedPointLevel quantized(pointLevel10k());
+    return quantized;
+}
+
+void memoryCounters(bench::State& state) {
+    state.counter("float_bytes", static_cast<double>(neuron10k().memoryUsage().points));
+    state.counter("quantized_bytes", static_cast<double>(quantized10k().memoryUsage().points));
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(quantize_points_10k) {
+    const auto level = pointLevel10k();
+    size_t points = 0;
+    state.measure([&]() { points = morphio::Property::QuantizedPointLevel(level).size(); });
+    state.counter("points", static_cast<double>(points));
+    memoryCounters(state);
+}
+
+MORPHIO_BENCHMARK(quantized_decode_10k) {
+    morphio::Property::PointLevel buffer;
+    state.measure([&]() { quantized10k().decode({0, quantized10k().size()}, buffer); });
+    state.counter("points", static_cast<double>(buffer._points.size()));
+    memoryCounters(state);
+}
+
+MORPHIO_BENCHMARK(quantized_section_path_lengths_10k) {
+    // feature_section_path_lengths_10k, decoding each section on demand
+    const auto offsets = neuron10k().sectionOffsets();
+    std::vector<morphio::floatType> lengths;
+    morphio::Property::PointLevel buffer;
+    state.measure([&]() {
+        lengths.assign(offsets.size() - 1, 0);
+        for (size_t id = 0; id + 1 < offsets.size(); ++id) {
+            quantized10k().decode({offsets[id], offsets[id + 1]}, buffer);
+            const morphio::range<const morphio::Point> points = buffer._points;
+            for (size_t i = 1; i < points.size(); ++i) {
+                lengths[id] += morphio::distance(points[i - 1], points[i]);
+            }
+        }
+    });
+    state.counter("sections", static_cast<double>(lengths.size()));
+    memoryCounters(state);
+}
+
+MORPHIO_BENCHMARK(content_hash_10k) {
+    uint64_t hash = 0;
+    state.measure([&]() { hash = neuron10k().contentHash(); });
+    state.counter("points", static_cast<double>(neuron10k().points().size()));
+}
+
+MORPHIO_BENCHMARK(diff_10k) {
+    const morphio::Morphology copy(morphio::mut::Morphology{neuron10k()});
+    bool differ = true;
+    state.measure([&]() { differ = morphio::diff(neuron10k(), copy); });
+    state.counter("differ", differ ? 1 : 0);
+}
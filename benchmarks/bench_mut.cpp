@@ -0,0 +1,172 @@
+#include <memory>
+
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+
+#include "benchmark.h"
+#include "synthetic.h"
+
+MORPHIO_BENCHMARK(mut_build_10k) {
+    size_t sections = 0;
+    state.measure([&]() { sections = bench::syntheticNeuron(10000, 10).sections().size(); });
+    state.counter("sections", static_cast<double>(sections));
+}
+
+MORPHIO_BENCHMARK(mut_copy_10k) {
+    const auto neuron = bench::syntheticNeuron(10000, 10);
+    state.measure([&]() { morphio::mut::Morphology copy(neuron); });
+}
+
+MORPHIO_BENCHMARK(mut_delete_rebuild_10k) {
+    auto neuron = bench::syntheticNeuron(10000, 10);
+    state.measure([&]() {
+        // Prune the last neurite and grow it back
+        const auto root = neuron.rootSections().back();
+        morphio::mut::Morphology pruned;
+        const auto copy = pruned.appendRootSection(root, true);
+        neuron.deleteSection(root, true);
+        neuron.appendRootSection(copy, true);
+    });
+}
+
+namespace {
+
+const morphio::Morphology& immutable10k() {
+    static const morphio::Morphology morphology(bench::syntheticNeuron(10000, 10));
+    return morphology;
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(mut_from_immutable_10k) {
+    state.measure([&]() { morphio::mut::Morphology neuron(immutable10k()); });
+}
+
+MORPHIO_BENCHMARK(mut_edit_one_section_10k) {
+    // Typical editing round trip: only one section is modified
+    size_t points = 0;
+    state.measure([&]() {
+        morphio::mut::Morphology neuron(immutable10k());
+        for (auto& diameter : neuron.section(1)->diameters()) {
+            diameter *= 2;
+        }
+        points = neuron.buildReadOnly()._pointLevel._points.size();
+    });
+    state.counter("points", static_cast<double>(points));
+}
+
+MORPHIO_BENCHMARK(mut_build_read_only_10k) {
+    const auto neuron = bench::syntheticNeuron(10000, 10);
+    state.measure([&]() { neuron.buildReadOnly(); });
+}
+
+MORPHIO_BENCHMARK(mut_to_immutable_10k) {
+    // Hand a whole mutable morphology over to an immutable one
+    std::unique_ptr<morphio::mut::Morphology> neuron;
+    state.measure(
+        [&]() { neuron.reset(new morphio::mut::Morphology(bench::syntheticNeuron(10000, 10))); },
+        [&]() { morphio::Morphology immutable(std::move(*neuron)); });
+}
+
+namespace {
+
+const morphio::mut::Morphology& tree50k() {
+    static const morphio::mut::Morphology morphology(bench::syntheticNeuron(50000, 4));
+    return morphology;
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(mut_prune_90pct_50k) {
+    // Delete 9 sections out of 10, their children being re-attached to the grand-parent
+    std::unique_ptr<morphio::mut::Morphology> neuron;
+    state.measure([&]() { neuron.reset(new morphio::mut::Morphology(tree50k())); },
+                  [&]() {
+                      const auto sections = neuron->sections();
+                      for (const auto& section : sections) {
+                          if (section.first % 10 != 0) {
+                              neuron->deleteSection(section.second, false);
+                          }
+                      }
+                  });
+    state.counter("sections", static_cast<double>(neuron->sections().size()));
+}
+
+MORPHIO_BENCHMARK(mut_prune_subtrees_50k) {
+    // Recursively delete one of the two subtrees, 4 levels down each neurite: 15/16 of the tree
+    std::unique_ptr<morphio::mut::Morphology> neuron;
+    state.measure([&]() { neuron.reset(new morphio::mut::Morphology(tree50k())); },
+                  [&]() {
+                      const auto roots = neuron->rootSections();
+                      for (auto current : roots) {
+                          for (int level = 0; level < 4; ++level) {
+                              const auto children = current->children();
+                              neuron->deleteSection(children[1], true);
+                              current = children[0];
+                          }
+                      }
+                  });
+    state.counter("sections", static_cast<double>(neuron->sections().size()));
+}
+
+MORPHIO_BENCHMARK(mut_destroy_50k) {
+    std::unique_ptr<morphio::mut::Morphology> neuron;
+    state.measure([&]() { neuron.reset(new morphio::mut::Morphology(tree50k())); },
+                  [&]() { neuron.reset(); });
+}
+
+namespace {
+
+/** 40 neurites, each one a chain of 50 sections of 10 points to be merged by sanitize **/
+morphio::mut::Morphology unifurcationChains() {
+    using morphio::floatType;
+    morphio::mut::Morphology chains;
+    for (int root = 0; root < 40; ++root) {
+        std::shared_ptr<morphio::mut::Section> current;
+        for (int i = 0; i < 50; ++i) {
+            morphio::Property::PointLevel level;
+            for (int j = 0; j < 10; ++j) {
+                level._points.push_back(
+                    {static_cast<floatType>(root), 0, static_cast<floatType>(i * 9 + j)});
+                level._diameters.push_back(1);
+            }
+            current = current ? current->appendSection(level)
+                              : chains.appendRootSection(level, morphio::SECTION_AXON);
+        }
+    }
+    return chains;
+}
+
+/**
+   Sanitize the chains. The 1960 single child warnings are either ignored, or raised but none is
+   printed: the maximum number of warnings is set to 0
+**/
+void benchmarkSanitize(bench::State& state, bool copyAnnotationPoints, bool ignoreWarnings = true) {
+    const auto chains = unifurcationChains();
+    std::unique_ptr<morphio::mut::Morphology> neuron;
+    if (ignoreWarnings) {
+        morphio::set_ignored_warning(morphio::Warning::ONLY_CHILD, true);
+    } else {
+        morphio::set_maximum_warnings(0);
+    }
+    state.measure([&]() { neuron.reset(new morphio::mut::Morphology(chains)); },
+                  [&]() { neuron->sanitize(morphio::readers::DebugInfo(), copyAnnotationPoints); });
+    morphio::set_ignored_warning(morphio::Warning::ONLY_CHILD, false);
+    morphio::set_maximum_warnings(100);
+    state.counter("sections", static_cast<double>(neuron->sections().size()));
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(mut_sanitize_chains_2k) {
+    benchmarkSanitize(state, true);
+}
+
+MORPHIO_BENCHMARK(mut_sanitize_chains_2k_point_ranges) {
+    benchmarkSanitize(state, false);
+}
+
+MORPHIO_BENCHMARK(mut_sanitize_chains_2k_warnings) {
+    benchmarkSanitize(state, false, false);
+}
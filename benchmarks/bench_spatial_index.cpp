@@ -0,0 +1,92 @@
+#include <morphio/morphology.h>
+#include <morphio/spatial_index.h>
+
+#include "benchmark.h"
+#include "synthetic.h"
+
+namespace {
+
+const morphio::Morphology& neuron() {
+    static const morphio::Morphology morphology(bench::syntheticNeuron(20000, 20));
+    return morphology;
+}
+
+morphio::Points queryPoints(const morphio::Morphology& morphology, size_t count) {
+    // Points sampled along the neurites so that queries hit something
+    const auto& points = morphology.points();
+    morphio::Points queries;
+    queries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queries.push_back(points[(i * 7919) % points.size()]);
+    }
+    return queries;
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(spatial_index_build) {
+    const auto& morphology = neuron();
+    size_t segments = 0;
+    state.measure([&]() { segments = morphio::SpatialIndex(morphology).size(); });
+    state.counter("segments", static_cast<double>(segments));
+}
+
+MORPHIO_BENCHMARK(spatial_index_sphere_10k) {
+    const morphio::SpatialIndex index(neuron());
+    const auto queries = queryPoints(neuron(), 10000);
+    size_t hits = 0;
+    state.measure([&]() {
+        hits = 0;
+        for (const auto& query : queries) {
+            hits += index.intersects(query, 5).size();
+        }
+    });
+    state.counter("hits", static_cast<double>(hits));
+}
+
+MORPHIO_BENCHMARK(spatial_index_sphere_10k_batch) {
+    const morphio::SpatialIndex index(neuron());
+    const auto queries = queryPoints(neuron(), 10000);
+    const std::vector<morphio::floatType> radii(queries.size(), 5);
+    state.measure([&]() { index.intersects(queries, radii); });
+}
+
+MORPHIO_BENCHMARK(spatial_index_nearest_10k) {
+    const morphio::SpatialIndex index(neuron());
+    auto queries = queryPoints(neuron(), 10000);
+    for (auto& query : queries) {
+        query[0] += 10;
+    }
+    state.measure([&]() {
+        for (const auto& query : queries) {
+            index.nearest(query);
+        }
+    });
+}
+
+MORPHIO_BENCHMARK(spatial_index_nearest_10k_batch) {
+    const morphio::SpatialIndex index(neuron());
+    auto queries = queryPoints(neuron(), 10000);
+    for (auto& query : queries) {
+        query[0] += 10;
+    }
+    state.measure([&]() { index.nearest(queries); });
+}
+
+// Baseline: what a loop over every point has to do for 100 of the queries above
+MORPHIO_BENCHMARK(brute_force_sphere_100) {
+    const auto& morphology = neuron();
+    const auto queries = queryPoints(morphology, 100);
+    size_t hits = 0;
+    state.measure([&]() {
+        hits = 0;
+        for (const auto& query : queries) {
+            for (const auto& point : morphology.points()) {
+                if (morphio::distance(point, query) < 5) {
+                    ++hits;
+                }
+            }
+        }
+    });
+    state.counter("hits", static_cast<double>(hits));
+}
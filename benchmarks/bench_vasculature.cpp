@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <morphio/vasc/metrics.h>
+#include <morphio/vasc/section.h>
+#include <morphio/vasc/vasculature.h>
+
+#include "benchmark.h"
+#include "synthetic.h"
+
+namespace {
+
+const morphio::vasculature::property::Properties& network1m() {
+    static const auto properties = bench::syntheticVasculature(1000000);
+    return properties;
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(vasculature_connectivity_1m) {
+    // Building the predecessors and successors of a million section graph
+    morphio::vasculature::property::Properties properties;
+    std::unique_ptr<morphio::vasculature::Vasculature> vasculature;
+    state.measure([&]() { properties = network1m(); },
+                  [&]() {
+                      vasculature.reset(
+                          new morphio::vasculature::Vasculature(std::move(properties)));
+                  });
+
+    // Two offset arrays with one entry per section, two id arrays with one per connection
+    const size_t nSections = network1m()._sectionLevel._sections.size();
+    const size_t nConnections = network1m()._connectivity.size();
+    const size_t adjacencyBytes = 2 * (nSections + 1 + nConnections) * sizeof(uint32_t);
+    state.counter("connections", static_cast<double>(nConnections));
+    state.counter("adjacency_MB", static_cast<double>(adjacencyBytes) / (1 << 20));
+}
+
+MORPHIO_BENCHMARK(vasculature_neighbors_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    size_t degrees = 0;
+    state.measure([&]() {
+        degrees = 0;
+        for (uint32_t id = 0; id < vasculature.sectionTypes().size(); ++id) {
+            const auto section = vasculature.section(id);
+            degrees += section.predecessorIds().size() + section.successorIds().size();
+        }
+    });
+    state.counter("degrees", static_cast<double>(degrees));
+}
+
+MORPHIO_BENCHMARK(vasculature_neighbor_sections_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    size_t degrees = 0;
+    state.measure([&]() {
+        degrees = 0;
+        for (uint32_t id = 0; id < vasculature.sectionTypes().size(); ++id) {
+            degrees += vasculature.section(id).neighbors().size();
+        }
+    });
+    state.counter("degrees", static_cast<double>(degrees));
+}
+
+MORPHIO_BENCHMARK(vasculature_iterate_1m) {
+    // Depth first iteration over the Section objects of a million section graph
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    size_t visited = 0;
+    uint64_t idSum = 0;
+    state.measure([&]() {
+        visited = 0;
+        idSum = 0;
+        for (auto it = vasculature.begin(); it != vasculature.end(); ++it) {
+            ++visited;
+            idSum += (*it).id();
+        }
+    });
+    state.counter("visited", static_cast<double>(visited));
+    state.counter("id_sum", static_cast<double>(idSum));
+}
+
+MORPHIO_BENCHMARK(vasculature_dfs_order_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    std::vector<uint32_t> order;
+    state.measure([&]() { order = vasculature.depthFirstOrder(); });
+    state.counter("visited", static_cast<double>(order.size()));
+}
+
+MORPHIO_BENCHMARK(vasculature_bfs_order_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    std::vector<uint32_t> order;
+    state.measure([&]() { order = vasculature.breadthFirstOrder(); });
+    state.counter("visited", static_cast<double>(order.size()));
+}
+
+MORPHIO_BENCHMARK(vasculature_components_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    std::vector<uint32_t> labels;
+    state.measure([&]() { labels = vasculature.connectedComponents(); });
+    state.counter("components",
+                  labels.empty() ? 0.
+                                 : static_cast<double>(
+                                       *std::max_element(labels.begin(), labels.end()) + 1));
+}
+
+namespace metrics = morphio::vasculature::metrics;
+
+MORPHIO_BENCHMARK(vasculature_section_lengths_loop_1m) {
+    // Path lengths going through the Section objects, as a Python loop does
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    std::vector<morphio::floatType> lengths;
+    state.measure([&]() {
+        lengths.assign(vasculature.sectionTypes().size(), 0);
+        for (uint32_t id = 0; id < lengths.size(); ++id) {
+            const auto points = vasculature.section(id).points();
+            for (size_t i = 1; i < points.size(); ++i) {
+                lengths[id] += morphio::distance(points[i - 1], points[i]);
+            }
+        }
+    });
+    state.counter("sections", static_cast<double>(lengths.size()));
+}
+
+MORPHIO_BENCHMARK(vasculature_section_lengths_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    std::vector<morphio::floatType> lengths;
+    state.measure([&]() { lengths = metrics::sectionLengths(vasculature.properties(), 1); });
+    state.counter("sections", static_cast<double>(lengths.size()));
+}
+
+MORPHIO_BENCHMARK(vasculature_section_lengths_threads_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    std::vector<morphio::floatType> lengths;
+    state.measure([&]() { lengths = metrics::sectionLengths(vasculature.properties()); });
+    state.counter("sections", static_cast<double>(lengths.size()));
+}
+
+MORPHIO_BENCHMARK(vasculature_vessel_graph_1m) {
+    const morphio::vasculature::Vasculature vasculature(network1m());
+    metrics::VesselGraph graph;
+    state.measure([&]() { graph = metrics::vesselGraph(vasculature.properties()); });
+    state.counter("nodes", static_cast<double>(graph.nodeCount));
+}
@@ -0,0 +1,30 @@
+#include <morphio/mut/morphology.h>
+
+#include "benchmark.h"
+#include "synthetic.h"
+
+namespace {
+
+void benchmarkWrite(bench::State& state, const std::string& extension) {
+    auto neuron = bench::syntheticNeuron(10000, 10);
+    const bench::TemporaryFile file("morphio_bench_write." + extension);
+    state.measure([&]() { neuron.write(file.path); });
+}
+
+}  // namespace
+
+MORPHIO_BENCHMARK(write_swc_10k) {
+    benchmarkWrite(state, "swc");
+}
+
+MORPHIO_BENCHMARK(write_asc_10k) {
+    benchmarkWrite(state, "asc");
+}
+
+MORPHIO_BENCHMARK(write_h5_10k) {
+    benchmarkWrite(state, "h5");
+}
+
+MORPHIO_BENCHMARK(write_mbin_10k) {
+    benchmarkWrite(state, "mbin");
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>      // std::chrono
+#include <cstdio>      // std::remove
+#include <ctime>       // std::clock
+#include <functional>  // std::function
+#include <string>      // std::string
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+namespace bench {
+
+/** Measures one benchmark: call `measure` with the code to time **/
+class State
+{
+  public:
+    explicit State(double minTime)
+        : _minTime(minTime) {}
+
+    /**
+       Run function until minTime seconds have elapsed (and at least once), recording the mean
+       and the fastest wall time of a single call, and the mean CPU time of the process (all
+       threads included)
+    **/
+    template <typename Function>
+    void measure(Function function) {
+        measure([]() {}, function);
+    }
+
+    /** Same as measure(function), calling setup untimed before each call of function **/
+    template <typename Setup, typename Function>
+    void measure(Setup setup, Function function) {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        double total = 0;
+        double cpuTotal = 0;
+        do {
+            setup();
+            const std::clock_t cpuBefore = std::clock();
+            const auto before = Clock::now();
+            function();
+            const double elapsed = std::chrono::duration<double>(Clock::now() - before).count();
+            cpuTotal += static_cast<double>(std::clock() - cpuBefore) / CLOCKS_PER_SEC;
+            total += elapsed;
+            _best = _iterations == 0 ? elapsed : std::min(_best, elapsed);
+            ++_iterations;
+        } while (std::chrono::duration<double>(Clock::now() - start).count() < _minTime);
+        _mean = total / static_cast<double>(_iterations);
+        _cpuMean = cpuTotal / static_cast<double>(_iterations);
+    }
+
+    /** Attach a named value (problem size, throughput, memory...) to the result **/
+    void counter(const std::string& name, double value) {
+        _counters.emplace_back(name, value);
+    }
+
+    size_t iterations() const noexcept {
+        return _iterations;
+    }
+    double mean() const noexcept {
+        return _mean;
+    }
+    double best() const noexcept {
+        return _best;
+    }
+    double cpuMean() const noexcept {
+        return _cpuMean;
+    }
+    const std::vector<std::pair<std::string, double>>& counters() const noexcept {
+        return _counters;
+    }
+
+  private:
+    double _minTime;
+    size_t _iterations = 0;
+    double _mean = 0;
+    double _best = 0;
+    double _cpuMean = 0;
+    std::vector<std::pair<std::string, double>> _counters;
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State&)> function;
+};
+
+std::vector<Benchmark>& registry();
+
+/** A file removed when going out of scope, also when a benchmark throws **/
+struct TemporaryFile {
+    explicit TemporaryFile(std::string path_)
+        : path(std::move(path_)) {}
+    TemporaryFile(const TemporaryFile&) = delete;
+    TemporaryFile& operator=(const TemporaryFile&) = delete;
+    ~TemporaryFile() {
+        std::remove(path.c_str());
+    }
+
+    const std::string path;
+};
+
+struct Registrar {
+    Registrar(const char* name, std::function<void(State&)> function) {
+        registry().push_back({name, std::move(function)});
+    }
+};
+
+}  // namespace bench
+
+/** Define and register a benchmark: MORPHIO_BENCHMARK(name) { state.measure([&]() {...}); } **/
+#define MORPHIO_BENCHMARK(NAME)                                            \
+    static void NAME(bench::State& state);                                 \
+    static const bench::Registrar NAME##_registrar(#NAME, NAME);           \
+    static void NAME(bench::State& state)
@@ -0,0 +1,175 @@
+#include <cstdio>     // std::snprintf
+#include <cstdlib>    // std::atof
+#include <cstring>    // std::strcmp
+#include <ctime>      // std::time, std::strftime
+#include <exception>  // std::exception
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <thread>     // std::thread::hardware_concurrency
+
+#include <morphio/errorMessages.h>
+#include <morphio/version.h>
+
+#include "benchmark.h"
+
+namespace bench {
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+}  // namespace bench
+
+namespace {
+void usage(const char* program) {
+    std::cout << "Usage: " << program << " [--min-time SECONDS] [--json] [FILTER]\n"
+              << "Runs the benchmarks whose name contains FILTER (all by default)\n"
+              << "  --min-time  run each benchmark for at least SECONDS (default 0.5)\n"
+              << "  --json      print the results as JSON, in the layout of Google Benchmark\n";
+}
+
+std::string jsonString(const std::string& value) {
+    std::string result = "\"";
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+            result += escaped;
+        } else {
+            result += c;
+        }
+    }
+    return result + '"';
+}
+
+void printTableHeader() {
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12)
+              << "iterations" << std::setw(14) << "mean (ms)" << std::setw(14) << "best (ms)"
+              << '\n';
+}
+
+void printTableError(const std::string& name, const std::string& error) {
+    std::cout << std::left << std::setw(40) << name << "  ERROR: " << error << std::endl;
+}
+
+void printTableRow(const std::string& name, const bench::State& state) {
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(12)
+              << state.iterations() << std::setw(14) << std::fixed << std::setprecision(3)
+              << state.mean() * 1e3 << std::setw(14) << state.best() * 1e3;
+    for (const auto& counter : state.counters()) {
+        std::cout << "  " << counter.first << '=' << std::defaultfloat << counter.second;
+    }
+    std::cout << std::endl;
+}
+
+void printJsonHeader(const char* program, double minTime) {
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+    std::cout << "{\n  \"context\": {\n"
+              << "    \"date\": " << jsonString(date) << ",\n"
+              << "    \"executable\": " << jsonString(program) << ",\n"
+              << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+              << "    \"library_version\": " << jsonString(morphio::getVersionString()) << ",\n"
+              << "    \"library_build_type\": " << jsonString(buildType) << ",\n"
+              << "    \"min_time\": " << minTime << "\n"
+              << "  },\n  \"benchmarks\": [";
+}
+
+void printJsonError(const std::string& name, const std::string& error, bool first) {
+    std::cout << (first ? "\n" : ",\n") << "    {\n"
+              << "      \"name\": " << jsonString(name) << ",\n"
+              << "      \"run_name\": " << jsonString(name) << ",\n"
+              << "      \"run_type\": \"iteration\",\n"
+              << "      \"error_occurred\": true,\n"
+              << "      \"error_message\": " << jsonString(error) << "\n"
+              << "    }" << std::flush;
+}
+
+void printJsonRow(const std::string& name, const bench::State& state, bool first) {
+    std::cout << (first ? "\n" : ",\n") << std::setprecision(9) << "    {\n"
+              << "      \"name\": " << jsonString(name) << ",\n"
+              << "      \"run_name\": " << jsonString(name) << ",\n"
+              << "      \"run_type\": \"iteration\",\n"
+              << "      \"iterations\": " << state.iterations() << ",\n"
+              << "      \"real_time\": " << state.mean() * 1e3 << ",\n"
+              << "      \"cpu_time\": " << state.cpuMean() * 1e3 << ",\n"
+              << "      \"best_time\": " << state.best() * 1e3 << ",\n"
+              << "      \"time_unit\": \"ms\"";
+    for (const auto& counter : state.counters()) {
+        std::cout << ",\n      " << jsonString(counter.first) << ": " << counter.second;
+    }
+    std::cout << "\n    }" << std::flush;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    double minTime = 0.5;
+    bool json = false;
+    int status = 0;
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    // Warnings would only measure the speed of the terminal
+    morphio::set_maximum_warnings(0);
+
+    if (json) {
+        printJsonHeader(argv[0], minTime);
+    } else {
+        printTableHeader();
+    }
+    bool first = true;
+    for (const auto& benchmark : bench::registry()) {
+        if (benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        bench::State state(minTime);
+        // A failing benchmark (e.g. a format not compiled in) does not stop the others
+        std::string error;
+        try {
+            benchmark.function(state);
+        } catch (const std::exception& e) {
+            error = e.what();
+            status = 1;
+        }
+        if (json) {
+            if (error.empty()) {
+                printJsonRow(benchmark.name, state, first);
+            } else {
+                printJsonError(benchmark.name, error, first);
+            }
+        } else {
+            if (error.empty()) {
+                printTableRow(benchmark.name, state);
+            } else {
+                printTableError(benchmark.name, error);
+            }
+        }
+        first = false;
+    }
+    if (json) {
+        std::cout << "\n  ]\n}" << std::endl;
+    }
+    return status;
+}
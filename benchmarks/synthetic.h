@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>  // uint32_t
+
+#include <morphio/synthetic.h>
+#include <morphio/vasc/properties.h>
+
+namespace bench {
+
+/**
+   A reproducible neuron: nRoots neurites growing as complete binary trees of nSections in
+   total, see morphio::synthetic::neuron
+**/
+inline morphio::mut::Morphology syntheticNeuron(uint32_t nSections,
+                                                uint32_t pointsPerSection = 10,
+                                                uint32_t nRoots = 4,
+                                                uint32_t seed = 0) {
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.seed = seed;
+    parameters.neurites = nRoots;
+    parameters.maxDepth = 64;
+    parameters.maxSections = nSections;
+    parameters.pointsPerSection = pointsPerSection;
+    return morphio::synthetic::neuron(parameters);
+}
+
+/** A reproducible vascular network of nSections, see morphio::synthetic::vasculature **/
+inline morphio::vasculature::property::Properties syntheticVasculature(
+    uint32_t nSections, uint32_t pointsPerSection = 4, uint32_t seed = 0) {
+    morphio::synthetic::VasculatureParameters parameters;
+    parameters.seed = seed;
+    parameters.sections = nSections;
+    parameters.pointsPerSection = pointsPerSection;
+    return morphio::synthetic::vasculature(parameters).buildReadOnly();
+}
+
+}  // namespace bench
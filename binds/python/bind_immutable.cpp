@@ -1,5 +1,8 @@
 #include "bind_immutable.h"
 
+#include <algorithm>  // std::copy
+
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/iostream.h>  // py::add_ostream_redirect
@@ -7,8 +10,11 @@
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/enums.h>
 #include <morphio/glial_cell.h>
+#include <morphio/morphology_cache.h>
+#include <morphio/morphology_store.h>
 #include <morphio/mut/morphology.h>
 #include <morphio/soma.h>
+#include <morphio/tools.h>
 #include <morphio/types.h>
 
 #include "bind_enums.h"
@@ -16,6 +22,40 @@
 
 namespace py = pybind11;
 
+namespace {
+template <typename T>
+py::array_t<T> points_to_ndarray(const std::vector<morphio::PointT<T>>& points) {
+    py::array_t<T> result({static_cast<py::ssize_t>(points.size()), static_cast<py::ssize_t>(3)});
+    T* data = result.mutable_data();
+    for (const auto& point : points) {
+        data = std::copy(point.begin(), point.end(), data);
+    }
+    return result;
+}
+
+template <typename T>
+py::dict geometry_to_dict(const morphio::Property::GeometryT<T>& geometry) {
+    std::vector<int> offsets;
+    std::vector<int> parents;
+    for (const auto& section : geometry._sectionLevel._sections) {
+        offsets.push_back(section[0]);
+        parents.push_back(section[1]);
+    }
+
+    py::dict result;
+    result["points"] = points_to_ndarray(geometry._pointLevel._points);
+    result["diameters"] = py::array_t<T>(py::cast(geometry._pointLevel._diameters));
+    result["perimeters"] = py::array_t<T>(py::cast(geometry._pointLevel._perimeters));
+    result["soma_points"] = points_to_ndarray(geometry._somaLevel._points);
+    result["soma_diameters"] = py::array_t<T>(py::cast(geometry._somaLevel._diameters));
+    result["section_offsets"] = as_pyarray(std::move(offsets));
+    result["section_parents"] = as_pyarray(std::move(parents));
+    result["section_types"] = geometry._sectionLevel._sectionTypes;
+    result["soma_type"] = geometry._cellLevel._somaType;
+    return result;
+}
+}  // namespace
+
 void bind_immutable_module(py::module& m) {
     using namespace py::literals;
 
@@ -122,6 +162,45 @@ void bind_immutable_module(py::module& m) {
                                &morphio::Morphology::cellFamily,
                                "Returns the cell family (neuron or glia)")
         .def_property_readonly("version", &morphio::Morphology::version, "Returns the version")
+        .def(
+            "memory_usage",
+            [](const morphio::Morphology& morph) {
+                return memory_usage_to_dict(morph.memoryUsage());
+            },
+            "Returns a dict of the estimated bytes held by the morphology, by component, "
+            "with their total. Copies of a Morphology share this memory")
+        .def(
+            "content_hash",
+            [](const morphio::Morphology& morph, bool points, morphio::floatType tolerance,
+               bool organelles) {
+                morphio::Property::HashOptions options;
+                options.points = points;
+                options.tolerance = tolerance;
+                options.organelles = organelles;
+                return morph.contentHash(options);
+            },
+            "Returns a 64 bit hash of the content of the morphology, stable across runs.\n"
+            "points: hash the points, diameters and perimeters, not only the structure\n"
+            "tolerance: round them to multiples of tolerance first, 0 to hash exact values\n"
+            "organelles: also hash the mitochondria and the endoplasmic reticulum",
+            "points"_a = true,
+            "tolerance"_a = 0,
+            "organelles"_a = false)
+        .def("__hash__",
+             [](const morphio::Morphology& morph) { return morph.contentHash(); })
+        .def(
+            "__eq__",
+            [](const morphio::Morphology& left, const morphio::Morphology& right) {
+                return left.contentHash() == right.contentHash() &&
+                       !morphio::diff(left, right, morphio::enums::LogLevel::ERROR);
+            },
+            "Morphologies are equal when they have the same content hash and do not differ "
+            "for morphio::diff")
+        .def("__ne__",
+             [](const morphio::Morphology& left, const morphio::Morphology& right) {
+                 return left.contentHash() != right.contentHash() ||
+                        morphio::diff(left, right, morphio::enums::LogLevel::ERROR);
+             })
 
         // Iterators
         .def(
@@ -155,6 +234,132 @@ void bind_immutable_module(py::module& m) {
              "Additional Ctor that accepts as filename any python object that implements __repr__ "
              "or __str__");
 
+    m.def(
+        "load_as",
+        [](py::object path, py::object dtype, unsigned int options) {
+            const std::string filename = py::str(path);
+            const auto type = py::dtype::from_args(dtype);
+            if (type.kind() != 'f' || (type.itemsize() != 4 && type.itemsize() != 8)) {
+                throw py::value_error("dtype must be float32 or float64");
+            }
+            if (type.itemsize() == 4) {
+                return geometry_to_dict(morphio::load_as<float>(filename, options));
+            }
+            return geometry_to_dict(morphio::load_as<double>(filename, options));
+        },
+        "Loads the geometry of a morphology with points, diameters and perimeters of the given "
+        "dtype, float32 or float64, whatever the precision MorphIO was built with.\n"
+        "The values are read from the file in the given dtype, the structure is the one of "
+        "Morphology. Annotations, mitochondria and the endoplasmic reticulum are not loaded.\n"
+        "Returns a dict with the points, diameters, perimeters, soma_points, soma_diameters, "
+        "section_offsets, section_parents, section_types and soma_type",
+        "filename"_a,
+        "dtype"_a,
+        "options"_a = morphio::enums::Option::NO_MODIFIER);
+
+    py::class_<morphio::MorphologyCache>(
+        m,
+        "MorphologyCache",
+        "A thread safe cache of loaded morphologies, keyed by path, options and file modification "
+        "time.\n"
+        "Morphologies returned for the same key share their data. The least recently used "
+        "morphologies are evicted when the cache holds more than max_bytes.\n"
+        "With quantize_points, the points are kept in 16 bit fixed point and decoded on lookup")
+        .def(py::init<size_t, bool>(), "max_bytes"_a, "quantize_points"_a = false)
+        .def(
+            "get",
+            [](morphio::MorphologyCache& cache, py::object path, unsigned int options) {
+                const std::string filename = py::str(path);
+                py::gil_scoped_release release;
+                return cache.get(filename, options);
+            },
+            "Returns the morphology at path, loading it only if it is not in the cache",
+            "path"_a,
+            "options"_a = morphio::enums::Option::NO_MODIFIER)
+        .def_property_readonly("max_bytes", &morphio::MorphologyCache::maxBytes)
+        .def_property_readonly("quantize_points", &morphio::MorphologyCache::quantizePoints)
+        .def_property_readonly(
+            "stats",
+            [](const morphio::MorphologyCache& cache) {
+                const auto stats = cache.stats();
+                py::dict result;
+                result["hits"] = stats.hits;
+                result["misses"] = stats.misses;
+                result["evictions"] = stats.evictions;
+                result["entries"] = stats.entries;
+                result["bytes"] = stats.bytes;
+                return result;
+            },
+            "Returns a dict with the hits, misses, evictions, entries and bytes counts")
+        .def("clear", &morphio::MorphologyCache::clear, "Drops all cached morphologies");
+
+    py::class_<morphio::MorphologyStore>(
+        m,
+        "MorphologyStore",
+        "A thread safe set of named morphologies that stores each distinct content once.\n"
+        "Morphologies with the same content (see Morphology.content_hash, organelles included) "
+        "share their data. A store is written to, and read from, an archive file holding each "
+        "distinct morphology once")
+        .def(py::init<>())
+        .def(py::init([](py::object path) {
+                 return std::unique_ptr<morphio::MorphologyStore>(
+                     new morphio::MorphologyStore(py::str(path)));
+             }),
+             "Reads the store archive at path",
+             "path"_a)
+        .def("add",
+             static_cast<morphio::Morphology (morphio::MorphologyStore::*)(
+                 const std::string&, const morphio::Morphology&)>(&morphio::MorphologyStore::add),
+             "Adds a morphology under name, replacing the one that had this name, and returns "
+             "the shared instance now stored for it",
+             "name"_a,
+             "morphology"_a,
+             py::call_guard<py::gil_scoped_release>())
+        .def("add",
+             static_cast<morphio::Morphology (morphio::MorphologyStore::*)(
+                 const std::string&, const morphio::mut::Morphology&)>(
+                 &morphio::MorphologyStore::add),
+             "Adds a mutable morphology under name",
+             "name"_a,
+             "morphology"_a,
+             py::call_guard<py::gil_scoped_release>())
+        .def("get",
+             &morphio::MorphologyStore::get,
+             "Returns the morphology stored under name",
+             "name"_a)
+        .def("__getitem__", &morphio::MorphologyStore::get, "name"_a)
+        .def("__contains__", &morphio::MorphologyStore::contains, "name"_a)
+        .def("__len__",
+             [](const morphio::MorphologyStore& store) { return store.stats().names; })
+        .def_property_readonly("names",
+                               &morphio::MorphologyStore::names,
+                               "Returns the names, sorted")
+        .def_property_readonly(
+            "stats",
+            [](const morphio::MorphologyStore& store) {
+                const auto stats = store.stats();
+                py::dict result;
+                result["names"] = stats.names;
+                result["unique"] = stats.unique;
+                result["bytes"] = stats.bytes;
+                result["saved_bytes"] = stats.savedBytes;
+                return result;
+            },
+            "Returns a dict with the names and unique counts, and the bytes and saved_bytes "
+            "memory estimates")
+        .def(
+            "write",
+            [](const morphio::MorphologyStore& store, py::object path) {
+                store.write(py::str(path));
+            },
+            "Writes the distinct morphologies and the names to an archive",
+            "path"_a)
+        .def(
+            "read",
+            [](morphio::MorphologyStore& store, py::object path) { store.read(py::str(path)); },
+            "Adds the morphologies of an archive, replacing those with the same names",
+            "path"_a);
+
     py::class_<morphio::Mitochondria>(
         m,
         "Mitochondria",
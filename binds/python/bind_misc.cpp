@@ -1,17 +1,54 @@
 #include "bind_misc.h"
 
+#include <memory>     // std::unique_ptr
+#include <stdexcept>  // std::runtime_error
+
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include <morphio/enums.h>
 #include <morphio/errorMessages.h>
+#include <morphio/stats.h>
 #include <morphio/types.h>
 #include <morphio/version.h>
+#include <morphio/warning_sink.h>
 
 #include "bind_enums.h"
 
 namespace py = pybind11;
 
+namespace {
+/** Stats usable as a context manager, collecting the loads of the thread entering it **/
+struct PyStats {
+    morphio::Stats stats;
+    std::unique_ptr<morphio::StatsCollector> collector;
+};
+
+/** A CollectingWarningSink usable as a context manager, for the thread entering it **/
+struct PyWarningCollector {
+    morphio::CollectingWarningSink sink;
+    std::unique_ptr<morphio::ScopedWarningSink> scope;
+};
+
+py::dict statsDict(const morphio::Stats& stats) {
+    py::dict seconds;
+    py::dict calls;
+    for (size_t i = 0; i < morphio::Stats::PHASE_COUNT; ++i) {
+        const auto phase = morphio::Stats::phaseName(static_cast<morphio::Stats::Phase>(i));
+        seconds[phase] = stats.seconds[i];
+        calls[phase] = stats.calls[i];
+    }
+    py::dict result;
+    result["loads"] = stats.loads;
+    result["bytes_read"] = stats.bytesRead;
+    result["allocated_bytes"] = stats.allocatedBytes;
+    result["warnings"] = stats.warnings;
+    result["seconds"] = seconds;
+    result["calls"] = calls;
+    return result;
+}
+}  // namespace
+
 void bind_misc(py::module& m) {
     using namespace py::literals;
 
@@ -32,6 +69,81 @@ void bind_misc(py::module& m) {
           "warning"_a,
           "ignore"_a = true);
 
+    m.def("stats_enabled",
+          &morphio::statsEnabled,
+          "Returns whether MorphIO was built to record load statistics");
+
+    py::class_<PyStats>(m,
+                        "Stats",
+                        "Counters of the morphology loads done by a thread: time spent in each "
+                        "phase, bytes read, memory allocated and warnings.\n"
+                        "Loads are recorded inside a `with` block, in the thread entering it:\n"
+                        "    with morphio.Stats() as stats:\n"
+                        "        morphio.Morphology(path)\n"
+                        "    stats.as_dict()['seconds']['read']")
+        .def(py::init<>())
+        .def("__enter__",
+             [](py::object self) {
+                 auto& stats = self.cast<PyStats&>();
+                 if (stats.collector) {
+                     throw std::runtime_error("These Stats are already collecting");
+                 }
+                 stats.collector.reset(new morphio::StatsCollector(stats.stats));
+                 return self;
+             })
+        .def("__exit__",
+             [](PyStats& self, py::object, py::object, py::object) { self.collector.reset(); })
+        .def(
+            "__iadd__",
+            [](py::object self, const PyStats& other) {
+                self.cast<PyStats&>().stats += other.stats;
+                return self;
+            },
+            "Adds the counters of other, e.g. those of another thread of a batch")
+        .def(
+            "as_dict",
+            [](const PyStats& self) { return statsDict(self.stats); },
+            "Returns a dict with the loads, bytes_read, allocated_bytes and warnings counts, "
+            "and dicts of the seconds spent in and calls of each phase");
+
+    py::class_<PyWarningCollector>(m,
+                                   "WarningCollector",
+                                   "Collects the warnings raised by a thread instead of printing "
+                                   "them.\n"
+                                   "Warnings are collected inside a `with` block, in the thread "
+                                   "entering it:\n"
+                                   "    with morphio.WarningCollector() as warnings:\n"
+                                   "        morphio.Morphology(path)\n"
+                                   "    for warning, message in warnings.records(): ...")
+        .def(py::init<>())
+        .def("__enter__",
+             [](py::object self) {
+                 auto& collector = self.cast<PyWarningCollector&>();
+                 if (collector.scope) {
+                     throw std::runtime_error("This WarningCollector is already collecting");
+                 }
+                 collector.scope.reset(new morphio::ScopedWarningSink(collector.sink));
+                 return self;
+             })
+        .def("__exit__",
+             [](PyWarningCollector& self, py::object, py::object, py::object) {
+                 self.scope.reset();
+             })
+        .def(
+            "records",
+            [](const PyWarningCollector& self) {
+                py::list records;
+                for (const auto& record : self.sink.records()) {
+                    records.append(py::make_tuple(record.warning, record.message));
+                }
+                return records;
+            },
+            "Returns the (warning, message) tuples collected so far, in order")
+        .def(
+            "clear",
+            [](PyWarningCollector& self) { self.sink.clear(); },
+            "Forgets the collected warnings");
+
     py::enum_<morphio::enums::AnnotationType>(m, "AnnotationType")
         .value("single_child",
                morphio::enums::AnnotationType::SINGLE_CHILD,
@@ -77,6 +189,7 @@ void bind_misc(py::module& m) {
         .value("soma_sphere", morphio::enums::Option::SOMA_SPHERE)
         .value("no_duplicates", morphio::enums::Option::NO_DUPLICATES)
         .value("nrn_order", morphio::enums::Option::NRN_ORDER)
+        .value("shrink_to_fit", morphio::enums::Option::SHRINK_TO_FIT)
         .export_values();
 
 
@@ -93,6 +206,8 @@ void bind_misc(py::module& m) {
                morphio::enums::MorphologyVersion::MORPHOLOGY_VERSION_UNDEFINED)
         .value("MORPHOLOGY_VERSION_ASC_1",
                morphio::enums::MorphologyVersion::MORPHOLOGY_VERSION_ASC_1)
+        .value("MORPHOLOGY_VERSION_BINARY_1",
+               morphio::enums::MorphologyVersion::MORPHOLOGY_VERSION_BINARY_1)
         .export_values();
 
     py::enum_<morphio::enums::CellFamily>(m, "CellFamily")
@@ -113,7 +228,8 @@ void bind_misc(py::module& m) {
         .value("wrong_duplicate", morphio::enums::WRONG_DUPLICATE)
         .value("appending_empty_section", morphio::enums::APPENDING_EMPTY_SECTION)
         .value("wrong_root_point", morphio::enums::Warning::WRONG_ROOT_POINT)
-        .value("only_child", morphio::enums::Warning::ONLY_CHILD);
+        .value("only_child", morphio::enums::Warning::ONLY_CHILD)
+        .value("broken_section", morphio::enums::Warning::BROKEN_SECTION);
 
     py::enum_<morphio::enums::AccessMode>(m, "AccessMode")
         .value("MODE_READ", morphio::enums::AccessMode::MODE_READ)
@@ -239,6 +355,10 @@ void bind_misc(py::module& m) {
                        &morphio::Property::Annotation::_lineNumber,
                        "Returns the lineNumber")
         .def_readwrite("details", &morphio::Property::Annotation::_details, "Returns the details")
+        .def_readwrite("point_range",
+                       &morphio::Property::Annotation::_pointRange,
+                       "Returns the (start, end) range of the annotated points in the section, "
+                       "when the points were not copied")
         .def_property_readonly(
             "points",
             [](morphio::Property::Annotation* a) { return a->_points._points; },
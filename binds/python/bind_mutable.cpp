@@ -78,7 +78,8 @@ void bind_mutable_module(py::module& m) {
              "instances",
              "section_id"_a)
         .def("build_read_only",
-             &morphio::mut::Morphology::buildReadOnly,
+             static_cast<morphio::Property::Properties (morphio::mut::Morphology::*)() const&>(
+                 &morphio::mut::Morphology::buildReadOnly),
              "Returns the data structure used to create read-only "
              "morphologies")
         .def("append_root_section",
@@ -128,11 +129,28 @@ void bind_mutable_module(py::module& m) {
 
         .def_property_readonly("version", &morphio::mut::Morphology::version, "Returns the version")
 
-        .def("sanitize",
-             static_cast<void (morphio::mut::Morphology::*) ()>(
-                 &morphio::mut::Morphology::sanitize),
-             "Fixes the morphology single child sections and issues warnings"
-             "if the section starts and ends are inconsistent")
+        .def(
+            "sanitize",
+            [](morphio::mut::Morphology* morph, bool copyAnnotationPoints) {
+                morph->sanitize(morphio::readers::DebugInfo(), copyAnnotationPoints);
+            },
+            "Fixes the morphology single child sections and issues warnings"
+            "if the section starts and ends are inconsistent\n\n"
+            "If copy_annotation_points is False, the single child annotations refer to the "
+            "section the points were merged into and to their point_range in it instead of "
+            "copying them",
+            "copy_annotation_points"_a = true)
+
+        .def(
+            "memory_usage",
+            [](const morphio::mut::Morphology& morph) {
+                return memory_usage_to_dict(morph.memoryUsage());
+            },
+            "Returns a dict of the estimated bytes held by the morphology, by component, "
+            "with their total")
+        .def("shrink_to_fit",
+             &morphio::mut::Morphology::shrinkToFit,
+             "Releases the unused capacity of the arrays, e.g. after building the morphology")
 
         .def(
             "write",
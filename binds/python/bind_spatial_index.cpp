@@ -0,0 +1,157 @@
+#include "bind_spatial_index.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <morphio/morphology.h>
+#include <morphio/spatial_index.h>
+#include <morphio/vasc/vasculature.h>
+
+#include "bindings_utils.h"
+
+namespace py = pybind11;
+
+namespace {
+
+py::array_t<uint32_t> segment_ids_to_ndarray(const std::vector<morphio::SegmentId>& ids) {
+    py::array_t<uint32_t> result({static_cast<py::ssize_t>(ids.size()), py::ssize_t{2}});
+    auto data = result.mutable_unchecked<2>();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        data(static_cast<py::ssize_t>(i), 0) = ids[i].section;
+        data(static_cast<py::ssize_t>(i), 1) = ids[i].segment;
+    }
+    return result;
+}
+
+py::list batch_to_list(const std::vector<std::vector<morphio::SegmentId>>& batch) {
+    py::list result;
+    for (const auto& ids : batch) {
+        result.append(segment_ids_to_ndarray(ids));
+    }
+    return result;
+}
+
+}  // anonymous namespace
+
+void bind_spatial_index(py::module& m) {
+    using namespace py::literals;
+
+    py::class_<morphio::SpatialIndex>(
+        m,
+        "SpatialIndex",
+        "A bounding volume hierarchy over the segments of a morphology or a vasculature\n\n"
+        "Segments are seen as the capsules bounding their frustums. Queries return arrays of\n"
+        "(section id, segment id) rows, where segment i of a section joins its points i and i+1")
+        .def(py::init<const morphio::Morphology&>(), "morphology"_a)
+        .def(py::init<const morphio::vasculature::Vasculature&>(), "vasculature"_a)
+        .def("__len__", &morphio::SpatialIndex::size)
+        .def_property_readonly(
+            "bounds",
+            [](const morphio::SpatialIndex& index) {
+                const auto box = index.bounds();
+                return py::make_tuple(box.min, box.max);
+            },
+            "Returns the (min, max) corners of the box containing all segments")
+        .def(
+            "intersects_box",
+            [](const morphio::SpatialIndex& index,
+               const morphio::Point& min,
+               const morphio::Point& max) {
+                return segment_ids_to_ndarray(index.intersects(morphio::BoundingBox{min, max}));
+            },
+            "Returns the segments intersecting the box",
+            "min"_a,
+            "max"_a)
+        .def(
+            "intersects_sphere",
+            [](const morphio::SpatialIndex& index,
+               const morphio::Point& center,
+               morphio::floatType radius) {
+                return segment_ids_to_ndarray(index.intersects(center, radius));
+            },
+            "Returns the segments intersecting the sphere",
+            "center"_a,
+            "radius"_a)
+        .def(
+            "nearest",
+            [](const morphio::SpatialIndex& index, const morphio::Point& point) {
+                const auto nearest = index.nearest(point);
+                return py::make_tuple(nearest.id.section, nearest.id.segment, nearest.distance);
+            },
+            "Returns the (section id, segment id, distance) of the segment closest to the point",
+            "point"_a)
+        .def(
+            "intersects_box_batch",
+            [](const morphio::SpatialIndex& index,
+               py::array_t<morphio::floatType> mins,
+               py::array_t<morphio::floatType> maxs,
+               unsigned int n_threads) {
+                const auto lows = array_to_points(mins);
+                const auto highs = array_to_points(maxs);
+                if (lows.size() != highs.size()) {
+                    throw morphio::MorphioError("mins and maxs must have the same shape");
+                }
+                std::vector<morphio::BoundingBox> boxes;
+                boxes.reserve(lows.size());
+                for (size_t i = 0; i < lows.size(); ++i) {
+                    boxes.push_back({lows[i], highs[i]});
+                }
+                std::vector<std::vector<morphio::SegmentId>> result;
+                {
+                    py::gil_scoped_release release;
+                    result = index.intersects(boxes, n_threads);
+                }
+                return batch_to_list(result);
+            },
+            "Returns, for each (min, max) pair of corners, the array of intersecting segments\n"
+            "n_threads=0 uses one thread per core",
+            "mins"_a,
+            "maxs"_a,
+            "n_threads"_a = 0)
+        .def(
+            "intersects_sphere_batch",
+            [](const morphio::SpatialIndex& index,
+               py::array_t<morphio::floatType> centers,
+               const std::vector<morphio::floatType>& radii,
+               unsigned int n_threads) {
+                const auto points = array_to_points(centers);
+                std::vector<std::vector<morphio::SegmentId>> result;
+                {
+                    py::gil_scoped_release release;
+                    result = index.intersects(points, radii, n_threads);
+                }
+                return batch_to_list(result);
+            },
+            "Returns, for each sphere, the array of intersecting segments\n"
+            "n_threads=0 uses one thread per core",
+            "centers"_a,
+            "radii"_a,
+            "n_threads"_a = 0)
+        .def(
+            "nearest_batch",
+            [](const morphio::SpatialIndex& index,
+               py::array_t<morphio::floatType> points,
+               unsigned int n_threads) {
+                const auto queries = array_to_points(points);
+                std::vector<morphio::NearestSegment> nearest;
+                {
+                    py::gil_scoped_release release;
+                    nearest = index.nearest(queries, n_threads);
+                }
+                std::vector<morphio::SegmentId> ids;
+                std::vector<morphio::floatType> distances;
+                ids.reserve(nearest.size());
+                distances.reserve(nearest.size());
+                for (const auto& segment : nearest) {
+                    ids.push_back(segment.id);
+                    distances.push_back(segment.distance);
+                }
+                return py::make_tuple(segment_ids_to_ndarray(ids),
+                                      as_pyarray(std::move(distances)));
+            },
+            "Returns a tuple of the (section id, segment id) array and of the distance array of\n"
+            "the segments closest to each point. n_threads=0 uses one thread per core",
+            "points"_a,
+            "n_threads"_a = 0);
+}
@@ -3,6 +3,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <morphio/vasc/metrics.h>
+#include <morphio/vasc/mut/vasculature.h>
 #include <morphio/vasc/section.h>
 #include <morphio/vasc/vasculature.h>
 
@@ -12,9 +14,28 @@ namespace py = pybind11;
 
 void bind_vasculature(py::module& m) {
     using namespace py::literals;
+    namespace metrics = morphio::vasculature::metrics;
 
     py::class_<morphio::vasculature::Vasculature>(m, "Vasculature")
         .def(py::init<const std::string&>(), "filename"_a)
+        .def(py::init<const std::string&, uint32_t, uint32_t>(),
+             "filename"_a,
+             "first_section"_a,
+             "last_section"_a,
+             "Load only the sections [first_section, last_section), renumbered from 0, and the "
+             "connections between them")
+        .def(py::init([](const std::string& filename,
+                         const morphio::Point& min,
+                         const morphio::Point& max) {
+                 return std::unique_ptr<morphio::vasculature::Vasculature>(
+                     new morphio::vasculature::Vasculature(filename,
+                                                           morphio::BoundingBox{min, max}));
+             }),
+             "filename"_a,
+             "min"_a,
+             "max"_a,
+             "Load only the sections intersecting the box [min, max], renumbered from 0 in file "
+             "order, and the connections between them")
         .def(py::init([](py::object arg) {
                  return std::unique_ptr<morphio::vasculature::Vasculature>(
                      new morphio::vasculature::Vasculature(py::str(arg)));
@@ -65,7 +86,116 @@ void bind_vasculature(py::module& m) {
                 return py::make_iterator(morpho->begin(), morpho->end());
             },
             py::keep_alive<0, 1>() /* Essential: keep object alive while iterator exists */,
-            "Iterate on all sections of the graph");
+            "Iterate on all sections of the graph")
+        .def("subgraph",
+             &morphio::vasculature::Vasculature::subgraph,
+             "Returns the vasculature made of the given sections and the connections between "
+             "them. The section section_ids[i] becomes the section i",
+             "section_ids"_a)
+        .def(
+            "depth_first_order",
+            [](const morphio::vasculature::Vasculature& morpho) {
+                return as_pyarray(morpho.depthFirstOrder());
+            },
+            "Returns the section IDs in the order of iter()")
+        .def(
+            "breadth_first_order",
+            [](const morphio::vasculature::Vasculature& morpho) {
+                return as_pyarray(morpho.breadthFirstOrder());
+            },
+            "Returns the section IDs breadth first, starting from the sections without "
+            "predecessors")
+        .def(
+            "connected_components",
+            [](const morphio::vasculature::Vasculature& morpho) {
+                return as_pyarray(morpho.connectedComponents());
+            },
+            "Returns the connected component label of every section")
+        .def(
+            "memory_usage",
+            [](const morphio::vasculature::Vasculature& morpho) {
+                return memory_usage_to_dict(morpho.memoryUsage());
+            },
+            "Returns a dict of the estimated bytes held by the vasculature, by component, "
+            "with their total")
+
+        // Metrics
+        .def(
+            "segment_lengths",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::segmentLengths(morpho.properties(), threads));
+            },
+            "Returns the length of every segment, section after section. The segments of "
+            "section i are [segment_offsets[i], segment_offsets[i + 1])",
+            "threads"_a = 0)
+        .def_property_readonly(
+            "segment_offsets",
+            [](const morphio::vasculature::Vasculature& morpho) {
+                return as_pyarray(metrics::segmentOffsets(morpho.properties()));
+            },
+            "Returns the first segment of every section, followed by the number of segments")
+        .def(
+            "segment_volumes",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::segmentVolumes(morpho.properties(), threads));
+            },
+            "Returns the volume of every segment frustum",
+            "threads"_a = 0)
+        .def(
+            "segment_lateral_areas",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::segmentLateralAreas(morpho.properties(), threads));
+            },
+            "Returns the lateral area of every segment frustum",
+            "threads"_a = 0)
+        .def(
+            "section_lengths",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::sectionLengths(morpho.properties(), threads));
+            },
+            "Returns the path length of every section",
+            "threads"_a = 0)
+        .def(
+            "section_volumes",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::sectionVolumes(morpho.properties(), threads));
+            },
+            "Returns the volume of every section",
+            "threads"_a = 0)
+        .def(
+            "section_lateral_areas",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::sectionLateralAreas(morpho.properties(), threads));
+            },
+            "Returns the lateral area of every section",
+            "threads"_a = 0)
+        .def(
+            "section_mean_diameters",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                return as_pyarray(metrics::sectionMeanDiameters(morpho.properties(), threads));
+            },
+            "Returns the mean diameter of every section, weighted by the segment lengths",
+            "threads"_a = 0)
+        .def_property_readonly(
+            "degrees",
+            [](const morphio::vasculature::Vasculature& morpho) {
+                return as_pyarray(metrics::degrees(morpho.properties()));
+            },
+            "Returns the number of predecessors plus successors of every section")
+        .def(
+            "vessel_graph",
+            [](const morphio::vasculature::Vasculature& morpho, unsigned int threads) {
+                auto graph = metrics::vesselGraph(morpho.properties(), threads);
+                return py::make_tuple(graph.nodeCount,
+                                      as_pyarray(std::move(graph.sources)),
+                                      as_pyarray(std::move(graph.targets)),
+                                      as_pyarray(std::move(graph.lengths)),
+                                      as_pyarray(std::move(graph.diameters)));
+            },
+            "Returns (node_count, sources, targets, lengths, diameters): section i is the edge "
+            "between the nodes sources[i] and targets[i], the connected section ends being "
+            "merged into a single node",
+            "threads"_a = 0);
 
 
     py::class_<morphio::vasculature::Section>(m, "Section")
@@ -79,6 +209,20 @@ void bind_vasculature(py::module& m) {
         .def_property_readonly("neighbors",
                                &morphio::vasculature::Section::neighbors,
                                "Returns the neighbors section of this section")
+        .def_property_readonly(
+            "predecessor_ids",
+            [](morphio::vasculature::Section* section) {
+                const auto ids = section->predecessorIds();
+                return py::array(static_cast<py::ssize_t>(ids.size()), ids.data());
+            },
+            "Returns the IDs of the predecessors of this section")
+        .def_property_readonly(
+            "successor_ids",
+            [](morphio::vasculature::Section* section) {
+                const auto ids = section->successorIds();
+                return py::array(static_cast<py::ssize_t>(ids.size()), ids.data());
+            },
+            "Returns the IDs of the successors of this section")
 
         // Property-related accessors
         .def_property_readonly("id",
@@ -110,4 +254,100 @@ void bind_vasculature(py::module& m) {
             },
             py::keep_alive<0, 1>() /* Essential: keep object alive while iterator exists */,
             "Section iterator\n");
+
+    using MutVasculature = morphio::vasculature::mut::Vasculature;
+    using Connections = std::vector<morphio::vasculature::property::Connection::Type>;
+    py::module mut_module = m.def_submodule("mut");
+
+    py::class_<MutVasculature>(mut_module, "Vasculature")
+        .def(py::init<>())
+        .def(py::init<const std::string&>(), "filename"_a)
+        .def(py::init<const morphio::vasculature::Vasculature&>(), "vasculature"_a)
+        .def(py::init([](py::object arg) {
+                 return std::unique_ptr<MutVasculature>(new MutVasculature(py::str(arg)));
+             }),
+             "filename"_a,
+             "Additional Ctor that accepts as filename any python object that implements __repr__ "
+             "or __str__")
+        .def("as_immutable",
+             [](const MutVasculature& vasculature) {
+                 return morphio::vasculature::Vasculature(vasculature);
+             })
+
+        .def_property_readonly("section_count",
+                               &MutVasculature::sectionCount,
+                               "Returns the number of sections")
+        .def_property_readonly(
+            "points",
+            [](const MutVasculature& vasculature) {
+                return span_array_to_ndarray(morphio::range<const morphio::Point>(
+                    vasculature.points().data(), vasculature.points().size()));
+            },
+            "Returns a copy of all the points, section after section")
+        .def_property_readonly(
+            "diameters",
+            [](const MutVasculature& vasculature) {
+                const auto& diameters = vasculature.diameters();
+                return py::array(static_cast<py::ssize_t>(diameters.size()), diameters.data());
+            },
+            "Returns a copy of all the diameters, section after section")
+        .def_property_readonly(
+            "section_types",
+            [](const MutVasculature& vasculature) {
+                const auto& types = vasculature.sectionTypes();
+                return py::array(static_cast<py::ssize_t>(types.size()), types.data());
+            },
+            "Returns a copy of the section type of every section")
+        .def_property_readonly(
+            "section_offsets",
+            [](const MutVasculature& vasculature) {
+                return as_pyarray(vasculature.sectionOffsets());
+            },
+            "Returns the first point of every section, followed by the number of points")
+        .def_property_readonly("connectivity",
+                               &MutVasculature::connectivity,
+                               "Returns the connections, as (from, to) section IDs")
+
+        .def(
+            "append_sections",
+            [](MutVasculature& vasculature,
+               py::array_t<morphio::floatType> points,
+               const std::vector<morphio::floatType>& diameters,
+               const std::vector<uint32_t>& point_offsets,
+               const std::vector<morphio::VascularSectionType>& types,
+               const Connections& connectivity) {
+                return vasculature.appendSections(
+                    array_to_points(points), diameters, point_offsets, types, connectivity);
+            },
+            "Append sections in one go and return the ID of the first of them\n"
+            "point_offsets[i] is the first point of the i-th new section. connectivity uses the "
+            "final section IDs",
+            "points"_a,
+            "diameters"_a,
+            "point_offsets"_a,
+            "types"_a,
+            "connectivity"_a = Connections())
+        .def("append_connections",
+             &MutVasculature::appendConnections,
+             "Append connections between existing sections",
+             "connectivity"_a)
+        .def("delete_sections",
+             &MutVasculature::deleteSections,
+             "Delete the sections and every connection to them. The other sections are "
+             "renumbered from 0",
+             "section_ids"_a)
+        .def(
+            "memory_usage",
+            [](const MutVasculature& vasculature) {
+                return memory_usage_to_dict(vasculature.memoryUsage());
+            },
+            "Returns a dict of the estimated bytes held by the vasculature, by component, "
+            "with their total")
+        .def("shrink_to_fit",
+             &MutVasculature::shrinkToFit,
+             "Releases the unused capacity of the arrays, e.g. after deleting sections")
+        .def("write",
+             &MutVasculature::write,
+             "Write the vasculature to an HDF5 file",
+             "filename"_a);
 }
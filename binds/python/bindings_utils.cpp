@@ -60,3 +60,20 @@ py::array_t<morphio::floatType> span_array_to_ndarray(
          sizeof(morphio::floatType)});
     return py::array(buffer_info);
 }
+
+py::dict memory_usage_to_dict(const morphio::MemoryUsage& usage) {
+    py::dict result;
+    result["points"] = usage.points;
+    result["soma"] = usage.soma;
+    result["sections"] = usage.sections;
+    result["children"] = usage.children;
+    result["annotations"] = usage.annotations;
+    result["mitochondria"] = usage.mitochondria;
+    result["endoplasmic_reticulum"] = usage.endoplasmicReticulum;
+    result["connectivity"] = usage.connectivity;
+    result["objects"] = usage.objects;
+    result["allocator_overhead"] = usage.allocatorOverhead;
+    result["unused"] = usage.unused;
+    result["total"] = usage.total();
+    return result;
+}
@@ -3,6 +3,7 @@
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <morphio/memory_usage.h>
 #include <morphio/types.h>
 
 namespace py = pybind11;
@@ -10,6 +11,7 @@ namespace py = pybind11;
 morphio::Points array_to_points(py::array_t<morphio::floatType>& buf);
 py::array_t<morphio::floatType> span_array_to_ndarray(
     const morphio::range<const morphio::Point>& span);
+py::dict memory_usage_to_dict(const morphio::MemoryUsage& usage);
 
 template <typename T>
 py::array_t<morphio::floatType> span_to_ndarray(const morphio::range<const T>& span) {
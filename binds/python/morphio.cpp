@@ -3,6 +3,7 @@
 #include "bind_immutable.h"
 #include "bind_misc.h"
 #include "bind_mutable.h"
+#include "bind_spatial_index.h"
 #include "bind_vasculature.h"
 
 namespace py = pybind11;
@@ -10,6 +11,7 @@ namespace py = pybind11;
 PYBIND11_MODULE(_morphio, m) {
     bind_misc(m);
     bind_immutable_module(m);
+    bind_spatial_index(m);
 
     py::module mut_module = m.def_submodule("mut");
     bind_mutable_module(mut_module);
@@ -13,7 +13,10 @@ enum Option {
     TWO_POINTS_SECTIONS = 0x01,
     SOMA_SPHERE = 0x02,
     NO_DUPLICATES = 0x04,
-    NRN_ORDER = 0x08
+    NRN_ORDER = 0x08,
+    /** Not a modifier: release the capacity the readers left unused once loaded, see
+        Morphology::memoryUsage **/
+    SHRINK_TO_FIT = 0x10
 };
 
 /**
@@ -32,7 +35,9 @@ enum Warning {
     APPENDING_EMPTY_SECTION,
     WRONG_ROOT_POINT,
     ONLY_CHILD,
-    WRITE_EMPTY_MORPHOLOGY
+    WRITE_EMPTY_MORPHOLOGY,
+    BROKEN_SECTION,  // a section of an immutable morphology or vasculature without points
+    WARNING_COUNT    // the number of warnings above, not a warning
 };
 
 /** The supported versions for morphology files. */
@@ -42,6 +47,7 @@ enum MorphologyVersion {
     MORPHOLOGY_VERSION_H5_1_1 = 3,
     MORPHOLOGY_VERSION_ASC_1 = 4,
     MORPHOLOGY_VERSION_SWC_1 = 101,
+    MORPHOLOGY_VERSION_BINARY_1 = 201,
     MORPHOLOGY_VERSION_UNDEFINED
 };
 std::ostream& operator<<(std::ostream& os, MorphologyVersion v);
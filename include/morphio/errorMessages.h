@@ -7,6 +7,7 @@
 
 #include <morphio/mut/modifiers.h>
 #include <morphio/mut/section.h>
+#include <morphio/warning_sink.h>
 
 namespace morphio {
 /**
@@ -16,8 +17,6 @@ void set_maximum_warnings(int n_warnings);
 void set_ignored_warning(Warning warning, bool ignore = true);
 void set_ignored_warning(const std::vector<Warning>& warning, bool ignore = true);
 
-void printError(Warning warning, const std::string& msg);
-
 namespace readers {
 enum ErrorLevel { INFO, WARNING, ERROR };
 
@@ -192,14 +191,15 @@ class ErrorMessages
     std::string WARNING_DISCONNECTED_NEURITE(const Sample& sample) const;
     std::string WARNING_WRONG_DUPLICATE(const std::shared_ptr<morphio::mut::Section>& current,
                                         const std::shared_ptr<morphio::mut::Section>& parent) const;
-    std::string WARNING_APPENDING_EMPTY_SECTION(std::shared_ptr<morphio::mut::Section>);
+    std::string WARNING_APPENDING_EMPTY_SECTION(
+        const std::shared_ptr<morphio::mut::Section>& section) const;
     std::string WARNING_ONLY_CHILD(const DebugInfo& info,
                                    unsigned int parentId,
                                    unsigned int childId) const;
 
     std::string WARNING_NEUROMORPHO_SOMA_NON_CONFORM(const Sample& root,
                                                      const Sample& child1,
-                                                     const Sample& child2);
+                                                     const Sample& child2) const;
 
     std::string WARNING_WRONG_ROOT_POINT(const std::vector<Sample>& children) const;
 
@@ -207,6 +207,68 @@ class ErrorMessages
     std::string _uri;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+//              LAZY WARNINGS
+////////////////////////////////////////////////////////////////////////////////
+// The warnings that can be raised for every section or sample. They refer to their payload,
+// which must outlive the printError call
+
+struct DisconnectedNeuriteWarning: public WarningMessage {
+    DisconnectedNeuriteWarning(const ErrorMessages& err_, const Sample& sample_) noexcept
+        : WarningMessage(Warning::DISCONNECTED_NEURITE)
+        , err(err_)
+        , sample(sample_) {}
+    std::string msg() const override;
+
+    const ErrorMessages& err;
+    const Sample& sample;
+};
+
+struct WrongDuplicateWarning: public WarningMessage {
+    WrongDuplicateWarning(const ErrorMessages& err_,
+                          const std::shared_ptr<morphio::mut::Section>& current_,
+                          const std::shared_ptr<morphio::mut::Section>& parent_) noexcept
+        : WarningMessage(Warning::WRONG_DUPLICATE)
+        , err(err_)
+        , current(current_)
+        , parent(parent_) {}
+    std::string msg() const override;
+
+    const ErrorMessages& err;
+    const std::shared_ptr<morphio::mut::Section>& current;
+    const std::shared_ptr<morphio::mut::Section>& parent;
+};
+
+struct AppendingEmptySectionWarning: public WarningMessage {
+    AppendingEmptySectionWarning(const ErrorMessages& err_,
+                                 const std::shared_ptr<morphio::mut::Section>& section_) noexcept
+        : WarningMessage(Warning::APPENDING_EMPTY_SECTION)
+        , err(err_)
+        , section(section_) {}
+    std::string msg() const override;
+
+    const ErrorMessages& err;
+    const std::shared_ptr<morphio::mut::Section>& section;
+};
+
+struct OnlyChildWarning: public WarningMessage {
+    OnlyChildWarning(const ErrorMessages& err_,
+                     const DebugInfo& info_,
+                     unsigned int parentId_,
+                     unsigned int childId_) noexcept
+        : WarningMessage(Warning::ONLY_CHILD)
+        , err(err_)
+        , info(info_)
+        , parentId(parentId_)
+        , childId(childId_) {}
+    std::string msg() const override;
+
+    const ErrorMessages& err;
+    const DebugInfo& info;
+    unsigned int parentId;
+    unsigned int childId;
+};
+
 }  // namespace readers
 
 }  // namespace morphio
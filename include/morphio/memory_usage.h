@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>  // size_t
+
+namespace morphio {
+
+/**
+   Estimated heap memory held by a morphology or a vasculature, in bytes, by component.
+
+   Containers count for their capacity, not their size. allocatorOverhead estimates the
+   bookkeeping of the allocator: a header and the rounding of each heap block. unused is the
+   reserved but unused capacity of the vectors: it is already part of the components, and
+   shrinkToFit, or loading a morphology with the SHRINK_TO_FIT option, releases it.
+**/
+struct MemoryUsage {
+    size_t points = 0;                // coordinates, diameters and perimeters of the sections
+    size_t soma = 0;                  // soma points and diameters
+    size_t sections = 0;              // section offsets and types, or section objects
+    size_t children = 0;              // parent and children relations of the sections
+    size_t annotations = 0;           // annotations and their details
+    size_t mitochondria = 0;          // mitochondrial points and sections
+    size_t endoplasmicReticulum = 0;  // endoplasmic reticulum of the sections
+    size_t connectivity = 0;          // vasculature edges, adjacency and leakiness
+    size_t objects = 0;               // the top level objects themselves
+    size_t allocatorOverhead = 0;
+    size_t unused = 0;
+
+    /** Return the sum of the components and of the allocator overhead **/
+    size_t total() const noexcept {
+        return points + soma + sections + children + annotations + mitochondria +
+               endoplasmicReticulum + connectivity + objects + allocatorOverhead;
+    }
+
+    /** Add the usage of other to this one **/
+    MemoryUsage& operator+=(const MemoryUsage& other) noexcept {
+        points += other.points;
+        soma += other.soma;
+        sections += other.sections;
+        children += other.children;
+        annotations += other.annotations;
+        mitochondria += other.mitochondria;
+        endoplasmicReticulum += other.endoplasmicReticulum;
+        connectivity += other.connectivity;
+        objects += other.objects;
+        allocatorOverhead += other.allocatorOverhead;
+        unused += other.unused;
+        return *this;
+    }
+};
+
+}  // namespace morphio
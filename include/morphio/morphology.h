@@ -13,6 +13,30 @@ enum SomaClasses { SOMA_CONTOUR, SOMA_CYLINDER };
 using breadth_iterator = breadth_iterator_t<Section, Morphology>;
 using depth_iterator = depth_iterator_t<Section, Morphology>;
 
+/**
+   Load the geometry of a morphology with points, diameters and perimeters of type T, float or
+   double, whatever the precision MorphIO was built with.
+
+   The values are read from the file in T: SWC and ASC text is parsed in T and HDF5 datasets are
+   read as T, so a float build still gets the double values of a file with load_as<double>.
+   MorphIO binary files hold the precision they were written with. The structure, sanitization
+   and warnings are the ones of loading a Morphology, which decides them in floatType: the
+   sections and point counts are the same, and the options are applied in T. In floatType, the
+   arrays of the loaded morphology are moved without a copy.
+
+   Only the points, soma, sections and cell level are returned: annotations, mitochondria and the
+   endoplasmic reticulum are dropped. Load a Morphology for those.
+
+   Example:
+       const auto geometry = morphio::load_as<double>("neuron.h5");
+       geometry._pointLevel._points;  // std::vector<std::array<double, 3>>
+**/
+template <typename T>
+Property::GeometryT<T> load_as(const std::string& source, unsigned int options = NO_MODIFIER);
+
+extern template Property::GeometryT<float> load_as(const std::string&, unsigned int);
+extern template Property::GeometryT<double> load_as(const std::string&, unsigned int);
+
 /** Read access a Morphology file.
  *
  * Following RAII, this class is ready to use after the creation and will ensure
@@ -36,6 +60,9 @@ class Morphology
 
         Example:
             Morphology("neuron.asc", TWO_POINTS_SECTIONS | SOMA_SPHERE);
+
+        NO_DUPLICATES, TWO_POINTS_SECTIONS and NRN_ORDER copy the points of morphologies of
+        more than 64k points from several threads: one per 64k points, at most one per core.
      */
     explicit Morphology(const std::string& source, unsigned int options = NO_MODIFIER);
     explicit Morphology(const HighFive::Group& group, unsigned int options = NO_MODIFIER);
@@ -153,10 +180,40 @@ class Morphology
      **/
     const MorphologyVersion& version() const;
 
+    /**
+     * Return the estimated memory held by the morphology, by component.
+     *
+     * Copies of a Morphology, and a MorphologyCache, share the same properties: adding up
+     * the usage of the copies counts them several times
+     **/
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * Return a 64 bit hash of the content of the morphology, see Property::Properties::contentHash
+     *
+     * Morphologies whose hashes without points (HashOptions::points false) differ also differ
+     * for morphio::diff, which checks them first
+     **/
+    uint64_t contentHash(const Property::HashOptions& options = Property::HashOptions()) const;
+
   protected:
     friend class mut::Morphology;
+    friend class MorphologyCache;
+    friend class MorphologyStore;
+    template <typename T>
+    friend Property::GeometryT<T> load_as(const std::string&, unsigned int);
     Morphology(const Property::Properties& properties, unsigned int options);
 
+    /**
+       Sanitize what the readers loaded, when they did not, and apply the options. precise, when
+       not null, holds the points of the properties in precision T and goes along, see load_as
+    **/
+    template <typename T>
+    void _process(unsigned int options, Property::GeometryT<T>* precise);
+
+    /** Share properties that are already loaded **/
+    explicit Morphology(std::shared_ptr<Property::Properties> properties) noexcept;
+
     std::shared_ptr<Property::Properties> _properties;
 
     template <typename Property>
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>        // uint64_t
+#include <future>         // std::shared_future
+#include <list>           // std::list
+#include <memory>         // std::shared_ptr
+#include <mutex>          // std::mutex
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+
+#include <morphio/morphology.h>
+#include <morphio/quantized_point_level.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   A thread safe cache of loaded morphologies.
+
+   Morphologies are keyed by (canonical path, options, modification time, file size) so that
+   a file modified on disk is reloaded. All the Morphology objects handed out for the same key
+   share one immutable Property::Properties.
+
+   When the cached properties exceed the byte budget, the least recently used ones are evicted.
+   Evicted properties stay alive as long as a Morphology refers to them.
+
+   Concurrent lookups of a key that is being loaded wait for that load instead of parsing
+   the file again. Loads happen in the calling thread, outside of the cache lock.
+
+   With quantizePoints, the cache keeps the points, diameters and perimeters of each entry as a
+   Property::QuantizedPointLevel, half the memory of float points, and decodes them when the
+   entry is looked up. The morphologies handed out for a key share the decoded properties while
+   one of them is alive; their values are within the tolerances of the quantized level.
+**/
+class MorphologyCache
+{
+  public:
+    struct Stats {
+        /** Lookups served from the cache or from a load in progress **/
+        uint64_t hits = 0;
+        /** Lookups that loaded the file **/
+        uint64_t misses = 0;
+        /** Entries dropped to honor the byte budget **/
+        uint64_t evictions = 0;
+        /** Number of cached morphologies **/
+        size_t entries = 0;
+        /** Estimated memory used by the cached morphologies **/
+        size_t bytes = 0;
+    };
+
+    /** A cache holding at most maxBytes of morphology data, quantized if quantizePoints **/
+    explicit MorphologyCache(size_t maxBytes, bool quantizePoints = false);
+
+    MorphologyCache(const MorphologyCache&) = delete;
+    MorphologyCache& operator=(const MorphologyCache&) = delete;
+
+    /**
+     * Return the morphology at path, loaded with the given modifier options
+     *
+     * @throw RawDataError if the file does not exist, and any exception raised by the loader
+     **/
+    Morphology get(const std::string& path, unsigned int options = NO_MODIFIER);
+
+    /** Return the current statistics **/
+    Stats stats() const;
+
+    /** Return the byte budget **/
+    size_t maxBytes() const noexcept;
+
+    /** Return whether the points are stored quantized **/
+    bool quantizePoints() const noexcept;
+
+    /** Drop all cached morphologies; statistics are kept **/
+    void clear();
+
+  private:
+    struct Key {
+        std::string path;
+        unsigned int options;
+        int64_t mtime;
+        uint64_t size;
+
+        bool operator==(const Key& other) const noexcept;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept;
+    };
+
+    using PropertiesPtr = std::shared_ptr<Property::Properties>;
+
+    using QuantizedPtr = std::shared_ptr<const Property::QuantizedPointLevel>;
+
+    struct Entry {
+        // Without the point level if the points are quantized
+        PropertiesPtr properties;
+        QuantizedPtr points;
+        // The decoded properties handed out last, if still alive
+        std::weak_ptr<Property::Properties> decoded;
+        size_t bytes;
+        std::list<Key>::iterator position;
+    };
+
+    static Key _key(const std::string& path, unsigned int options);
+    /** Cache the properties of a load, and return those to hand out **/
+    PropertiesPtr _insert(const Key& key, const PropertiesPtr& properties);
+
+    const size_t _maxBytes;
+    const bool _quantizePoints;
+
+    mutable std::mutex _mutex;
+    // Most recently used first
+    std::list<Key> _lru;
+    std::unordered_map<Key, Entry, KeyHash> _entries;
+    std::unordered_map<Key, std::shared_future<PropertiesPtr>, KeyHash> _loading;
+    Stats _stats;
+};
+
+}  // namespace morphio
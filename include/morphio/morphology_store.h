@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>        // uint64_t
+#include <map>            // std::map
+#include <memory>         // std::shared_ptr
+#include <mutex>          // std::mutex
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_multimap
+#include <vector>         // std::vector
+
+#include <morphio/morphology.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   A thread safe set of named morphologies that stores each distinct content once.
+
+   Morphologies from any loader are added under a name. Those with the same content hash (see
+   Morphology::contentHash, organelles included) that do not differ for morphio::diff share one
+   immutable Property::Properties: the memory of a set of morphologies shrinks with its
+   duplication rate. Annotations are not compared: a duplicate gets the annotations of the first
+   morphology added with its content.
+
+   A store is written to, and read from, an archive file holding each distinct morphology once
+   in the MorphIO binary format, with an index of the names.
+
+   Example:
+       morphio::MorphologyStore store;
+       for (const auto& path : paths) {
+           store.add(path, morphio::Morphology(path));
+       }
+       store.write("circuit.mstore");
+       const auto morphology = morphio::MorphologyStore("circuit.mstore").get(paths[0]);
+**/
+class MorphologyStore
+{
+  public:
+    struct Stats {
+        /** Number of names **/
+        size_t names = 0;
+        /** Number of distinct morphologies **/
+        size_t unique = 0;
+        /** Estimated memory of the distinct morphologies **/
+        size_t bytes = 0;
+        /** Estimated memory the duplicates would take if they were not shared **/
+        size_t savedBytes = 0;
+    };
+
+    MorphologyStore() = default;
+
+    /** A store with the morphologies of an archive written by write() **/
+    explicit MorphologyStore(const std::string& filename);
+
+    MorphologyStore(const MorphologyStore&) = delete;
+    MorphologyStore& operator=(const MorphologyStore&) = delete;
+
+    /**
+     * Add a morphology under name, replacing the one that had this name, and return the shared
+     * instance now stored for it
+     **/
+    Morphology add(const std::string& name, const Morphology& morphology);
+    Morphology add(const std::string& name, const mut::Morphology& morphology);
+
+    /**
+     * Return the morphology stored under name
+     *
+     * @throw MorphioError if there is none
+     **/
+    Morphology get(const std::string& name) const;
+
+    bool contains(const std::string& name) const;
+
+    /** Return the names, sorted **/
+    std::vector<std::string> names() const;
+
+    /** Return the current statistics **/
+    Stats stats() const;
+
+    /**
+     * Write the distinct morphologies and the names to an archive
+     *
+     * @throw WriterError if the file cannot be written
+     **/
+    void write(const std::string& filename) const;
+
+    /**
+     * Add the morphologies of an archive written by write(), replacing those with the same
+     * names
+     *
+     * @throw RawDataError if the file does not exist or is not an archive
+     **/
+    void read(const std::string& filename);
+
+  private:
+    using PropertiesPtr = std::shared_ptr<Property::Properties>;
+
+    struct Entry {
+        PropertiesPtr properties;
+        uint64_t hash;
+        size_t bytes;
+        // Number of names referring to the entry
+        size_t names;
+    };
+
+    /** Store properties of the given hash and memory under name, the caller holding the lock **/
+    PropertiesPtr _add(const std::string& name,
+                       const PropertiesPtr& properties,
+                       uint64_t hash,
+                       size_t bytes);
+    void _release(Entry* entry);
+
+    mutable std::mutex _mutex;
+    // Distinct morphologies by content hash; pointers to the entries stay valid on insertion
+    std::unordered_multimap<uint64_t, Entry> _entries;
+    std::map<std::string, Entry*> _names;
+};
+
+}  // namespace morphio
@@ -98,6 +98,12 @@ class Mitochondria
 
     const MitoSectionP& mitoSection(uint32_t id) const;
 
+    /** Return the estimated memory held by the mitochondria, see MemoryUsage **/
+    MemoryUsage memoryUsage() const;
+
+    /** Release the unused capacity of the vectors **/
+    void shrinkToFit();
+
     /**
        Fill the 'properties' variable with the mitochondria data
     **/
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <unordered_map>
@@ -20,6 +21,8 @@
 
 namespace morphio {
 namespace mut {
+class SectionArena;
+
 bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
                           const std::shared_ptr<Section>& current);
 
@@ -138,7 +141,9 @@ class Morphology
        Will silently fail if the section is not part of the tree
 
        If recursive == true, all descendent sections will be deleted as well
-       Else, children will be re-attached to their grand-parent
+       Else, children will be re-attached to their grand-parent (or become root sections)
+
+       Runs in time linear in the number of deleted sections plus the number of siblings
     **/
     void deleteSection(const std::shared_ptr<Section>& section, bool recursive = true);
 
@@ -187,10 +192,31 @@ class Morphology
 
     inline void addAnnotation(const morphio::Property::Annotation& annotation);
 
-    /**
+    /** @{
        Return the data structure used to create read-only morphologies
+
+       The rvalue overload moves what it can out of the morphology and releases the points of
+       each section as soon as they are copied: the morphology, and the sections or soma
+       obtained from it, are left in a valid but unspecified state
     **/
-    Property::Properties buildReadOnly() const;
+    Property::Properties buildReadOnly() const&;
+    Property::Properties buildReadOnly() &&;
+    /** @} */
+
+    /**
+       Return the estimated memory held by the morphology, by component
+
+       Sections copied from an immutable morphology that still share its points count for
+       the whole shared properties, once. The section objects and their shared_ptr control
+       blocks count for the chunks of the section arena
+    **/
+    MemoryUsage memoryUsage() const;
+
+    /**
+       Release the unused capacity of the vectors, e.g. after building or editing the
+       morphology. Points still shared with an immutable morphology are left as they are
+    **/
+    void shrinkToFit();
 
     /**
      * Return the graph connectivity of the morphology where each section
@@ -203,9 +229,13 @@ class Morphology
     /**
        Fixes the morphology single child sections and issues warnings
        if the section starts and ends are inconsistent
+
+       Each merged section is reported by a SINGLE_CHILD annotation. If copyAnnotationPoints is
+       false, the annotation does not copy the section points but refers to the section they
+       were merged into (_sectionId) and to their range in it (_pointRange)
      **/
     void sanitize();
-    void sanitize(const morphio::readers::DebugInfo& debugInfo);
+    void sanitize(const morphio::readers::DebugInfo& debugInfo, bool copyAnnotationPoints = true);
 
   public:
     friend class Section;
@@ -216,7 +246,23 @@ class Morphology
     morphio::readers::ErrorMessages _err;
 
     uint32_t _register(const std::shared_ptr<Section>&);
-
+    // The section and point levels of buildReadOnly, with releasePoints the section points
+    // are freed once copied
+    void _buildSectionLevels(Property::Properties& properties, bool releasePoints) const;
+    // sanitize, calling onMerge(head, section, duplicate) when a section is appended to the head
+    // of its chain, without its first point if duplicate: lets the readers keep values parsed
+    // in another precision in step with the sections
+    void _sanitize(const morphio::readers::DebugInfo& debugInfo,
+                   bool copyAnnotationPoints,
+                   const std::function<void(uint32_t, uint32_t, bool)>& onMerge);
+    // Drop the section and empty its tree slots, re-linking its relatives is up to the caller
+    void _unlink(uint32_t id);
+
+    // Build a Section with the next id in the section arena, see src/mut/section_arena.h
+    template <typename... Args>
+    std::shared_ptr<Section> _createSection(Args&&... args);
+
+    std::shared_ptr<SectionArena> _sectionArena;
     uint32_t _counter;
     std::shared_ptr<Soma> _soma;
     std::shared_ptr<morphio::Property::CellLevel> _cellProperties;
@@ -226,8 +272,11 @@ class Morphology
     Mitochondria _mitochondria;
     EndoplasmicReticulum _endoplasmicReticulum;
 
-    std::map<uint32_t, uint32_t> _parent;
-    std::map<uint32_t, std::vector<std::shared_ptr<Section>>> _children;
+    // The tree structure, indexed by section id. Ids are never reused: the slots of deleted
+    // sections are left empty
+    static constexpr uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> _parent;
+    std::vector<std::vector<std::shared_ptr<Section>>> _children;
 };
 
 inline const std::vector<std::shared_ptr<Section>>& Morphology::rootSections() const noexcept {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <mutex>
 
 #include <morphio/properties.h>
 #include <morphio/section.h>
@@ -101,13 +103,44 @@ class Section: public std::enable_shared_from_this<Section>
 
   private:
     friend class Morphology;
+    friend bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
+                                     const std::shared_ptr<Section>& current);
 
     Section(Morphology*, unsigned int id, SectionType type, const Property::PointLevel&);
     Section(Morphology*, unsigned int id, const morphio::Section& section);
     Section(Morphology*, unsigned int id, const Section&);
 
+    /**
+       Sections copied from an immutable morphology share its point data until it is first
+       accessed (copy-on-write): only then is it copied to _pointProperties. Running out of
+       memory while copying terminates, as the accessors are noexcept
+    **/
+    inline void _materialize() const noexcept;
+    void _copySharedPoints() const noexcept;
+
+    /**
+       Materialize and drop the reference to the immutable properties, freed with the last
+       section sharing them. Only done by the non-const accessors: const ones may run
+       concurrently with readers of _source
+    **/
+    inline void _detach() noexcept;
+
+    /** The shared point data, or nullptr once the section has its own copy **/
+    inline const Property::PointLevel* _sharedPoints() const noexcept;
+
+    /** The points of the section, without copying shared data **/
+    range<const Point> _pointsView() const noexcept;
+    /** The diameters of the section, without copying shared data **/
+    range<const floatType> _diametersView() const noexcept;
+    /** The perimeters of the section, empty if it has none, without copying shared data **/
+    range<const floatType> _perimetersView() const noexcept;
+
     Morphology* _morphology;
-    Property::PointLevel _pointProperties;
+    mutable Property::PointLevel _pointProperties;
+    std::shared_ptr<const Property::Properties> _source;
+    SectionRange _sourceRange;
+    mutable std::atomic<bool> _shared{false};
+    mutable std::once_flag _materializeOnce;
     uint32_t _id;
     SectionType _sectionType;
 };
@@ -127,37 +160,60 @@ inline const SectionType& Section::type() const noexcept {
 }
 
 inline std::vector<Point>& Section::points() noexcept {
+    _detach();
     return _pointProperties._points;
 }
 
 inline const std::vector<Point>& Section::points() const noexcept {
+    _materialize();
     return _pointProperties._points;
 }
 
 inline std::vector<morphio::floatType>& Section::diameters() noexcept {
+    _detach();
     return _pointProperties._diameters;
 }
 
 inline const std::vector<morphio::floatType>& Section::diameters() const noexcept {
+    _materialize();
     return _pointProperties._diameters;
 }
 
 inline std::vector<morphio::floatType>& Section::perimeters() noexcept {
+    _detach();
     return _pointProperties._perimeters;
 }
 
 inline const std::vector<morphio::floatType>& Section::perimeters() const noexcept {
+    _materialize();
     return _pointProperties._perimeters;
 }
 
 inline Property::PointLevel& Section::properties() noexcept {
+    _detach();
     return _pointProperties;
 }
 
 inline const Property::PointLevel& Section::properties() const noexcept {
+    _materialize();
     return _pointProperties;
 }
 
+inline void Section::_materialize() const noexcept {
+    if (_shared.load(std::memory_order_acquire)) {
+        _copySharedPoints();
+    }
+}
+
+inline void Section::_detach() noexcept {
+    _materialize();
+    _source.reset();
+}
+
+inline const Property::PointLevel* Section::_sharedPoints() const noexcept {
+    return _shared.load(std::memory_order_acquire) ? &_source->_pointLevel : nullptr;
+}
+
 }  // namespace mut
 }  // namespace morphio
 
@@ -6,6 +6,8 @@ namespace writer {
 void swc(const Morphology& morphology, const std::string& filename);
 void asc(const Morphology& morphology, const std::string& filename);
 void h5(const Morphology& morphology, const std::string& filename);
+/** Write the MorphIO binary format, see readers/morphologyBinary.h **/
+void binary(const Morphology& morphology, const std::string& filename);
 }  // namespace writer
 }  // end namespace mut
 }  // end namespace morphio
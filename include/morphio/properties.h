@@ -20,6 +20,7 @@
 #pragma once
 
 #include <map>
+#include <morphio/memory_usage.h>
 #include <morphio/types.h>
 
 namespace morphio {
@@ -63,22 +64,47 @@ struct MitoNeuriteSectionId {
     using Type = uint32_t;
 };
 
-struct PointLevel {
-    std::vector<Point::Type> _points;
-    std::vector<Diameter::Type> _diameters;
-    std::vector<Perimeter::Type> _perimeters;
-
-    PointLevel() = default;
-    PointLevel(std::vector<Point::Type> points,
-               std::vector<Diameter::Type> diameters,
-               std::vector<Perimeter::Type> perimeters = {});
-    PointLevel(const PointLevel& data);
-    PointLevel(const PointLevel& data, SectionRange range);
-    PointLevel& operator=(const PointLevel& other);
+/**
+   Points, diameters and perimeters of precision T. PointLevel, the one of the morphologies, is in
+   floatType, but both float and double are compiled in, e.g. for load_as
+**/
+template <typename T>
+struct PointLevelT {
+    std::vector<PointT<T>> _points;
+    std::vector<T> _diameters;
+    std::vector<T> _perimeters;
+
+    PointLevelT() = default;
+    PointLevelT(std::vector<PointT<T>> points,
+                std::vector<T> diameters,
+                std::vector<T> perimeters = {});
+    PointLevelT(const PointLevelT& data);
+    PointLevelT(PointLevelT&&) noexcept = default;
+    PointLevelT(const PointLevelT& data, SectionRange range);
+    PointLevelT& operator=(const PointLevelT& other);
+    PointLevelT& operator=(PointLevelT&&) noexcept = default;
+
+    /** Convert points of another precision **/
+    template <typename U>
+    explicit PointLevelT(const PointLevelT<U>& other)
+        : _points(other._points.size())
+        , _diameters(other._diameters.begin(), other._diameters.end())
+        , _perimeters(other._perimeters.begin(), other._perimeters.end()) {
+        for (size_t i = 0; i < _points.size(); ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                _points[i][j] = static_cast<T>(other._points[i][j]);
+            }
+        }
+    }
     // bool operator==(const PointLevel& other) const;
     // bool operator!=(const PointLevel& other) const;
 };
 
+using PointLevel = PointLevelT<floatType>;
+
+extern template struct PointLevelT<float>;
+extern template struct PointLevelT<double>;
+
 struct SectionLevel {
     std::vector<Section::Type> _sections;
     std::vector<SectionType::Type> _sectionTypes;
@@ -138,11 +164,20 @@ struct Annotation {
                std::string details,
                int32_t lineNumber);
 
+    /** An annotation referring to the points [pointRange.first, pointRange.second) of a section **/
+    Annotation(AnnotationType type,
+               uint32_t sectionId,
+               SectionRange pointRange,
+               std::string details,
+               int32_t lineNumber);
+
     AnnotationType _type;
     uint32_t _sectionId;
     PointLevel _points;
     int32_t _lineNumber;
     std::string _details;
+    // Only set when _points is not a copy of the annotated points
+    SectionRange _pointRange;
 };
 
 struct CellLevel {
@@ -156,6 +191,24 @@ struct CellLevel {
     bool operator!=(const CellLevel& other) const;
 };
 
+/** What Properties::contentHash covers **/
+struct HashOptions {
+    /**
+       Hash the points, diameters and perimeters. Without them, the hash only covers the structure:
+       cell family, soma type, section types, parents and numbers of points
+    **/
+    bool points = true;
+
+    /**
+       Round the points, diameters and perimeters to multiples of tolerance, 0 to hash their exact
+       values. Values closer than tolerance usually, but not always, round to the same multiple
+    **/
+    floatType tolerance = 0;
+
+    /** Also hash the mitochondria and the endoplasmic reticulum **/
+    bool organelles = false;
+};
+
 // The lowest level data blob
 struct Properties {
     ////////////////////////////////////////////////////////////////////////////////
@@ -196,6 +249,30 @@ struct Properties {
     }
     template <typename T>
     const std::map<int32_t, std::vector<uint32_t>>& children() const noexcept;
+
+    /** Estimated heap memory of the containers of these properties, see MemoryUsage **/
+    MemoryUsage memoryUsage() const;
+    /** Release the unused capacity of the vectors **/
+    void shrinkToFit();
+
+    /**
+       A 64 bit hash of the content of the morphology, for deduplication: stable across runs and
+       platforms. Annotations, the file version and the children maps, derived
+       from the sections, are not hashed
+    **/
+    uint64_t contentHash(const HashOptions& options = HashOptions()) const;
+};
+
+/**
+   The geometry of a morphology with points, diameters and perimeters of precision T, see
+   load_as. Annotations keep the floatType precision
+**/
+template <typename T>
+struct GeometryT {
+    PointLevelT<T> _pointLevel;
+    SectionLevel _sectionLevel;
+    CellLevel _cellLevel;
+    PointLevelT<T> _somaLevel;
 };
 
 template <>
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>    // std::array
+#include <cstdint>  // uint16_t
+#include <vector>   // std::vector
+
+#include <morphio/memory_usage.h>
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+namespace morphio {
+namespace Property {
+
+/**
+   A PointLevel stored as 16 bit fixed point values: half the memory of floats, a quarter of that
+   of doubles.
+
+   Coordinates are quantized relative to the bounding box of the points, each axis in 65536
+   steps; diameters and perimeters relative to their minimum and maximum. The precision contract:
+   every decoded value is within the tolerance of its original value, i.e. half a step plus the
+   rounding of floatType. pointTolerance() is the bound of each coordinate, so a decoded point is
+   within sqrt(3) * pointTolerance() of the original one.
+
+   Values are decoded one at a time, or into PointLevel buffers whose points can be read as
+   range<const Point>, e.g. section by section.
+
+   MorphologyCache stores its entries this way when built with quantizePoints, see
+   MorphologyCache.
+
+   Example:
+       const Property::QuantizedPointLevel quantized(properties._pointLevel);
+       Property::PointLevel buffer;
+       quantized.decode(sectionRange, buffer);
+       const range<const morphio::Point> points = buffer._points;
+**/
+class QuantizedPointLevel
+{
+  public:
+    QuantizedPointLevel() = default;
+    explicit QuantizedPointLevel(const PointLevel& level);
+
+    /** Return the number of points **/
+    size_t size() const noexcept {
+        return _points.size();
+    }
+
+    morphio::Point point(size_t index) const noexcept;
+    floatType diameter(size_t index) const noexcept;
+    /** Return the perimeter of the point, 0 if the level has no perimeters **/
+    floatType perimeter(size_t index) const noexcept;
+
+    /** Return all the points, diameters and perimeters **/
+    PointLevel decode() const;
+
+    /**
+       Decode the points [range.first, range.second) into buffer, replacing its content.
+       Reusing a buffer avoids allocating once its capacity is large enough
+    **/
+    void decode(SectionRange range, PointLevel& buffer) const;
+
+    /** Return the maximum error of a decoded coordinate **/
+    floatType pointTolerance() const noexcept {
+        return _pointTolerance;
+    }
+    /** Return the maximum error of a decoded diameter **/
+    floatType diameterTolerance() const noexcept {
+        return _diameterTolerance;
+    }
+    /** Return the maximum error of a decoded perimeter **/
+    floatType perimeterTolerance() const noexcept {
+        return _perimeterTolerance;
+    }
+
+    /** Return the estimated heap memory of the quantized values, see MemoryUsage **/
+    MemoryUsage memoryUsage() const;
+
+  private:
+    std::vector<std::array<uint16_t, 3>> _points;
+    std::vector<uint16_t> _diameters;
+    std::vector<uint16_t> _perimeters;
+
+    morphio::Point _offset{};
+    morphio::Point _step{};
+    floatType _diameterOffset = 0;
+    floatType _diameterStep = 0;
+    floatType _perimeterOffset = 0;
+    floatType _perimeterStep = 0;
+
+    floatType _pointTolerance = 0;
+    floatType _diameterTolerance = 0;
+    floatType _perimeterTolerance = 0;
+};
+
+}  // namespace Property
+}  // namespace morphio
@@ -1,6 +1,7 @@
 #include <morphio/morphology.h>
 #include <morphio/properties.h>
 #include <morphio/section.h>
+#include <morphio/warning_sink.h>
 
 namespace morphio {
 template <typename T>
@@ -22,8 +23,7 @@ SectionBase<T>::SectionBase(const uint32_t id_,
     _range = std::make_pair(start, end);
 
     if (_range.second <= _range.first)
-        std::cerr << "Dereferencing broken properties section " << _id
-                  << "\nSection range: " << _range.first << " -> " << _range.second << '\n';
+        printError(BrokenSectionWarning(_id, _range));
 }
 
 template <typename T>
@@ -72,17 +72,17 @@ T SectionBase<T>::parent() const {
 template <typename T>
 std::vector<T> SectionBase<T>::children() const {
     std::vector<T> result;
-    try {
-        const std::vector<uint32_t>& _children = _properties->children<typename T::SectionId>().at(
-            static_cast<int>(_id));
-        result.reserve(_children.size());
-        for (const uint32_t id_ : _children)
-            result.push_back(T(id_, _properties));
-
-        return result;
-    } catch (const std::out_of_range&) {
+    // Leaves have no entry: finding that out is much cheaper than catching std::out_of_range
+    const auto& children = _properties->children<typename T::SectionId>();
+    const auto it = children.find(static_cast<int>(_id));
+    if (it == children.end())
         return result;
-    }
+
+    result.reserve(it->second.size());
+    for (const uint32_t id_ : it->second)
+        result.push_back(T(id_, _properties));
+
+    return result;
 }
 
 }  // namespace morphio
@@ -151,7 +151,7 @@ inline breadth_iterator_t<SectionT, MorphologyT>::breadth_iterator_t(const Secti
 template <typename SectionT, typename MorphologyT>
 inline breadth_iterator_t<SectionT, MorphologyT>::breadth_iterator_t(
     const MorphologyT& morphology) {
-    const auto& children = detail::getChildren<SectionT, MorphologyT>(morphology);
+    const auto& children = ::detail::getChildren<SectionT, MorphologyT>(morphology);
     std::copy(children.begin(), children.end(), std::back_inserter(deque_));
 }
 
@@ -172,7 +172,7 @@ breadth_iterator_t<SectionT, MorphologyT>::operator++() {
         throw MorphioError("Can't iterate past the end");
     }
 
-    const auto& children = detail::getChildren(deque_.front());
+    const auto& children = ::detail::getChildren(deque_.front());
     deque_.pop_front();
     std::copy(children.begin(), children.end(), std::back_inserter(deque_));
 
@@ -208,7 +208,7 @@ inline depth_iterator_t<SectionT, MorphologyT>::depth_iterator_t(const SectionT&
 
 template <typename SectionT, typename MorphologyT>
 inline depth_iterator_t<SectionT, MorphologyT>::depth_iterator_t(const MorphologyT& morphology) {
-    const auto& children = detail::getChildren<SectionT, MorphologyT>(morphology);
+    const auto& children = ::detail::getChildren<SectionT, MorphologyT>(morphology);
     std::copy(children.rbegin(), children.rend(), std::front_inserter(deque_));
 }
 
@@ -228,7 +228,7 @@ depth_iterator_t<SectionT, MorphologyT>::operator++() {
         throw MorphioError("Can't iterate past the end");
     }
 
-    const auto children = detail::getChildren(deque_.front());
+    const auto children = ::detail::getChildren(deque_.front());
     deque_.pop_front();
     std::copy(children.rbegin(), children.rend(), std::front_inserter(deque_));
 
@@ -291,11 +291,11 @@ template <typename SectionT>
 inline upstream_iterator_t<SectionT>& upstream_iterator_t<SectionT>::operator++() {
     if (end) {
         throw MissingParentError("Cannot call iterate upstream past the root node");
-    } else if (detail::isRoot(current)) {
+    } else if (::detail::isRoot(current)) {
         end = true;
         this->current.~SectionT();
     } else {
-        current = detail::getParent(current);
+        current = ::detail::getParent(current);
     }
     return *this;
 }
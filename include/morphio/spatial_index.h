@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>  // uint32_t
+#include <vector>   // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   Identifies a segment: the segment `segment` of the section `section` joins the points
+   `segment` and `segment + 1` of that section
+**/
+struct SegmentId {
+    uint32_t section;
+    uint32_t segment;
+
+    bool operator==(const SegmentId& other) const noexcept;
+    bool operator!=(const SegmentId& other) const noexcept;
+    bool operator<(const SegmentId& other) const noexcept;
+};
+
+/** Result of a nearest segment query **/
+struct NearestSegment {
+    SegmentId id;
+    /** Distance from the query point to the segment surface (0 if the point is inside) **/
+    floatType distance;
+};
+
+/**
+   A bounding volume hierarchy over the segments of a morphology or a vasculature.
+
+   Each segment is seen as the capsule that bounds its frustum: the cylinder between its two
+   points, with the largest of the two radii, capped with half spheres. Sections with less
+   than two points have no segment. Soma points are not indexed.
+
+   The index keeps its own copy of the geometry: it remains valid once the morphology is gone.
+   Queries are const and can be run concurrently; the batch overloads split their work over
+   `nThreads` threads (0 means one thread per core).
+**/
+class SpatialIndex
+{
+  public:
+    explicit SpatialIndex(const Morphology& morphology);
+    explicit SpatialIndex(const vasculature::Vasculature& vasculature);
+
+    /** Number of indexed segments **/
+    size_t size() const noexcept;
+
+    /**
+     * Box containing all the indexed segments
+     *
+     * @throw MorphioError if the index is empty
+     **/
+    BoundingBox bounds() const;
+
+    /** Segments intersecting the box, sorted by (section, segment) **/
+    std::vector<SegmentId> intersects(const BoundingBox& box) const;
+
+    /** Segments intersecting the sphere, sorted by (section, segment) **/
+    std::vector<SegmentId> intersects(const Point& center, floatType radius) const;
+
+    /**
+     * Segment whose surface is the closest to the point
+     *
+     * @throw MorphioError if the index is empty
+     **/
+    NearestSegment nearest(const Point& point) const;
+
+    /** Batch version of intersects(box) **/
+    std::vector<std::vector<SegmentId>> intersects(const std::vector<BoundingBox>& boxes,
+                                                   unsigned int nThreads = 0) const;
+
+    /**
+     * Batch version of intersects(center, radius)
+     *
+     * @throw MorphioError if centers and radii do not have the same size
+     **/
+    std::vector<std::vector<SegmentId>> intersects(const Points& centers,
+                                                   const std::vector<floatType>& radii,
+                                                   unsigned int nThreads = 0) const;
+
+    /** Batch version of nearest(point) **/
+    std::vector<NearestSegment> nearest(const Points& points, unsigned int nThreads = 0) const;
+
+  private:
+    struct Segment {
+        Point start;
+        Point end;
+        floatType radius;
+        SegmentId id;
+    };
+
+    struct Node {
+        BoundingBox box;
+        // Leaves: first segment and number of segments
+        // Inner nodes: count is 0, the left child is the next node and first is the right child
+        uint32_t first;
+        uint32_t count;
+    };
+
+    void _build(const Points& points,
+                const std::vector<floatType>& diameters,
+                const std::vector<uint32_t>& offsets);
+    uint32_t _buildNode(uint32_t begin, uint32_t end);
+
+    template <typename Accept>
+    void _collect(const BoundingBox& region,
+                  Accept accept,
+                  std::vector<SegmentId>& result) const;
+
+    std::vector<Segment> _segments;
+    std::vector<Node> _nodes;
+};
+
+}  // namespace morphio
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>    // std::array
+#include <cstdint>  // uint64_t
+
+namespace morphio {
+
+/**
+   Counters of the morphology loads done by a thread while a StatsCollector is alive.
+
+   Counters of several threads, e.g. the workers of a batch load, add up with +=. Nothing is
+   recorded when no collector is alive, and nothing at all when MorphIO is built with
+   MORPHIO_ENABLE_STATS=OFF (see statsEnabled).
+**/
+struct Stats {
+    /**
+       Steps of a load. LOAD spans a whole Morphology constructor, the other phases do not
+       overlap. SWC files are read while they are parsed, and mapped binary files while they
+       are deserialized: their reading counts as PARSE
+    **/
+    enum Phase {
+        LOAD,
+        READ,             // reading files and HDF5 datasets
+        PROBE,            // detecting the HDF5 version and repair stage
+        PARSE,            // turning SWC and ASC text, and binary blocks, into morphologies
+        SANITIZE,         // mut::Morphology::sanitize
+        MODIFIERS,        // applying the Option modifiers
+        BUILD_READ_ONLY,  // mut::Morphology::buildReadOnly
+        BUILD_CHILDREN,   // building the children of the sections of an immutable morphology
+        PHASE_COUNT
+    };
+
+    /** Return the lower case name of a phase, e.g. "build_read_only" **/
+    static const char* phaseName(Phase phase);
+
+    /** Number of morphologies loaded from a file or an HDF5 group **/
+    uint64_t loads = 0;
+
+    /** Bytes read from files. Mapped binary files count for their whole size **/
+    uint64_t bytesRead = 0;
+
+    /** Estimated memory allocated for the loaded morphologies **/
+    uint64_t allocatedBytes = 0;
+
+    /** Warnings raised, printed or not. Ignored warnings are not counted **/
+    uint64_t warnings = 0;
+
+    /** Wall time spent in each phase, in seconds **/
+    std::array<double, PHASE_COUNT> seconds{};
+
+    /** Number of times each phase ran **/
+    std::array<uint64_t, PHASE_COUNT> calls{};
+
+    /** Add the counters of other to these ones **/
+    Stats& operator+=(const Stats& other) noexcept;
+};
+
+/** Return whether MorphIO was built to record statistics **/
+bool statsEnabled() noexcept;
+
+/**
+   Record the statistics of the loads done by the calling thread into stats, until destroyed.
+
+   Collectors nest: an inner collector takes the counters until it is destroyed, then the
+   outer one gets them again. Other threads are not affected.
+
+   Example:
+       morphio::Stats stats;
+       {
+           morphio::StatsCollector collector(stats);
+           morphio::Morphology morphology("neuron.h5");
+       }
+       std::cout << stats.seconds[morphio::Stats::READ] << '\n';
+**/
+class StatsCollector
+{
+  public:
+    explicit StatsCollector(Stats& stats) noexcept;
+    ~StatsCollector();
+
+    StatsCollector(const StatsCollector&) = delete;
+    StatsCollector& operator=(const StatsCollector&) = delete;
+
+  private:
+    Stats* _previous;
+};
+
+}  // namespace morphio
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>  // uint32_t
+
+#include <morphio/mut/morphology.h>
+#include <morphio/types.h>
+#include <morphio/vasc/mut/vasculature.h>
+
+/**
+   Seeded generators of large morphologies and vasculatures, for scaling and stress tests.
+
+   The same parameters always give the same result with a given standard library (the random
+   distributions are not specified bit for bit across implementations). Trees are grown
+   iteratively: depth is only limited by memory.
+**/
+namespace morphio {
+namespace synthetic {
+
+struct NeuronParameters {
+    /** Seed of the random generator **/
+    uint32_t seed = 0;
+
+    /** Number of root sections. Their types cycle through axon, basal and apical dendrite **/
+    uint32_t neurites = 4;
+
+    /** Sections branch down to this depth, the root sections being at depth 0 **/
+    uint32_t maxDepth = 10;
+
+    /** Number of children of a branching section **/
+    uint32_t fanOut = 2;
+
+    /**
+       Stop once the morphology has this many sections, 0 for no limit. Sections are grown
+       breadth first, level by level across all the neurites, so that the trees stay balanced
+    **/
+    uint32_t maxSections = 0;
+
+    /** Number of points of every section, the first one duplicating the parent's last point **/
+    uint32_t pointsPerSection = 10;
+
+    /** Distance between two consecutive points **/
+    floatType segmentLength = 2;
+
+    /** Probability for a section to have a single child instead of fanOut **/
+    floatType unifurcationRate = 0;
+
+    /**
+       Probability for each child but the first one to be a leaf. With 1, neurites are combs
+       as deep as maxDepth, with fanOut sections per level
+    **/
+    floatType leafRate = 0;
+
+    /** Diameter of the root sections **/
+    floatType rootDiameter = 2;
+
+    /** Ratio between the diameter of a child and the diameter of its parent **/
+    floatType taper = floatType{9} / 10;
+
+    /** Diameters do not taper below this value **/
+    floatType minDiameter = floatType{1} / 5;
+
+    /**
+       Number of mitochondria. Each one is a mitochondrial section on a random neurite section
+       and, if that section has children, a child mitochondrial section on the first of them
+    **/
+    uint32_t mitochondria = 0;
+
+    /** Fraction of the sections with endoplasmic reticulum data **/
+    floatType reticulumRate = 0;
+};
+
+/**
+   A neuron with a one point soma at the origin and neurites that are random walks growing
+   away from it
+
+   @throw SectionBuilderError if neurites, fanOut or pointsPerSection is 0
+**/
+mut::Morphology neuron(const NeuronParameters& parameters);
+
+struct VasculatureParameters {
+    /** Seed of the random generator **/
+    uint32_t seed = 0;
+
+    /** Number of sections **/
+    uint32_t sections = 1000;
+
+    /** Number of points of every section, the first one joining its predecessor **/
+    uint32_t pointsPerSection = 4;
+
+    /** Standard deviation of each coordinate of the steps between consecutive points **/
+    floatType stepDeviation = 2;
+
+    /**
+       Each section starts at the last point of one of the `window` sections before it: small
+       windows give long and thin networks, large ones compact networks
+    **/
+    uint32_t window = 1000;
+
+    /** Probability for a section to get a second predecessor, closing a loop **/
+    floatType loopRate = floatType{1} / 10;
+};
+
+/**
+   A vascular network: a random tree where each section continues an earlier one, plus
+   connections closing loops. Section types are random.
+
+   @throw SectionBuilderError if pointsPerSection or window is 0
+**/
+vasculature::mut::Vasculature vasculature(const VasculatureParameters& parameters);
+
+}  // namespace synthetic
+}  // namespace morphio
@@ -1,9 +1,15 @@
+#pragma once
+
 #include <morphio/types.h>
 
 namespace morphio {
 
 /**
    Perform a diff on 2 morphologies, returns True if items differ
+
+   Morphologies are equal when their structures (cell family, soma type, section ids, types and
+   parents) are the same, and their points, diameters and perimeters are within epsilon.
+   Structures are compared first, with Morphology::contentHash
 **/
 bool diff(const Morphology& left,
           const Morphology& right,
@@ -18,6 +18,8 @@ class EndoplasmicReticulum;
 class MitoSection;
 class Mitochondria;
 class Morphology;
+class MorphologyCache;
+class MorphologyStore;
 class Section;
 template <class T>
 class SectionBase;
@@ -1,30 +1,92 @@
+#pragma once
 
 #include <iterator>
-#include <set>
-#include <stack>
+#include <memory>
+#include <vector>
+
+#include <morphio/vasc/properties.h>
 
 namespace morphio {
 namespace vasculature {
 
+/**
+   Depth first traversal of the section ids of a vasculature, following both the predecessors
+   and the successors of each section.
+
+   Sections are marked in a bitset when they are pushed on the stack, so that each one comes
+   exactly once. The neighbors of a section are visited in order: predecessors first, then
+   successors.
+**/
+class DepthFirstTraversal
+{
+  public:
+    DepthFirstTraversal() = default;
+
+    /** Start from all the sections without predecessors, the last one first **/
+    explicit DepthFirstTraversal(const property::Properties& properties);
+
+    /** Start from a single section **/
+    DepthFirstTraversal(const property::Properties& properties, uint32_t start);
+
+    inline bool done() const noexcept;
+
+    /** The id of the current section; undefined once done() **/
+    inline uint32_t current() const noexcept;
+
+    /** Number of sections discovered but not visited yet, the current one included **/
+    inline size_t pending() const noexcept;
+
+    /** Move to the next section **/
+    void advance();
+
+    /** Equal when both are done, or when they have the same stack and visited sections **/
+    inline bool operator==(const DepthFirstTraversal& other) const;
+
+  private:
+    const property::Properties* _properties = nullptr;
+    std::vector<bool> _visited;
+    std::vector<uint32_t> _stack;
+};
+
+inline bool DepthFirstTraversal::done() const noexcept {
+    return _stack.empty();
+}
+
+inline uint32_t DepthFirstTraversal::current() const noexcept {
+    return _stack.back();
+}
+
+inline size_t DepthFirstTraversal::pending() const noexcept {
+    return _stack.size();
+}
+
+inline bool DepthFirstTraversal::operator==(const DepthFirstTraversal& other) const {
+    if (done() || other.done()) {
+        return done() && other.done();
+    }
+    return _stack == other._stack && _visited == other._visited;
+}
+
+/** Iterator adapter over DepthFirstTraversal, yielding SectionT objects **/
 template <typename SectionT, typename VasculatureT>
 class graph_iterator_t
 {
-    std::set<SectionT> visited;
-    std::stack<SectionT> container;
+    std::shared_ptr<property::Properties> _properties;
+    DepthFirstTraversal _traversal;
 
   public:
     using iterator_category = std::input_iterator_tag;
     using value_type = SectionT;
     using difference_type = std::ptrdiff_t;
     using pointer = SectionT*;
-    using reference = SectionT&;
+    using reference = SectionT;
     graph_iterator_t() = default;
     inline explicit graph_iterator_t(const SectionT& vasculatureSection);
     inline explicit graph_iterator_t(const VasculatureT& vasculatureMorphology);
 
     inline bool operator==(const graph_iterator_t& other) const;
     inline bool operator!=(const graph_iterator_t& other) const;
-    inline const SectionT& operator*() const;
+    inline SectionT operator*() const;
 
     inline graph_iterator_t& operator++();
     inline graph_iterator_t operator++(int);
@@ -32,26 +94,20 @@ class graph_iterator_t
 
 template <typename SectionT, typename VasculatureT>
 inline graph_iterator_t<SectionT, VasculatureT>::graph_iterator_t(
-    const SectionT& vasculatureSection) {
-    container.push(vasculatureSection);
-}
+    const SectionT& vasculatureSection)
+    : _properties(vasculatureSection._properties)
+    , _traversal(*_properties, vasculatureSection.id()) {}
 
 template <typename SectionT, typename VasculatureT>
 inline graph_iterator_t<SectionT, VasculatureT>::graph_iterator_t(
-    const VasculatureT& vasculatureMorphology) {
-    const auto& sections = vasculatureMorphology.sections();
-    for (std::size_t i = 0; i < sections.size(); ++i) {
-        if (sections[i].predecessors().empty()) {
-            container.push(sections[i]);
-            visited.insert(sections[i]);
-        }
-    }
-}
+    const VasculatureT& vasculatureMorphology)
+    : _properties(vasculatureMorphology._properties)
+    , _traversal(*_properties) {}
 
 template <typename SectionT, typename VasculatureT>
 inline bool graph_iterator_t<SectionT, VasculatureT>::operator==(
     const graph_iterator_t& other) const {
-    return container == other.container;
+    return _traversal == other._traversal;
 }
 
 template <typename SectionT, typename VasculatureT>
@@ -61,21 +117,14 @@ inline bool graph_iterator_t<SectionT, VasculatureT>::operator!=(
 }
 
 template <typename SectionT, typename VasculatureT>
-inline const SectionT& graph_iterator_t<SectionT, VasculatureT>::operator*() const {
-    return container.top();
+inline SectionT graph_iterator_t<SectionT, VasculatureT>::operator*() const {
+    return SectionT(_traversal.current(), _properties);
 }
 
 template <typename SectionT, typename VasculatureT>
 inline graph_iterator_t<SectionT, VasculatureT>&
 graph_iterator_t<SectionT, VasculatureT>::operator++() {
-    const auto& section = *(*this);
-    container.pop();
-    const auto& neighbors = section.neighbors();
-    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it)
-        if (visited.find(*it) == visited.end()) {
-            container.push(*it);
-            visited.insert(*it);
-        }
+    _traversal.advance();
     return *this;
 }
 
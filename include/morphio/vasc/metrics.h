@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>  // uint32_t
+#include <vector>   // std::vector
+
+#include <morphio/types.h>
+#include <morphio/vasc/properties.h>
+
+/**
+   Whole-graph metrics of a vasculature, computed on the flat arrays of property::Properties.
+
+   Segment i of a section joins its points i and i + 1; each segment is the frustum between
+   the two radii. Segment values are stored section after section: the segments of section s
+   are [segmentOffsets[s], segmentOffsets[s + 1]).
+
+   The work is split over nThreads threads, 0 picks the number of threads from the size of the
+   vasculature and the hardware.
+**/
+namespace morphio {
+namespace vasculature {
+namespace metrics {
+
+/** The first segment of every section, followed by the number of segments **/
+std::vector<uint32_t> segmentOffsets(const property::Properties& properties);
+
+/** Length of every segment **/
+std::vector<floatType> segmentLengths(const property::Properties& properties,
+                                      unsigned int nThreads = 0);
+
+/** Volume of every segment frustum **/
+std::vector<floatType> segmentVolumes(const property::Properties& properties,
+                                      unsigned int nThreads = 0);
+
+/** Lateral area of every segment frustum, the end disks excluded **/
+std::vector<floatType> segmentLateralAreas(const property::Properties& properties,
+                                           unsigned int nThreads = 0);
+
+/** Path length of every section: the sum of the lengths of its segments **/
+std::vector<floatType> sectionLengths(const property::Properties& properties,
+                                      unsigned int nThreads = 0);
+
+/** Volume of every section: the sum of the volumes of its segments **/
+std::vector<floatType> sectionVolumes(const property::Properties& properties,
+                                      unsigned int nThreads = 0);
+
+/** Lateral area of every section: the sum of the lateral areas of its segments **/
+std::vector<floatType> sectionLateralAreas(const property::Properties& properties,
+                                           unsigned int nThreads = 0);
+
+/**
+   Mean diameter of every section, weighted by the segment lengths
+
+   Sections without length get the plain mean of their diameters
+**/
+std::vector<floatType> sectionMeanDiameters(const property::Properties& properties,
+                                            unsigned int nThreads = 0);
+
+/**
+   Number of predecessors plus number of successors of every section, from the connectivity
+
+   @throw RawDataError if a connection refers to a missing section
+**/
+std::vector<uint32_t> degrees(const property::Properties& properties);
+
+/**
+   The vessel graph, ready to assemble a flow matrix: every section is an edge between two
+   nodes, its first and its last point. The connection (a, b) merges the last point of a with
+   the first point of b into a single node.
+
+   Edge i is section i. Nodes are numbered from 0, in the order they are met when going
+   through the sections start then end.
+**/
+struct VesselGraph {
+    uint32_t nodeCount = 0;
+    std::vector<uint32_t> sources;
+    std::vector<uint32_t> targets;
+    /** See sectionLengths **/
+    std::vector<floatType> lengths;
+    /** See sectionMeanDiameters **/
+    std::vector<floatType> diameters;
+};
+
+/**
+   Build the vessel graph of the sections
+
+   @throw RawDataError if a connection refers to a missing section
+**/
+VesselGraph vesselGraph(const property::Properties& properties, unsigned int nThreads = 0);
+
+}  // namespace metrics
+}  // namespace vasculature
+}  // namespace morphio
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <morphio/types.h>
+#include <morphio/vasc/properties.h>
+
+namespace morphio {
+namespace vasculature {
+namespace mut {
+
+/**
+   A vasculature that can be edited. Like the read-only one, it is stored as flat arrays:
+   sections are consecutive ranges of points, numbered from 0, and the graph is a list of
+   connections.
+
+   Sections are added and deleted in bulk, in time linear in the size of the vasculature.
+**/
+class Vasculature
+{
+  public:
+    Vasculature() = default;
+
+    /** Load a vasculature file, see vasculature::Vasculature **/
+    explicit Vasculature(const std::string& source);
+
+    /** Copy a read-only vasculature **/
+    explicit Vasculature(const vasculature::Vasculature& vasculature);
+
+    /** Number of sections **/
+    inline size_t sectionCount() const noexcept;
+
+    /** All the points, section after section **/
+    inline const Points& points() const noexcept;
+
+    /** All the diameters, section after section **/
+    inline const std::vector<morphio::floatType>& diameters() const noexcept;
+
+    /** The type of every section **/
+    inline const std::vector<VascularSectionType>& sectionTypes() const noexcept;
+
+    /** The first point of every section, followed by the number of points **/
+    std::vector<uint32_t> sectionOffsets() const;
+
+    /** The connections, as (from, to) section IDs **/
+    inline const std::vector<property::Connection::Type>& connectivity() const noexcept;
+
+    /** @{
+       The points and diameters of a section, which can be edited in place
+
+       @throw SectionBuilderError if the id is out of range
+    **/
+    range<Point> sectionPoints(uint32_t id);
+    range<const Point> sectionPoints(uint32_t id) const;
+    range<morphio::floatType> sectionDiameters(uint32_t id);
+    range<const morphio::floatType> sectionDiameters(uint32_t id) const;
+    /** @} */
+
+    /**
+       Append sections in one go and return the ID of the first of them
+
+       points and diameters are those of all the new sections; pointOffsets[i] is the first
+       point of the i-th new section, which ends where the next one starts. The new sections
+       get consecutive IDs from the returned one: connectivity uses these final IDs and may
+       refer to any section.
+
+       Nothing is appended if an argument is invalid.
+       @throw SectionBuilderError on mismatched sizes, empty sections, unknown section types or
+       connections to sections that do not exist
+    **/
+    uint32_t appendSections(const Points& points,
+                            const std::vector<morphio::floatType>& diameters,
+                            const std::vector<uint32_t>& pointOffsets,
+                            const std::vector<VascularSectionType>& types,
+                            const std::vector<property::Connection::Type>& connectivity = {});
+
+    /**
+       Append connections between existing sections
+
+       @throw SectionBuilderError if a connection refers to a section that does not exist
+    **/
+    void appendConnections(const std::vector<property::Connection::Type>& connectivity);
+
+    /**
+       Delete the sections, their points and every connection to them
+
+       The other sections keep their order and are renumbered from 0.
+       @throw SectionBuilderError if an id is out of range
+    **/
+    void deleteSections(const std::vector<uint32_t>& sectionIds);
+
+    /** @{
+       Return the data structure used to create read-only vasculatures
+
+       The rvalue overload moves the arrays out of the vasculature, which is left empty
+    **/
+    property::Properties buildReadOnly() const&;
+    property::Properties buildReadOnly() &&;
+    /** @} */
+
+    /** Return the estimated memory held by the vasculature, by component **/
+    MemoryUsage memoryUsage() const;
+
+    /** Release the unused capacity of the arrays, e.g. after deleting sections **/
+    void shrinkToFit();
+
+    /**
+       Write the vasculature to an HDF5 file, with the /points, /structure and /connectivity
+       datasets vasculature::Vasculature reads
+
+       @throw UnknownFileType if the extension is not .h5
+    **/
+    void write(const std::string& filename) const;
+
+  private:
+    void _checkConnections(const std::vector<property::Connection::Type>& connectivity,
+                           size_t nSections) const;
+
+    property::Properties _properties;
+};
+
+inline size_t Vasculature::sectionCount() const noexcept {
+    return _properties._sectionLevel._sections.size();
+}
+
+inline const Points& Vasculature::points() const noexcept {
+    return _properties._pointLevel._points;
+}
+
+inline const std::vector<morphio::floatType>& Vasculature::diameters() const noexcept {
+    return _properties._pointLevel._diameters;
+}
+
+inline const std::vector<VascularSectionType>& Vasculature::sectionTypes() const noexcept {
+    return _properties._sectionLevel._sectionTypes;
+}
+
+inline const std::vector<property::Connection::Type>& Vasculature::connectivity() const noexcept {
+    return _properties._connectivity;
+}
+
+}  // namespace mut
+}  // namespace vasculature
+}  // namespace morphio
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>  // std::string
+
+#include <morphio/vasc/mut/vasculature.h>
+
+namespace morphio {
+namespace vasculature {
+namespace mut {
+namespace writer {
+/** Write the /points, /structure and /connectivity datasets read by VasculatureHDF5 **/
+void h5(const Vasculature& vasculature, const std::string& filename);
+}  // namespace writer
+}  // namespace mut
+}  // namespace vasculature
+}  // namespace morphio
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <morphio/memory_usage.h>
 #include <morphio/types.h>
 #include <string>  // std::string
 #include <vector>  // std::vector
@@ -42,8 +42,10 @@ struct VascPointLevel {
     VascPointLevel(const std::vector<Point::Type>& points,
                    const std::vector<Diameter::Type>& diameters);
     VascPointLevel(const VascPointLevel& data);
+    VascPointLevel(VascPointLevel&&) noexcept = default;
     VascPointLevel(const VascPointLevel& data, SectionRange range);
     VascPointLevel& operator=(const VascPointLevel&) = default;
+    VascPointLevel& operator=(VascPointLevel&&) noexcept = default;
 };
 
 struct VascEdgeLevel {
@@ -55,8 +57,13 @@ struct VascSectionLevel {
     // stores section level information
     std::vector<VascSection::Type> _sections;
     std::vector<SectionType::Type> _sectionTypes;
-    std::map<uint32_t, std::vector<uint32_t>> _predecessors;
-    std::map<uint32_t, std::vector<uint32_t>> _successors;
+    // The graph connectivity in compressed sparse row layout: the predecessors of section i are
+    // _predecessors[_predecessorOffsets[i], _predecessorOffsets[i + 1]), in the order of the
+    // connections. The offsets have one entry per section plus one, same for the successors
+    std::vector<uint32_t> _predecessorOffsets;
+    std::vector<uint32_t> _predecessors;
+    std::vector<uint32_t> _successorOffsets;
+    std::vector<uint32_t> _successors;
     bool operator==(const VascSectionLevel& other) const;
     bool operator!=(const VascSectionLevel& other) const;
 };
@@ -73,18 +80,38 @@ struct Properties {
     template <typename T>
     const std::vector<typename T::Type>& get() const noexcept;
 
-    inline const std::map<uint32_t, std::vector<uint32_t>>& predecessors() const noexcept;
-    inline const std::map<uint32_t, std::vector<uint32_t>>& successors() const noexcept;
+    /** The ids of the predecessors of a section, see VascSectionLevel **/
+    inline range<const uint32_t> predecessors(uint32_t sectionId) const noexcept;
+    /** The ids of the successors of a section, see VascSectionLevel **/
+    inline range<const uint32_t> successors(uint32_t sectionId) const noexcept;
 
     bool operator==(const Properties& other) const;
     bool operator!=(const Properties& other) const;
+
+    /** Estimated heap memory of the containers of these properties, see MemoryUsage **/
+    MemoryUsage memoryUsage() const;
+    /** Release the unused capacity of the vectors **/
+    void shrinkToFit();
 };
 
-inline const std::map<uint32_t, std::vector<uint32_t>>& Properties::predecessors() const noexcept {
-    return _sectionLevel._predecessors;
+namespace detail {
+inline range<const uint32_t> adjacent(const std::vector<uint32_t>& offsets,
+                                      const std::vector<uint32_t>& ids,
+                                      uint32_t sectionId) noexcept {
+    if (sectionId + 1 >= offsets.size()) {
+        return {};
+    }
+    return {ids.data() + offsets[sectionId], offsets[sectionId + 1] - offsets[sectionId]};
+}
+}  // namespace detail
+
+inline range<const uint32_t> Properties::predecessors(uint32_t sectionId) const noexcept {
+    return detail::adjacent(_sectionLevel._predecessorOffsets,
+                            _sectionLevel._predecessors,
+                            sectionId);
 }
-inline const std::map<uint32_t, std::vector<uint32_t>>& Properties::successors() const noexcept {
-    return _sectionLevel._successors;
+inline range<const uint32_t> Properties::successors(uint32_t sectionId) const noexcept {
+    return detail::adjacent(_sectionLevel._successorOffsets, _sectionLevel._successors, sectionId);
 }
 
 std::ostream& operator<<(std::ostream& os, const Properties& properties);
@@ -39,11 +39,23 @@ class Section
     **/
     std::vector<Section> neighbors() const;
 
+    /**
+       Return the IDs of the predecessors of the section, without building Section objects
+    **/
+    range<const uint32_t> predecessorIds() const noexcept;
+
+    /**
+       Return the IDs of the successors of the section, without building Section objects
+    **/
+    range<const uint32_t> successorIds() const noexcept;
+
     /** Return the ID of this section. */
     uint32_t id() const noexcept;
 
     /**
        Euclidian distance between first and last point of the section
+
+       See metrics::sectionLengths for the path length along the points
     **/
     floatType length() const;
 
@@ -70,6 +82,9 @@ class Section
     VascularSectionType type() const;
 
   protected:
+    template <typename, typename>
+    friend class graph_iterator_t;
+
     template <typename Property>
     range<const typename Property::Type> get() const;
 
@@ -13,6 +13,10 @@ namespace vasculature {
 
 using graph_iterator = graph_iterator_t<Section, Vasculature>;
 
+namespace mut {
+class Vasculature;
+}  // namespace mut
+
 class Vasculature
 {
   public:
@@ -21,6 +25,34 @@ class Vasculature
      */
     explicit Vasculature(const std::string& source);
 
+    /**
+       Load only the sections [firstSection, lastSection) of the given source, renumbered from 0,
+       and the connections between them. The rest of the points is not read.
+
+       @throw RawDataError if the range is not within the sections of the file
+    **/
+    Vasculature(const std::string& source, uint32_t firstSection, uint32_t lastSection);
+
+    /**
+       Load only the sections of the given source intersecting the region, and the connections
+       between them. A section intersects the region if the bounding box of one of its
+       segments, radii included, does. Sections are renumbered from 0, in file order.
+
+       The file is streamed: memory is proportional to the region, not to the file.
+    **/
+    Vasculature(const std::string& source, const BoundingBox& region);
+
+    /**
+       Build a vasculature from data already in memory, generated or read by other means
+
+       The predecessors and successors are built from the connectivity
+       @throw RawDataError if a connection refers to a section that does not exist
+    **/
+    explicit Vasculature(property::Properties properties);
+
+    /** Build a read-only vasculature from a mutable one **/
+    explicit Vasculature(const mut::Vasculature& vasculature);
+
     Vasculature(Vasculature&&) = default;
     virtual ~Vasculature() = default;
 
@@ -39,11 +71,28 @@ class Vasculature
      */
     Section section(const uint32_t& id) const;
 
+    /**
+     * Return the vasculature made of the given sections and the connections between them.
+     * The section sectionIds[i] becomes the section i.
+     *
+     * @throw RawDataError if an ID is out of range or repeated
+     **/
+    Vasculature subgraph(const std::vector<uint32_t>& sectionIds) const;
+
     /**
      * Return a vector with all points from all sections
      **/
     inline const Points& points() const noexcept;
 
+    /**
+     * Returns a list with offsets to access data of a specific section in the points
+     * and diameters arrays.
+     *
+     * Note: for convenience, the last point of this array is the points() array size
+     * so that data of the n'th section lies in [sectionOffsets(n), sectionOffsets(n+1))
+     **/
+    std::vector<uint32_t> sectionOffsets() const;
+
     /**
      * Return a vector with all diameters from all sections
      **/
@@ -54,13 +103,46 @@ class Vasculature
      **/
     inline const std::vector<property::SectionType::Type>& sectionTypes() const noexcept;
 
+    /**
+     * Return the flat arrays backing the vasculature, for the metrics of vasc/metrics.h
+     **/
+    inline const property::Properties& properties() const noexcept;
+
     /**
      * graph iterators
      **/
     graph_iterator begin() const;
     graph_iterator end() const;
 
+    /**
+     * Return the section IDs in the order of the graph iterator: depth first, starting from the
+     * sections without predecessors, the last one first
+     **/
+    std::vector<uint32_t> depthFirstOrder() const;
+
+    /**
+     * Return the section IDs breadth first, starting from the sections without predecessors in
+     * increasing ID order. Neighbors come predecessors first, then successors
+     **/
+    std::vector<uint32_t> breadthFirstOrder() const;
+
+    /**
+     * Return the connected component of every section, the direction of the connections being
+     * ignored. Components are numbered from 0, in the order of their smallest section ID
+     **/
+    std::vector<uint32_t> connectedComponents() const;
+
+    /**
+     * Return the estimated memory held by the vasculature, by component. Copies of a
+     * Vasculature share it
+     **/
+    MemoryUsage memoryUsage() const;
+
   private:
+    template <typename, typename>
+    friend class graph_iterator_t;
+    friend class mut::Vasculature;
+
     std::shared_ptr<property::Properties> _properties;
 
     template <typename Property>
@@ -72,6 +154,10 @@ inline const std::vector<typename Property::Type>& Vasculature::get() const noex
     return _properties->get<Property>();
 }
 
+inline const property::Properties& Vasculature::properties() const noexcept {
+    return *_properties;
+}
+
 inline const Points& Vasculature::points() const noexcept {
     return get<property::Point>();
 }
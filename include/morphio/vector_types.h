@@ -18,8 +18,14 @@ constexpr floatType epsilon = 1e-6f;
 constexpr floatType PI = static_cast<floatType>(M_PI);
 #endif
 
-using Point = std::array<morphio::floatType, 3>;
-using Points = std::vector<Point>;
+/** A point of a given precision: float and double are both available, whatever floatType is **/
+template <typename T>
+using PointT = std::array<T, 3>;
+template <typename T>
+using PointsT = std::vector<PointT<T>>;
+
+using Point = PointT<floatType>;
+using Points = PointsT<floatType>;
 
 Point operator+(const Point& left, const Point& right);
 Point operator-(const Point& left, const Point& right);
@@ -39,12 +45,32 @@ Point operator*(T factor, const Point& from);
 template <typename T>
 Point operator/(const Point& from, T factor);
 template <typename T>
-Point centerOfGravity(const T& points);
+typename T::value_type centerOfGravity(const T& points);
 template <typename T>
-floatType maxDistanceToCenterOfGravity(const T& points);
+typename T::value_type::value_type maxDistanceToCenterOfGravity(const T& points);
+
+extern template PointT<float> centerOfGravity(const PointsT<float>&);
+extern template PointT<double> centerOfGravity(const PointsT<double>&);
+extern template float maxDistanceToCenterOfGravity(const PointsT<float>&);
+extern template double maxDistanceToCenterOfGravity(const PointsT<double>&);
+
+/** An axis aligned box, defined by its lowest and highest corners **/
+struct BoundingBox {
+    Point min;
+    Point max;
 
-extern template Point centerOfGravity(const Points&);
-extern template floatType maxDistanceToCenterOfGravity(const Points&);
+    /** Whether the point lies inside the box (boundaries included) **/
+    bool contains(const Point& point) const noexcept;
+
+    /** Whether the two boxes overlap (touching boxes overlap) **/
+    bool intersects(const BoundingBox& other) const noexcept;
+
+    /** Grow the box so that it contains the point **/
+    void expand(const Point& point) noexcept;
+
+    /** Grow the box so that it contains the other box **/
+    void expand(const BoundingBox& other) noexcept;
+};
 
 std::string dumpPoint(const Point& point);
 std::string dumpPoints(const Points& point);
@@ -55,7 +81,11 @@ char my_tolower(char ch);
 /**
    Euclidian distance between two points
 **/
-floatType distance(const Point& left, const Point& right);
+template <typename T>
+T distance(const PointT<T>& left, const PointT<T>& right);
+
+extern template float distance(const PointT<float>&, const PointT<float>&);
+extern template double distance(const PointT<double>&, const PointT<double>&);
 
 std::ostream& operator<<(std::ostream& os, const morphio::Point& point);
 std::ostream& operator<<(std::ostream& os, const Points& points);
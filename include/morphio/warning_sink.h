@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>       // std::array
+#include <atomic>      // std::atomic
+#include <cstdint>     // uint64_t
+#include <functional>  // std::function
+#include <memory>      // std::shared_ptr
+#include <mutex>       // std::mutex
+#include <string>      // std::string
+#include <utility>     // std::move
+#include <vector>      // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+   A warning and what its message is made of. The message is only formatted by the sinks that
+   need it: not when the warning is ignored, nor once the maximum number of warnings printed on
+   stderr is reached
+**/
+struct WarningMessage {
+    explicit WarningMessage(Warning warning_) noexcept
+        : warning(warning_) {}
+    virtual ~WarningMessage() = default;
+
+    /** Format the message of the warning **/
+    virtual std::string msg() const = 0;
+
+    Warning warning;
+};
+
+/** A section of an immutable morphology or vasculature without points, see BROKEN_SECTION **/
+struct BrokenSectionWarning: public WarningMessage {
+    BrokenSectionWarning(uint32_t sectionId_, SectionRange range_) noexcept
+        : WarningMessage(Warning::BROKEN_SECTION)
+        , sectionId(sectionId_)
+        , range(range_) {}
+    std::string msg() const override;
+
+    uint32_t sectionId;
+    SectionRange range;
+};
+
+/** Raise a warning: unless it is ignored, it goes to the current WarningSink **/
+void printError(Warning warning, const std::string& msg);
+void printError(const WarningMessage& message);
+
+/**
+   Where the warnings raised by MorphIO go.
+
+   emit is called by the thread that raised the warning, once the warning is known not to be
+   ignored. The message is valid during the call only; msg() formats it.
+
+   A sink installed with set_warning_sink receives the warnings of every thread, and must be
+   thread safe. One installed with a ScopedWarningSink only gets those of its thread.
+**/
+class WarningSink
+{
+  public:
+    WarningSink() = default;
+    virtual ~WarningSink();
+    virtual void emit(const WarningMessage& message) = 0;
+
+    /** Whether the sink drops every warning: printError then returns right away **/
+    bool discards() const noexcept {
+        return _discards;
+    }
+
+  protected:
+    explicit WarningSink(bool discards_) noexcept
+        : _discards(discards_) {}
+
+  private:
+    bool _discards = false;
+};
+
+/**
+   Print the warnings on stderr, up to the maximum number set by set_maximum_warnings. The default
+   sink
+**/
+class StderrWarningSink: public WarningSink
+{
+  public:
+    void emit(const WarningMessage& message) override;
+
+  private:
+    std::mutex _mutex;
+    int _printed = 0;
+};
+
+/** Drop the warnings **/
+class NullWarningSink: public WarningSink
+{
+  public:
+    NullWarningSink() noexcept
+        : WarningSink(true) {}
+    void emit(const WarningMessage&) override {}
+};
+
+/** Count the warnings of each type, without formatting them **/
+class CountingWarningSink: public WarningSink
+{
+  public:
+    void emit(const WarningMessage& message) override;
+
+    /** Return the number of warnings of the given type **/
+    uint64_t count(Warning warning) const noexcept;
+    /** Return the number of warnings of all types **/
+    uint64_t total() const noexcept;
+    void clear() noexcept;
+
+  private:
+    std::array<std::atomic<uint64_t>, WARNING_COUNT> _counts{};
+};
+
+/** Keep the warnings, with their formatted message **/
+class CollectingWarningSink: public WarningSink
+{
+  public:
+    struct Record {
+        Warning warning;
+        std::string message;
+    };
+
+    void emit(const WarningMessage& message) override;
+
+    /** Return the warnings received so far, in order **/
+    std::vector<Record> records() const;
+    void clear();
+
+  private:
+    mutable std::mutex _mutex;
+    std::vector<Record> _records;
+};
+
+/** Forward the warnings to a function, which must be thread safe for a global sink **/
+class CallbackWarningSink: public WarningSink
+{
+  public:
+    using Callback = std::function<void(const WarningMessage&)>;
+
+    explicit CallbackWarningSink(Callback callback)
+        : _callback(std::move(callback)) {}
+
+    void emit(const WarningMessage& message) override {
+        _callback(message);
+    }
+
+  private:
+    Callback _callback;
+};
+
+/**
+   Send the warnings of all threads to sink, nullptr restores the default StderrWarningSink.
+   Threads with a ScopedWarningSink keep theirs. A replaced sink is released once the threads
+   emitting to it are done
+**/
+void set_warning_sink(std::shared_ptr<WarningSink> sink);
+
+/**
+   Send the warnings raised by the calling thread to sink, until destroyed.
+
+   Scoped sinks nest like StatsCollector: an inner one takes the warnings until it is destroyed.
+   Other threads are not affected.
+
+   Example:
+       morphio::CollectingWarningSink warnings;
+       {
+           morphio::ScopedWarningSink scope(warnings);
+           morphio::Morphology morphology("neuron.asc");
+       }
+       for (const auto& record : warnings.records()) ...
+**/
+class ScopedWarningSink
+{
+  public:
+    explicit ScopedWarningSink(WarningSink& sink) noexcept;
+    ~ScopedWarningSink();
+
+    ScopedWarningSink(const ScopedWarningSink&) = delete;
+    ScopedWarningSink& operator=(const ScopedWarningSink&) = delete;
+
+  private:
+    WarningSink* _previous;
+};
+
+}  // namespace morphio
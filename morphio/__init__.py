@@ -15,6 +15,8 @@ from ._morphio import (
     MitochondriaPointLevel,
     MorphioError,
     Morphology,
+    MorphologyCache,
+    MorphologyStore,
     MorphologyVersion,
     MultipleTrees,
     Option,
@@ -29,14 +31,19 @@ from ._morphio import (
     Soma,
     SomaError,
     SomaType,
+    SpatialIndex,
+    Stats,
     UnknownFileType,
     VasculatureSectionType,
     Warning,
+    WarningCollector,
     WriterError,
+    load_as,
     mut,
     ostream_redirect,
     set_ignored_warning,
     set_maximum_warnings,
+    stats_enabled,
     vasculature,
     version,
 )
@@ -0,0 +1 @@
+from ..._morphio.vasculature.mut import Vasculature
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>    // std::array
+#include <cmath>    // std::llround
+#include <cstdint>  // uint64_t
+#include <cstring>  // std::memcpy
+#include <vector>   // std::vector
+
+#include <morphio/types.h>
+
+namespace morphio {
+namespace detail {
+
+/**
+   A fast non-cryptographic 64 bit hash of values, mixed one at a time like the lanes of xxHash64.
+
+   Values are hashed, not their bytes: the digest does not depend on the endianness. Floating
+   point values are either hashed exactly, -0 and 0 being the same, or rounded to multiples of a
+   tolerance
+**/
+class ContentHasher
+{
+  public:
+    /** tolerance: round floating point values to its multiples, 0 to hash them exactly **/
+    explicit ContentHasher(floatType tolerance) noexcept
+        : _tolerance(tolerance) {}
+
+    void add(uint64_t value) noexcept {
+        _state ^= _round(value);
+        _state = _rotate(_state, 27) * kPrime1 + kPrime4;
+    }
+
+    void add(int64_t value) noexcept {
+        add(static_cast<uint64_t>(value));
+    }
+
+    void add(uint32_t value) noexcept {
+        add(static_cast<uint64_t>(value));
+    }
+
+    void add(int32_t value) noexcept {
+        add(static_cast<int64_t>(value));
+    }
+
+    void add(float value) noexcept {
+        if (_tolerance > 0) {
+            add(static_cast<int64_t>(std::llround(static_cast<double>(value) / _tolerance)));
+            return;
+        }
+        // Adding 0 turns -0 into 0
+        const float normalized = value + 0.f;
+        uint32_t bits;
+        std::memcpy(&bits, &normalized, sizeof(bits));
+        add(bits);
+    }
+
+    void add(double value) noexcept {
+        if (_tolerance > 0) {
+            add(static_cast<int64_t>(std::llround(value / _tolerance)));
+            return;
+        }
+        const double normalized = value + 0.;
+        uint64_t bits;
+        std::memcpy(&bits, &normalized, sizeof(bits));
+        add(bits);
+    }
+
+    void addSize(size_t size) noexcept {
+        const uint64_t value = size;
+        add(value);
+    }
+
+    template <typename T, size_t N>
+    void add(const std::array<T, N>& values) noexcept {
+        for (const auto& value : values) {
+            add(value);
+        }
+    }
+
+    /** The number of values, then the values: consecutive vectors do not alias **/
+    template <typename T>
+    void add(const std::vector<T>& values) noexcept {
+        addSize(values.size());
+        for (const auto& value : values) {
+            add(value);
+        }
+    }
+
+    void add(SectionType value) noexcept {
+        add(static_cast<int64_t>(value));
+    }
+
+    uint64_t digest() const noexcept {
+        uint64_t hash = _state;
+        hash ^= hash >> 33;
+        hash *= kPrime2;
+        hash ^= hash >> 29;
+        hash *= kPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+  private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+
+    static uint64_t _rotate(uint64_t value, int bits) noexcept {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static uint64_t _round(uint64_t value) noexcept {
+        return _rotate(value * kPrime2, 31) * kPrime1;
+    }
+
+    // In double whatever floatType is, to divide the values of both precisions
+    double _tolerance;
+    uint64_t _state = kPrime4;
+};
+
+}  // namespace detail
+}  // namespace morphio
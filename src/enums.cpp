@@ -17,6 +17,8 @@ std::ostream& operator<<(std::ostream& os, const MorphologyVersion v) {
         return os << "swcv1";
     case MORPHOLOGY_VERSION_ASC_1:
         return os << "ascv1";
+    case MORPHOLOGY_VERSION_BINARY_1:
+        return os << "binaryv1";
     default:
     case MORPHOLOGY_VERSION_UNDEFINED:
         return os << "UNDEFINED";
@@ -3,17 +3,6 @@
 #include <sstream>
 
 namespace morphio {
-static int MORPHIO_MAX_N_WARNINGS = 100;
-
-/**
-   Controls the maximum number of warning to be printed on screen
-   0 will print no warning
-   -1 will print them all
-**/
-void set_maximum_warnings(int n_warnings) {
-    MORPHIO_MAX_N_WARNINGS = n_warnings;
-}
-
 void set_ignored_warning(Warning warning, bool ignore) {
     if (ignore)
         readers::_ignoredWarnings.insert(warning);
@@ -26,25 +15,6 @@ void set_ignored_warning(const std::vector<Warning>& warnings, bool ignore) {
         set_ignored_warning(warning, ignore);
 }
 
-void printError(Warning warning, const std::string& msg) {
-    static int error = 0;
-    if (readers::ErrorMessages::isIgnored(warning) || MORPHIO_MAX_N_WARNINGS == 0)
-        return;
-
-    if (MORPHIO_MAX_N_WARNINGS < 0 || error <= MORPHIO_MAX_N_WARNINGS) {
-        std::cerr << msg << '\n';
-        if (error == MORPHIO_MAX_N_WARNINGS) {
-            std::cerr << "Maximum number of warning reached. Next warnings "
-                         "won't be displayed.\n"
-                         "You can change this number by calling:\n"
-                         "\t- C++: set_maximum_warnings(int)\n"
-                         "\t- Python: morphio.set_maximum_warnings(int)\n"
-                         "0 will print no warning. -1 will print them all\n";
-        }
-        ++error;
-    }
-}
-
 namespace readers {
 bool ErrorMessages::isIgnored(Warning warning) {
     return _ignoredWarnings.find(warning) != _ignoredWarnings.end();
@@ -196,7 +166,8 @@ std::string ErrorMessages::ERROR_UNCOMPATIBLE_FLAGS(morphio::Option flag1,
 ////////////////////////////////////////////////////////////////////////////////
 
 std::string ErrorMessages::ERROR_WRONG_EXTENSION(const std::string& filename) const {
-    return "Filename: " + filename + " must have one of the following extensions: swc, asc or h5";
+    return "Filename: " + filename +
+           " must have one of the following extensions: swc, asc, h5 or mbin";
 }
 
 std::string ErrorMessages::ERROR_VECTOR_LENGTH_MISMATCH(const std::string& vec1,
@@ -241,7 +212,7 @@ std::string ErrorMessages::WARNING_DISCONNECTED_NEURITE(const Sample& sample) co
 }
 
 std::string ErrorMessages::WARNING_APPENDING_EMPTY_SECTION(
-    std::shared_ptr<morphio::mut::Section> section) {
+    const std::shared_ptr<morphio::mut::Section>& section) const {
     return errorMsg(0,
                     ErrorLevel::WARNING,
                     "Warning: appending empty section with id: " + std::to_string(section->id()));
@@ -304,7 +275,7 @@ std::string ErrorMessages::WARNING_ONLY_CHILD(const DebugInfo& info,
 
 std::string ErrorMessages::WARNING_NEUROMORPHO_SOMA_NON_CONFORM(const Sample& root,
                                                                 const Sample& child1,
-                                                                const Sample& child2) {
+                                                                const Sample& child2) const {
     floatType x = root.point[0], y = root.point[1], z = root.point[2], r = root.diameter / 2;
     std::stringstream ss;
     ss << "Warning: the soma does not conform the three point soma spec\n"
@@ -344,6 +315,26 @@ std::string ErrorMessages::WARNING_WRONG_ROOT_POINT(const std::vector<Sample>& c
     return oss.str();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//              LAZY WARNINGS
+////////////////////////////////////////////////////////////////////////////////
+
+std::string DisconnectedNeuriteWarning::msg() const {
+    return err.WARNING_DISCONNECTED_NEURITE(sample);
+}
+
+std::string WrongDuplicateWarning::msg() const {
+    return err.WARNING_WRONG_DUPLICATE(current, parent);
+}
+
+std::string AppendingEmptySectionWarning::msg() const {
+    return err.WARNING_APPENDING_EMPTY_SECTION(section);
+}
+
+std::string OnlyChildWarning::msg() const {
+    return err.WARNING_ONLY_CHILD(info, parentId, childId);
+}
+
 }  // namespace readers
 
 }  // namespace morphio
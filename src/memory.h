@@ -0,0 +1,105 @@
+#pragma once
+
+#include <map>     // std::map
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <morphio/memory_usage.h>
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace detail {
+
+/** Bookkeeping of the allocator for each heap block: a size header and the rounding to 16 bytes **/
+constexpr size_t kAllocationOverhead = 2 * sizeof(void*);
+
+/** A shared_ptr made with make_shared: the object and the counts of its control block **/
+template <typename T>
+constexpr size_t sharedObjectBytes() {
+    return sizeof(T) + 2 * sizeof(void*);
+}
+
+/**
+   Measure containers for a MemoryUsage: each method returns the bytes held by a container, to be
+   added to the component it belongs to, and records its allocator overhead and unused capacity
+**/
+class MemoryCounter
+{
+  public:
+    explicit MemoryCounter(MemoryUsage& usage) noexcept
+        : _usage(usage) {}
+
+    /** A heap block of the given size, none if it is empty **/
+    size_t block(size_t bytes) noexcept {
+        if (bytes > 0) {
+            _usage.allocatorOverhead += kAllocationOverhead;
+        }
+        return bytes;
+    }
+
+    template <typename T>
+    size_t vector(const std::vector<T>& values) noexcept {
+        _usage.unused += (values.capacity() - values.size()) * sizeof(T);
+        return block(values.capacity() * sizeof(T));
+    }
+
+    size_t string(const std::string& value) noexcept {
+        // Short strings are stored in the string object itself
+        static const size_t shortCapacity = std::string().capacity();
+        return value.capacity() > shortCapacity ? block(value.capacity() + 1) : 0;
+    }
+
+    /** The nodes of a map, without the memory of the values **/
+    template <typename K, typename V>
+    size_t mapNodes(const std::map<K, V>& map) noexcept {
+        // A red-black tree node holds the value, its color and 3 pointers
+        const size_t nodeBytes = sizeof(typename std::map<K, V>::value_type) + 4 * sizeof(void*);
+        _usage.allocatorOverhead += map.size() * kAllocationOverhead;
+        return map.size() * nodeBytes;
+    }
+
+    size_t children(const std::map<int, std::vector<unsigned int>>& children) noexcept {
+        size_t bytes = mapNodes(children);
+        for (const auto& kv : children) {
+            bytes += vector(kv.second);
+        }
+        return bytes;
+    }
+
+    size_t pointLevel(const Property::PointLevel& level) noexcept {
+        return vector(level._points) + vector(level._diameters) + vector(level._perimeters);
+    }
+
+    size_t annotations(const std::vector<Property::Annotation>& annotations) noexcept {
+        size_t bytes = vector(annotations);
+        for (const auto& annotation : annotations) {
+            bytes += pointLevel(annotation._points) + string(annotation._details);
+        }
+        return bytes;
+    }
+
+  private:
+    MemoryUsage& _usage;
+};
+
+inline void shrinkToFit(Property::PointLevel& level) {
+    level._points.shrink_to_fit();
+    level._diameters.shrink_to_fit();
+    level._perimeters.shrink_to_fit();
+}
+
+inline void shrinkToFit(std::map<int, std::vector<unsigned int>>& children) {
+    for (auto& kv : children) {
+        kv.second.shrink_to_fit();
+    }
+}
+
+inline void shrinkToFit(std::vector<Property::Annotation>& annotations) {
+    annotations.shrink_to_fit();
+    for (auto& annotation : annotations) {
+        shrinkToFit(annotation._points);
+    }
+}
+
+}  // namespace detail
+}  // namespace morphio
@@ -0,0 +1,329 @@
+#include <algorithm>  // std::stable_sort
+#include <cmath>      // std::sqrt, std::pow
+#include <numeric>    // std::iota
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+#include "modifiers.h"
+#include "parallel.h"
+#include "stats.h"
+
+namespace morphio {
+namespace modifiers {
+namespace {
+
+unsigned int threadCount(size_t nPoints, unsigned int nThreads) {
+    return detail::threadCount(nPoints, detail::kMinPointsPerThread, nThreads);
+}
+
+/** The [begin, end) point range of each section, plus the number of points at the end **/
+std::vector<size_t> sectionOffsets(const std::vector<Property::Section::Type>& sections,
+                                   size_t nPoints) {
+    std::vector<size_t> offsets(sections.size() + 1, nPoints);
+    for (size_t i = 0; i < sections.size(); ++i) {
+        offsets[i] = static_cast<size_t>(sections[i][0]);
+    }
+    return offsets;
+}
+
+/** Copy values[begin, end) of each block to output, one block after the other **/
+template <typename T>
+void gather(const std::vector<T>& values,
+            const std::vector<std::pair<size_t, size_t>>& blocks,
+            const std::vector<size_t>& outputOffsets,
+            std::vector<T>& output,
+            unsigned int nThreads) {
+    detail::parallelFor(blocks.size(), nThreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::copy(values.begin() + static_cast<std::ptrdiff_t>(blocks[i].first),
+                      values.begin() + static_cast<std::ptrdiff_t>(blocks[i].second),
+                      output.begin() + static_cast<std::ptrdiff_t>(outputOffsets[i]));
+        }
+    });
+}
+
+}  // anonymous namespace
+
+template <typename Geometry>
+void apply(Geometry& geometry, unsigned int options, unsigned int nThreads) {
+    if ((options & (SOMA_SPHERE | NO_DUPLICATES | TWO_POINTS_SECTIONS | NRN_ORDER)) == 0) {
+        return;
+    }
+    const detail::PhaseTimer timer(Stats::MODIFIERS);
+    if (options & SOMA_SPHERE) {
+        somaSphere(geometry);
+    }
+    if (options & (NO_DUPLICATES | TWO_POINTS_SECTIONS)) {
+        compactPoints(geometry,
+                      (options & NO_DUPLICATES) != 0,
+                      (options & TWO_POINTS_SECTIONS) != 0,
+                      nThreads);
+    }
+    if (options & NRN_ORDER) {
+        nrnOrder(geometry, nThreads);
+    }
+}
+
+template <typename Geometry>
+void somaSphere(Geometry& geometry) {
+    somaSphere(geometry._somaLevel._points, geometry._somaLevel._diameters);
+}
+
+template <typename T>
+void somaSphere(std::vector<PointT<T>>& points, std::vector<T>& diameters) {
+    T size = static_cast<T>(points.size());
+
+    if (size < 2)
+        return;
+
+    T x = 0, y = 0, z = 0, r = 0;
+    for (const PointT<T>& point : points) {
+        x += point[0] / size;
+        y += point[1] / size;
+        z += point[2] / size;
+    }
+
+    // The float overloads of std::sqrt and std::pow are sqrtf and powf
+    const T two = 2;
+    for (const PointT<T>& point : points) {
+        r += std::sqrt(std::pow(point[0] - x, two) + std::pow(point[1] - y, two) +
+                       std::pow(point[2] - z, two)) /
+             size;
+    }
+
+    points = {{x, y, z}};
+    diameters = {r};
+}
+
+template <typename Geometry>
+void compactPoints(Geometry& geometry, bool noDuplicates, bool twoPoints, unsigned int nThreads) {
+    auto& sections = geometry._sectionLevel._sections;
+    auto& pointLevel = geometry._pointLevel;
+    const size_t nSections = sections.size();
+    const std::vector<size_t> offsets = sectionOffsets(sections, pointLevel._points.size());
+
+    // The points kept by each section: [first, last) or, for two points sections, first and
+    // last - 1
+    std::vector<std::pair<size_t, size_t>> kept(nSections);
+    std::vector<size_t> newOffsets(nSections + 1, 0);
+    for (size_t i = 0; i < nSections; ++i) {
+        size_t first = offsets[i];
+        const size_t last = offsets[i + 1];
+        if (noDuplicates && sections[i][1] != -1 && last > first) {
+            ++first;
+        }
+        kept[i] = {first, last};
+        const size_t size = last - first;
+        newOffsets[i + 1] = newOffsets[i] + (twoPoints && size >= 2 ? 2 : size);
+    }
+
+    const size_t nPoints = newOffsets[nSections];
+    if (nPoints == pointLevel._points.size()) {
+        return;
+    }
+    nThreads = threadCount(pointLevel._points.size(), nThreads);
+
+    // Two points sections are gathered as two one point blocks
+    std::vector<std::pair<size_t, size_t>> blocks;
+    std::vector<size_t> blockOffsets;
+    blocks.reserve(2 * nSections);
+    blockOffsets.reserve(2 * nSections);
+    for (size_t i = 0; i < nSections; ++i) {
+        const size_t first = kept[i].first;
+        const size_t last = kept[i].second;
+        if (twoPoints && last - first >= 2) {
+            blocks.emplace_back(first, first + 1);
+            blockOffsets.push_back(newOffsets[i]);
+            blocks.emplace_back(last - 1, last);
+            blockOffsets.push_back(newOffsets[i] + 1);
+        } else {
+            blocks.emplace_back(first, last);
+            blockOffsets.push_back(newOffsets[i]);
+        }
+        sections[i][0] = static_cast<int>(newOffsets[i]);
+    }
+
+    decltype(Geometry::_pointLevel) compacted;
+    compacted._points.resize(nPoints);
+    compacted._diameters.resize(nPoints);
+    gather(pointLevel._points, blocks, blockOffsets, compacted._points, nThreads);
+    gather(pointLevel._diameters, blocks, blockOffsets, compacted._diameters, nThreads);
+    if (!pointLevel._perimeters.empty()) {
+        compacted._perimeters.resize(nPoints);
+        gather(pointLevel._perimeters, blocks, blockOffsets, compacted._perimeters, nThreads);
+    }
+    pointLevel = std::move(compacted);
+}
+
+template <typename Geometry>
+void nrnOrder(Geometry& geometry, unsigned int nThreads) {
+    auto& sections = geometry._sectionLevel._sections;
+    auto& types = geometry._sectionLevel._sectionTypes;
+    auto& pointLevel = geometry._pointLevel;
+    const size_t nSections = sections.size();
+
+    // In depth first order, each neurite is the range of sections from its root to the next one
+    std::vector<size_t> roots;
+    for (size_t i = 0; i < nSections; ++i) {
+        if (sections[i][1] == -1) {
+            roots.push_back(i);
+        }
+    }
+    std::vector<size_t> order(roots.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&roots, &types](size_t a, size_t b) {
+        return types[roots[a]] < types[roots[b]];
+    });
+    if (std::is_sorted(order.begin(), order.end())) {
+        return;
+    }
+    roots.push_back(nSections);
+    nThreads = threadCount(pointLevel._points.size(), nThreads);
+
+    const std::vector<size_t> offsets = sectionOffsets(sections, pointLevel._points.size());
+    std::vector<std::pair<size_t, size_t>> sectionBlocks;
+    std::vector<std::pair<size_t, size_t>> pointBlocks;
+    std::vector<size_t> sectionBlockOffsets;
+    std::vector<size_t> pointBlockOffsets;
+    size_t sectionOffset = 0;
+    size_t pointOffset = 0;
+    for (const size_t neurite : order) {
+        const size_t begin = roots[neurite];
+        const size_t end = roots[neurite + 1];
+        sectionBlocks.emplace_back(begin, end);
+        sectionBlockOffsets.push_back(sectionOffset);
+        pointBlocks.emplace_back(offsets[begin], offsets[end]);
+        pointBlockOffsets.push_back(pointOffset);
+        sectionOffset += end - begin;
+        pointOffset += offsets[end] - offsets[begin];
+    }
+
+    // Section ids and point offsets move by the same amount within a neurite
+    std::vector<Property::Section::Type> newSections(nSections);
+    for (size_t block = 0; block < sectionBlocks.size(); ++block) {
+        const auto idShift = static_cast<int>(sectionBlockOffsets[block]) -
+                             static_cast<int>(sectionBlocks[block].first);
+        const auto pointShift = static_cast<int>(pointBlockOffsets[block]) -
+                                static_cast<int>(pointBlocks[block].first);
+        for (size_t i = sectionBlocks[block].first; i < sectionBlocks[block].second; ++i) {
+            const int parent = sections[i][1];
+            newSections[static_cast<size_t>(static_cast<int>(i) + idShift)] = {
+                sections[i][0] + pointShift, parent == -1 ? -1 : parent + idShift};
+        }
+    }
+    std::vector<Property::SectionType::Type> newTypes(nSections);
+    gather(types, sectionBlocks, sectionBlockOffsets, newTypes, 1);
+    sections = std::move(newSections);
+    types = std::move(newTypes);
+
+    decltype(Geometry::_pointLevel) reordered;
+    reordered._points.resize(pointLevel._points.size());
+    reordered._diameters.resize(pointLevel._diameters.size());
+    gather(pointLevel._points, pointBlocks, pointBlockOffsets, reordered._points, nThreads);
+    gather(pointLevel._diameters, pointBlocks, pointBlockOffsets, reordered._diameters, nThreads);
+    if (!pointLevel._perimeters.empty()) {
+        reordered._perimeters.resize(pointLevel._perimeters.size());
+        gather(pointLevel._perimeters,
+               pointBlocks,
+               pointBlockOffsets,
+               reordered._perimeters,
+               nThreads);
+    }
+    pointLevel = std::move(reordered);
+}
+
+bool isSanitized(const Property::Properties& properties, bool checkDuplicates) {
+    const auto& sections = properties._sectionLevel._sections;
+    const auto& pointLevel = properties._pointLevel;
+    const size_t nPoints = pointLevel._points.size();
+    if (pointLevel._diameters.size() != nPoints ||
+        (!pointLevel._perimeters.empty() && pointLevel._perimeters.size() != nPoints) ||
+        (!sections.empty() && sections[0][0] != 0)) {
+        return false;
+    }
+
+    const std::vector<size_t> offsets = sectionOffsets(sections, nPoints);
+    std::vector<uint32_t> nChildren(sections.size(), 0);
+    // The ancestors of the previous section: in depth first order, the parent of a section is
+    // one of them
+    std::vector<size_t> ancestors;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (offsets[i + 1] <= offsets[i]) {
+            return false;  // empty or out of order
+        }
+        const int parent = sections[i][1];
+        if (parent == -1) {
+            ancestors.clear();
+        } else {
+            while (!ancestors.empty() && ancestors.back() != static_cast<size_t>(parent)) {
+                ancestors.pop_back();
+            }
+            if (ancestors.empty()) {
+                return false;
+            }
+            ++nChildren[ancestors.back()];
+            const size_t parentLastPoint = offsets[ancestors.back() + 1] - 1;
+            if (checkDuplicates &&
+                pointLevel._points[offsets[i]] != pointLevel._points[parentLastPoint]) {
+                return false;
+            }
+        }
+        ancestors.push_back(i);
+    }
+    if (std::find(nChildren.begin(), nChildren.end(), 1) != nChildren.end()) {
+        return false;
+    }
+
+    // The mitochondria are written neurite by neurite, each one in breadth first order
+    const auto& mitoSections = properties._mitochondriaSectionLevel._sections;
+    if (mitoSections.empty()) {
+        return true;
+    }
+    if (mitoSections[0][0] != 0) {
+        return false;
+    }
+    std::vector<std::vector<size_t>> mitoChildren(mitoSections.size());
+    std::vector<size_t> queue;
+    for (size_t i = 0; i < mitoSections.size(); ++i) {
+        const int parent = mitoSections[i][1];
+        if (parent == -1) {
+            queue.push_back(i);
+        } else if (parent < 0 || static_cast<size_t>(parent) >= mitoSections.size()) {
+            return false;
+        } else {
+            mitoChildren[static_cast<size_t>(parent)].push_back(i);
+        }
+    }
+    const std::vector<size_t> mitoRoots = std::move(queue);
+    size_t expected = 0;
+    for (const size_t root : mitoRoots) {
+        queue = {root};
+        for (size_t head = 0; head < queue.size(); ++head, ++expected) {
+            if (queue[head] != expected) {
+                return false;
+            }
+            queue.insert(queue.end(),
+                         mitoChildren[queue[head]].begin(),
+                         mitoChildren[queue[head]].end());
+        }
+    }
+    return expected == mitoSections.size();
+}
+
+template void apply(Property::Properties&, unsigned int, unsigned int);
+template void apply(Property::GeometryT<float>&, unsigned int, unsigned int);
+template void apply(Property::GeometryT<double>&, unsigned int, unsigned int);
+template void somaSphere(Property::Properties&);
+template void somaSphere(Property::GeometryT<float>&);
+template void somaSphere(Property::GeometryT<double>&);
+template void somaSphere(std::vector<PointT<float>>&, std::vector<float>&);
+template void somaSphere(std::vector<PointT<double>>&, std::vector<double>&);
+template void compactPoints(Property::Properties&, bool, bool, unsigned int);
+template void compactPoints(Property::GeometryT<float>&, bool, bool, unsigned int);
+template void compactPoints(Property::GeometryT<double>&, bool, bool, unsigned int);
+template void nrnOrder(Property::Properties&, unsigned int);
+template void nrnOrder(Property::GeometryT<float>&, unsigned int);
+template void nrnOrder(Property::GeometryT<double>&, unsigned int);
+
+}  // namespace modifiers
+}  // namespace morphio
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+/**
+   The modifiers of mut::Morphology::applyModifiers, as transforms of the flat arrays of
+   Property::Properties.
+
+   They expect the layout produced by mut::Morphology::buildReadOnly: sanitized, sections in
+   depth first order so that each neurite is a contiguous range of sections and points. They
+   give the same result as going through the mutable morphology.
+**/
+namespace morphio {
+namespace modifiers {
+
+/**
+   Apply the modifier flags (see enums::Option)
+
+   The sections are processed with nThreads threads, 0 picks the number of threads from the
+   size of the morphology and the hardware: loading a morphology with options starts extra
+   threads only above 64k points per thread
+
+   Geometry is Property::Properties or, for load_as, Property::GeometryT
+**/
+template <typename Geometry>
+void apply(Geometry& geometry, unsigned int options, unsigned int nThreads = 0);
+
+/** See mut::modifiers::soma_sphere **/
+template <typename Geometry>
+void somaSphere(Geometry& geometry);
+
+/** Replace the soma points by their center and the diameters by their mean distance to it **/
+template <typename T>
+void somaSphere(std::vector<PointT<T>>& points, std::vector<T>& diameters);
+
+/** Compact the points of the sections for the NO_DUPLICATES and TWO_POINTS_SECTIONS options **/
+template <typename Geometry>
+void compactPoints(Geometry& geometry,
+                   bool noDuplicates,
+                   bool twoPoints,
+                   unsigned int nThreads = 0);
+
+/** Stable sort of the neurites by section type, see mut::modifiers::nrn_order **/
+template <typename Geometry>
+void nrnOrder(Geometry& geometry, unsigned int nThreads = 0);
+
+/**
+   Return true if properties, as loaded from a file, are already in the layout described above:
+   depth first order, no unifurcation, no empty section and mitochondria in the order
+   mut::Morphology::buildReadOnly writes them. With checkDuplicates, every section must also
+   start with the last point of its parent.
+
+   Such properties go unchanged through a sanitizing mut::Morphology round-trip.
+**/
+bool isSanitized(const Property::Properties& properties, bool checkDuplicates);
+
+}  // namespace modifiers
+}  // namespace morphio
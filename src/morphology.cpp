@@ -4,6 +4,7 @@
 #include <fstream>
 #include <memory>
 #include <streambuf>
+#include <type_traits>
 
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/mitochondria.h>
@@ -14,53 +15,131 @@
 
 #include <morphio/mut/morphology.h>
 
+#include "memory.h"
+#include "modifiers.h"
+#include "precise_points.h"
 #include "readers/morphologyASC.h"
+#include "readers/morphologyBinary.h"
 #include "readers/morphologyHDF5.h"
 #include "readers/morphologySWC.h"
+#include "stats.h"
 
 namespace morphio {
 void buildChildren(std::shared_ptr<Property::Properties> properties);
 SomaType getSomaType(long unsigned int nSomaPoints);
-Property::Properties loadURI(const std::string& source, unsigned int options);
+template <typename T>
+Property::Properties loadURI(const std::string& source,
+                             unsigned int options,
+                             Property::GeometryT<T>* precise);
+
+namespace {
+void countLoad(const Morphology& morphology) {
+    // The memory usage walks every array: only computed for a stats collector
+    if (detail::collectingStats()) {
+        detail::countLoad(morphology.memoryUsage().total());
+    }
+}
+
+/** The geometry of the loaded morphology, when load_as asks for its precision **/
+template <typename T>
+void takePoints(Property::GeometryT<T>& geometry,
+                Property::Properties& properties,
+                std::true_type /* floatType */) {
+    geometry._pointLevel = std::move(properties._pointLevel);
+    geometry._somaLevel = std::move(properties._somaLevel);
+}
+
+/** In another precision, the readers already read the points in it **/
+template <typename T>
+void takePoints(Property::GeometryT<T>&, Property::Properties&, std::false_type /* floatType */) {}
+}  // anonymous namespace
 
 Morphology::Morphology(const Property::Properties& properties, unsigned int options)
     : _properties(std::make_shared<Property::Properties>(properties)) {
-    buildChildren(_properties);
+    _process<floatType>(options, nullptr);
+}
 
-    if (version() != MORPHOLOGY_VERSION_SWC_1)
+template <typename T>
+void Morphology::_process(unsigned int options, Property::GeometryT<T>* precise) {
+    // The binary format stores the soma type computed when it was written
+    if (version() != MORPHOLOGY_VERSION_SWC_1 &&
+        (version() != MORPHOLOGY_VERSION_BINARY_1 ||
+         _properties->_cellLevel._somaType == SOMA_UNDEFINED))
         _properties->_cellLevel._somaType = getSomaType(soma().points().size());
 
     // For SWC and ASC, sanitization and modifier application are already taken care of by
-    // their respective loaders
-    if ((version() == MORPHOLOGY_VERSION_H5_1 || version() == MORPHOLOGY_VERSION_H5_1_1 ||
-         version() == MORPHOLOGY_VERSION_H5_2)) {
+    // their respective loaders. H5 data is sanitized through the mutable morphology, unless it
+    // already is. Binary files are written sanitized, but are checked like H5 as they may not be
+    const bool isH5 = version() == MORPHOLOGY_VERSION_H5_1 ||
+                      version() == MORPHOLOGY_VERSION_H5_1_1 ||
+                      version() == MORPHOLOGY_VERSION_H5_2;
+    const bool isBinary = version() == MORPHOLOGY_VERSION_BINARY_1;
+    if ((isH5 || isBinary) &&
+        !modifiers::isSanitized(*_properties,
+                                !readers::ErrorMessages::isIgnored(WRONG_DUPLICATE))) {
+        buildChildren(_properties);
         mut::Morphology mutable_morph(*this);
-        mutable_morph.sanitize();
-        if (options) {
-            mutable_morph.applyModifiers(options);
+        if (precise != nullptr) {
+            detail::PrecisePoints<T> precisePoints(*_properties, *precise);
+            precisePoints.sanitize(mutable_morph, readers::DebugInfo());
+            precisePoints.build(mutable_morph, *precise);
+        } else {
+            mutable_morph.sanitize();
         }
-        _properties = std::make_shared<Property::Properties>(mutable_morph.buildReadOnly());
-        buildChildren(_properties);
+        _properties = std::make_shared<Property::Properties>(
+            std::move(mutable_morph).buildReadOnly());
+    }
+    if ((isH5 || isBinary) && options) {
+        if (precise != nullptr) {
+            precise->_sectionLevel = _properties->_sectionLevel;
+            modifiers::apply(*precise, options);
+        }
+        modifiers::apply(*_properties, options);
+    }
+    buildChildren(_properties);
+    // Sole owner of the properties: drop what the readers and the sanitizer over-reserved
+    if (options & SHRINK_TO_FIT) {
+        _properties->shrinkToFit();
     }
 }
 
-Morphology::Morphology(const HighFive::Group& group, unsigned int options)
-    : Morphology(readers::h5::load(group), options) {}
+Morphology::Morphology(const HighFive::Group& group, unsigned int options) {
+    const detail::PhaseTimer timer(Stats::LOAD);
+    *this = Morphology(readers::h5::load(group), options);
+    countLoad(*this);
+}
 
-Morphology::Morphology(const std::string& source, unsigned int options)
-    : Morphology(loadURI(source, options), options) {}
+Morphology::Morphology(const std::string& source, unsigned int options) {
+    const detail::PhaseTimer timer(Stats::LOAD);
+    *this = Morphology(loadURI<floatType>(source, options, nullptr), options);
+    countLoad(*this);
+}
 
 Morphology::Morphology(mut::Morphology morphology) {
     morphology.sanitize();
-    _properties = std::make_shared<Property::Properties>(morphology.buildReadOnly());
+    _properties = std::make_shared<Property::Properties>(std::move(morphology).buildReadOnly());
     buildChildren(_properties);
 }
 
+Morphology::Morphology(std::shared_ptr<Property::Properties> properties) noexcept
+    : _properties(std::move(properties)) {}
+
 Morphology::Morphology(Morphology&&) noexcept = default;
 Morphology& Morphology::operator=(Morphology&&) noexcept = default;
 
 Morphology::~Morphology() = default;
 
+MemoryUsage Morphology::memoryUsage() const {
+    MemoryUsage usage = _properties->memoryUsage();
+    detail::MemoryCounter counter(usage);
+    usage.objects += counter.block(detail::sharedObjectBytes<Property::Properties>());
+    return usage;
+}
+
+uint64_t Morphology::contentHash(const Property::HashOptions& options) const {
+    return _properties->contentHash(options);
+}
+
 Soma Morphology::soma() const {
     return Soma(_properties);
 }
@@ -185,6 +264,7 @@ SomaType getSomaType(long unsigned int nSomaPoints) {
 }
 
 void buildChildren(std::shared_ptr<Property::Properties> properties) {
+    const detail::PhaseTimer timer(Stats::BUILD_CHILDREN);
     {
         const auto& sections = properties->get<Property::Section>();
         auto& children = properties->_sectionLevel._children;
@@ -206,7 +286,10 @@ void buildChildren(std::shared_ptr<Property::Properties> properties) {
     }
 }
 
-Property::Properties loadURI(const std::string& source, unsigned int options) {
+template <typename T>
+Property::Properties loadURI(const std::string& source,
+                             unsigned int options,
+                             Property::GeometryT<T>* precise) {
     const size_t pos = source.find_last_of(".");
     if (pos == std::string::npos)
         throw(UnknownFileType("File has no extension"));
@@ -219,17 +302,46 @@ Property::Properties loadURI(const std::string& source, unsigned int options) {
 
     std::string extension = source.substr(pos);
 
-    auto loader = [&source, &options, &extension]() {
+    auto loader = [&source, &options, &extension, precise]() {
         if (extension == ".h5" || extension == ".H5")
-            return readers::h5::load(source);
+            return precise != nullptr ? readers::h5::load(source, *precise)
+                                      : readers::h5::load(source);
         if (extension == ".asc" || extension == ".ASC")
-            return readers::asc::load(source, options);
+            return precise != nullptr ? readers::asc::load(source, options, *precise)
+                                      : readers::asc::load(source, options);
         if (extension == ".swc" || extension == ".SWC")
-            return readers::swc::load(source, options);
-        throw(UnknownFileType("Unhandled file type: only SWC, ASC and H5 are supported"));
+            return precise != nullptr ? readers::swc::load(source, options, *precise)
+                                      : readers::swc::load(source, options);
+        if (extension == ".mbin" || extension == ".MBIN")
+            return precise != nullptr ? readers::binary::load(source, *precise)
+                                      : readers::binary::load(source);
+        throw(UnknownFileType("Unhandled file type: only SWC, ASC, H5 and MBIN are supported"));
     };
 
     return loader();
 }
 
+template <typename T>
+Property::GeometryT<T> load_as(const std::string& source, unsigned int options) {
+    const detail::PhaseTimer timer(Stats::LOAD);
+    const std::is_same<T, floatType> isFloatType;
+    // In another precision than floatType, the readers read the points in T as well
+    Property::GeometryT<T> geometry;
+    Property::GeometryT<T>* precise = isFloatType ? nullptr : &geometry;
+    Morphology morphology(
+        std::make_shared<Property::Properties>(loadURI(source, options, precise)));
+    morphology._process(options, precise);
+    countLoad(morphology);
+
+    // The morphology is the only owner of its properties: they are moved out, not copied
+    Property::Properties& properties = *morphology._properties;
+    takePoints(geometry, properties, isFloatType);
+    geometry._sectionLevel = std::move(properties._sectionLevel);
+    geometry._cellLevel = std::move(properties._cellLevel);
+    return geometry;
+}
+
+template Property::GeometryT<float> load_as(const std::string&, unsigned int);
+template Property::GeometryT<double> load_as(const std::string&, unsigned int);
+
 }  // namespace morphio
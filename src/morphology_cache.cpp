@@ -0,0 +1,186 @@
+#include <cstdlib>     // realpath, free
+#include <sys/stat.h>  // stat
+
+#include <morphio/morphology_cache.h>
+
+#if defined(WIN32) || defined(__WIN32__) || defined(_WIN32) || defined(_MSC_VER) || \
+    defined(__MINGW32__)
+#define MORPHIO_CACHE_WINDOWS
+#endif
+
+namespace morphio {
+namespace {
+
+std::string canonicalPath(const std::string& path) {
+#ifdef MORPHIO_CACHE_WINDOWS
+    char* resolved = _fullpath(nullptr, path.c_str(), 0);
+#else
+    char* resolved = realpath(path.c_str(), nullptr);
+#endif
+    if (resolved == nullptr) {
+        return path;
+    }
+    std::string result(resolved);
+    free(resolved);
+    return result;
+}
+
+std::shared_ptr<Property::Properties> decode(const Property::Properties& properties,
+                                             const Property::QuantizedPointLevel& points) {
+    auto decoded = std::make_shared<Property::Properties>(properties);
+    decoded->_pointLevel = points.decode();
+    return decoded;
+}
+
+}  // anonymous namespace
+
+bool MorphologyCache::Key::operator==(const Key& other) const noexcept {
+    return path == other.path && options == other.options && mtime == other.mtime &&
+           size == other.size;
+}
+
+size_t MorphologyCache::KeyHash::operator()(const Key& key) const noexcept {
+    size_t seed = std::hash<std::string>()(key.path);
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<unsigned int>()(key.options));
+    combine(std::hash<int64_t>()(key.mtime));
+    combine(std::hash<uint64_t>()(key.size));
+    return seed;
+}
+
+MorphologyCache::MorphologyCache(size_t maxBytes, bool quantizePoints)
+    : _maxBytes(maxBytes)
+    , _quantizePoints(quantizePoints) {}
+
+MorphologyCache::Key MorphologyCache::_key(const std::string& path, unsigned int options) {
+    struct stat status;
+    if (stat(path.c_str(), &status) != 0) {
+        throw RawDataError("File: " + path + " does not exist.");
+    }
+    const int64_t mtime = status.st_mtime;
+    return {canonicalPath(path), options, mtime, static_cast<uint64_t>(status.st_size)};
+}
+
+Morphology MorphologyCache::get(const std::string& path, unsigned int options) {
+    const Key key = _key(path, options);
+
+    std::promise<PropertiesPtr> promise;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        const auto entry = _entries.find(key);
+        if (entry != _entries.end()) {
+            ++_stats.hits;
+            _lru.splice(_lru.begin(), _lru, entry->second.position);
+            if (!entry->second.points) {
+                return Morphology(entry->second.properties);
+            }
+            PropertiesPtr decoded = entry->second.decoded.lock();
+            if (decoded) {
+                return Morphology(decoded);
+            }
+
+            const Entry cached = entry->second;
+            lock.unlock();
+            decoded = decode(*cached.properties, *cached.points);
+            lock.lock();
+            const auto current = _entries.find(key);
+            if (current != _entries.end()) {
+                // Another lookup may have decoded the entry in the meantime
+                const PropertiesPtr shared = current->second.decoded.lock();
+                if (shared) {
+                    return Morphology(shared);
+                }
+                current->second.decoded = decoded;
+            }
+            return Morphology(decoded);
+        }
+
+        const auto loading = _loading.find(key);
+        if (loading != _loading.end()) {
+            ++_stats.hits;
+            std::shared_future<PropertiesPtr> future = loading->second;
+            lock.unlock();
+            return Morphology(future.get());
+        }
+
+        ++_stats.misses;
+        _loading.emplace(key, promise.get_future().share());
+    }
+
+    PropertiesPtr properties;
+    try {
+        properties = Morphology(path, options)._properties;
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _loading.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    properties = _insert(key, properties);
+    promise.set_value(properties);
+    return Morphology(properties);
+}
+
+MorphologyCache::PropertiesPtr MorphologyCache::_insert(const Key& key,
+                                                        const PropertiesPtr& properties) {
+    QuantizedPtr points;
+    PropertiesPtr result = properties;
+    size_t bytes = 0;
+    if (_quantizePoints) {
+        // The properties of the load are not shared yet: the entry keeps them without points
+        points = std::make_shared<const Property::QuantizedPointLevel>(properties->_pointLevel);
+        properties->_pointLevel = Property::PointLevel();
+        result = decode(*properties, *points);
+        bytes = points->memoryUsage().total();
+    }
+    bytes += Morphology(properties).memoryUsage().total();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _loading.erase(key);
+    if (bytes > _maxBytes) {
+        // Would evict everything else and still not fit
+        return result;
+    }
+
+    while (_stats.bytes + bytes > _maxBytes && !_lru.empty()) {
+        const auto evicted = _entries.find(_lru.back());
+        _stats.bytes -= evicted->second.bytes;
+        _entries.erase(evicted);
+        _lru.pop_back();
+        ++_stats.evictions;
+    }
+
+    _lru.push_front(key);
+    _entries[key] = Entry{properties, points, result, bytes, _lru.begin()};
+    _stats.bytes += bytes;
+    return result;
+}
+
+MorphologyCache::Stats MorphologyCache::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats = _stats;
+    stats.entries = _entries.size();
+    return stats;
+}
+
+size_t MorphologyCache::maxBytes() const noexcept {
+    return _maxBytes;
+}
+
+bool MorphologyCache::quantizePoints() const noexcept {
+    return _quantizePoints;
+}
+
+void MorphologyCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _lru.clear();
+    _stats.bytes = 0;
+}
+
+}  // namespace morphio
@@ -0,0 +1,343 @@
+#include <cstring>  // std::memcpy, std::memcmp
+#include <fstream>  // std::ifstream, std::ofstream
+
+#include <morphio/morphology_store.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/tools.h>
+
+#include "readers/morphologyBinary.h"
+
+/**
+   The archive of a MorphologyStore is little-endian:
+
+   - a 64 bytes header:
+       char[8]  magic "MORPHIOS"
+       uint32   format version (1)
+       uint32   zero
+       uint64   number of morphologies
+       uint64   number of names
+       uint64   total size in bytes of the names
+       (zero padding)
+   - the morphology table, one entry per distinct morphology:
+       uint64   offset of the morphology from the start of the file
+       uint64   size in bytes of the morphology
+       uint64   content hash of the morphology
+   - the name table, one entry per name, sorted by name:
+       uint64   index of the morphology in the morphology table
+       uint64   size in bytes of the name
+   - the names, concatenated
+   - the morphologies in the MorphIO binary format, each one starting on a 64 bytes boundary
+**/
+namespace morphio {
+void buildChildren(std::shared_ptr<Property::Properties> properties);
+
+namespace {
+
+const char kMagic[8] = {'M', 'O', 'R', 'P', 'H', 'I', 'O', 'S'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kAlignment = 64;
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t reserved;
+    uint64_t nMorphologies;
+    uint64_t nNames;
+    uint64_t namesSize;
+};
+
+struct MorphologyEntry {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t hash;
+};
+
+struct NameEntry {
+    uint64_t morphology;
+    uint64_t nameSize;
+};
+
+static_assert(sizeof(Header) <= kHeaderSize, "The header must fit in kHeaderSize bytes");
+static_assert(sizeof(MorphologyEntry) == 24, "Morphology entries must not be padded");
+static_assert(sizeof(NameEntry) == 16, "Name entries must not be padded");
+
+size_t aligned(size_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+Property::HashOptions hashOptions() {
+    Property::HashOptions options;
+    options.organelles = true;
+    return options;
+}
+
+template <typename T>
+void readValues(std::ifstream& file, T* values, size_t count, const std::string& filename) {
+    if (!file.read(reinterpret_cast<char*>(values),
+                   static_cast<std::streamsize>(count * sizeof(T)))) {
+        throw RawDataError("Truncated morphology store: " + filename);
+    }
+}
+
+/**
+   Take the bytes of count values of valueSize from the remaining bytes of the file, before
+   allocating them: throw if they do not fit
+**/
+void reserveBytes(uint64_t count,
+                  uint64_t valueSize,
+                  uint64_t& remaining,
+                  const std::string& filename) {
+    if (count > remaining / valueSize) {
+        throw RawDataError("Corrupted morphology store header: " + filename);
+    }
+    remaining -= count * valueSize;
+}
+
+}  // namespace
+
+MorphologyStore::MorphologyStore(const std::string& filename) {
+    read(filename);
+}
+
+Morphology MorphologyStore::add(const std::string& name, const Morphology& morphology) {
+    const PropertiesPtr& properties = morphology._properties;
+    const uint64_t hash = properties->contentHash(hashOptions());
+    const size_t bytes = morphology.memoryUsage().total();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Morphology(_add(name, properties, hash, bytes));
+}
+
+Morphology MorphologyStore::add(const std::string& name, const mut::Morphology& morphology) {
+    return add(name, Morphology(morphology));
+}
+
+MorphologyStore::PropertiesPtr MorphologyStore::_add(const std::string& name,
+                                                     const PropertiesPtr& properties,
+                                                     uint64_t hash,
+                                                     size_t bytes) {
+    Entry* entry = nullptr;
+    const auto candidates = _entries.equal_range(hash);
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        // Guard against hash collisions
+        if (it->second.properties == properties ||
+            !diff(Morphology(it->second.properties), Morphology(properties), LogLevel::ERROR)) {
+            entry = &it->second;
+            break;
+        }
+    }
+    if (entry == nullptr) {
+        entry = &_entries.emplace(hash, Entry{properties, hash, bytes, 0})->second;
+    }
+
+    ++entry->names;
+    const auto previous = _names.find(name);
+    if (previous == _names.end()) {
+        _names.emplace(name, entry);
+    } else {
+        Entry* replaced = previous->second;
+        previous->second = entry;
+        _release(replaced);
+    }
+    return entry->properties;
+}
+
+void MorphologyStore::_release(Entry* entry) {
+    if (--entry->names > 0) {
+        return;
+    }
+    const auto candidates = _entries.equal_range(entry->hash);
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if (&it->second == entry) {
+            _entries.erase(it);
+            return;
+        }
+    }
+}
+
+Morphology MorphologyStore::get(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto it = _names.find(name);
+    if (it == _names.end()) {
+        throw MorphioError("No morphology named '" + name + "' in the store");
+    }
+    return Morphology(it->second->properties);
+}
+
+bool MorphologyStore::contains(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _names.count(name) > 0;
+}
+
+std::vector<std::string> MorphologyStore::names() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<std::string> result;
+    result.reserve(_names.size());
+    for (const auto& name : _names) {
+        result.push_back(name.first);
+    }
+    return result;
+}
+
+MorphologyStore::Stats MorphologyStore::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats;
+    stats.names = _names.size();
+    stats.unique = _entries.size();
+    for (const auto& entry : _entries) {
+        stats.bytes += entry.second.bytes;
+        stats.savedBytes += (entry.second.names - 1) * entry.second.bytes;
+    }
+    return stats;
+}
+
+void MorphologyStore::write(const std::string& filename) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Morphologies in the order of their first name, for reproducible archives
+    std::map<const Entry*, uint64_t> indices;
+    std::vector<const Entry*> entries;
+    std::vector<NameEntry> nameTable;
+    uint64_t namesSize = 0;
+    for (const auto& name : _names) {
+        const auto inserted = indices.emplace(name.second, entries.size());
+        if (inserted.second) {
+            entries.push_back(name.second);
+        }
+        nameTable.push_back({inserted.first->second, name.first.size()});
+        namesSize += name.first.size();
+    }
+
+    std::vector<std::vector<char>> blobs;
+    std::vector<MorphologyEntry> morphologyTable;
+    size_t offset = aligned(kHeaderSize + entries.size() * sizeof(MorphologyEntry) +
+                            nameTable.size() * sizeof(NameEntry) + namesSize);
+    for (const Entry* entry : entries) {
+        blobs.push_back(readers::binary::serialize(*entry->properties));
+        morphologyTable.push_back({offset, blobs.back().size(), entry->hash});
+        offset = aligned(offset + blobs.back().size());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.formatVersion = kFormatVersion;
+    header.nMorphologies = entries.size();
+    header.nNames = nameTable.size();
+    header.namesSize = namesSize;
+
+    std::vector<char> buffer(kHeaderSize);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    const auto append = [&buffer](const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    };
+    append(morphologyTable.data(), morphologyTable.size() * sizeof(MorphologyEntry));
+    append(nameTable.data(), nameTable.size() * sizeof(NameEntry));
+    for (const auto& name : _names) {
+        append(name.first.data(), name.first.size());
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw WriterError("Cannot open file: " + filename);
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    size_t written = buffer.size();
+    const std::vector<char> padding(kAlignment, 0);
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        const size_t paddingSize = morphologyTable[i].offset - written;
+        file.write(padding.data(), static_cast<std::streamsize>(paddingSize));
+        file.write(blobs[i].data(), static_cast<std::streamsize>(blobs[i].size()));
+        written = morphologyTable[i].offset + blobs[i].size();
+    }
+    if (!file) {
+        throw WriterError("Cannot write file: " + filename);
+    }
+}
+
+void MorphologyStore::read(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw RawDataError("File: " + filename + " does not exist.");
+    }
+
+    file.seekg(0, std::ios::end);
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (fileSize < 0) {
+        throw RawDataError("Cannot read file: " + filename);
+    }
+
+    char headerBytes[kHeaderSize];
+    readValues(file, headerBytes, kHeaderSize, filename);
+    Header header;
+    std::memcpy(&header, headerBytes, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw RawDataError("Not a morphology store: " + filename);
+    }
+    if (header.formatVersion != kFormatVersion) {
+        throw RawDataError("Unsupported morphology store version " +
+                           std::to_string(header.formatVersion) + ": " + filename);
+    }
+
+    // The sizes come from the file: checked against its length before anything is allocated
+    const auto length = static_cast<uint64_t>(fileSize);
+    uint64_t remaining = length - kHeaderSize;
+    reserveBytes(header.nMorphologies, sizeof(MorphologyEntry), remaining, filename);
+    reserveBytes(header.nNames, sizeof(NameEntry), remaining, filename);
+    reserveBytes(header.namesSize, 1, remaining, filename);
+
+    std::vector<MorphologyEntry> morphologyTable(header.nMorphologies);
+    readValues(file, morphologyTable.data(), morphologyTable.size(), filename);
+    for (const auto& entry : morphologyTable) {
+        if (entry.offset > length || entry.size > length - entry.offset) {
+            throw RawDataError("Corrupted morphology store index: " + filename);
+        }
+    }
+    std::vector<NameEntry> nameTable(header.nNames);
+    readValues(file, nameTable.data(), nameTable.size(), filename);
+    std::string names(header.namesSize, '\0');
+    readValues(file, &names[0], names.size(), filename);
+    // All checked before the store is modified, so that a corrupted archive leaves it unchanged
+    uint64_t namesEnd = 0;
+    for (const auto& entry : nameTable) {
+        if (entry.morphology >= morphologyTable.size() ||
+            entry.nameSize > names.size() - namesEnd) {
+            throw RawDataError("Corrupted morphology store index: " + filename);
+        }
+        namesEnd += entry.nameSize;
+    }
+
+    std::vector<PropertiesPtr> morphologies;
+    std::vector<uint64_t> hashes;
+    std::vector<size_t> bytes;
+    std::vector<char> buffer;
+    for (const auto& entry : morphologyTable) {
+        buffer.resize(entry.size);
+        file.seekg(static_cast<std::streamoff>(entry.offset));
+        readValues(file, buffer.data(), buffer.size(), filename);
+        // As stored: the Morphology constructor would compute the soma types left undefined
+        const auto properties = std::make_shared<Property::Properties>(
+            readers::binary::load(buffer.data(), buffer.size(), filename));
+        buildChildren(properties);
+        morphologies.push_back(properties);
+        const Morphology morphology(properties);
+        // Hashed again: the archive may come from a build of another floatType
+        hashes.push_back(morphology.contentHash(hashOptions()));
+        bytes.push_back(morphology.memoryUsage().total());
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t nameOffset = 0;
+    for (const auto& entry : nameTable) {
+        const auto index = static_cast<size_t>(entry.morphology);
+        _add(names.substr(nameOffset, entry.nameSize),
+             morphologies[index],
+             hashes[index],
+             bytes[index]);
+        nameOffset += entry.nameSize;
+    }
+}
+
+}  // namespace morphio
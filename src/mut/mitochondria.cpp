@@ -3,6 +3,8 @@
 #include <morphio/shared_utils.tpp>
 #include <queue>  // std::queue
 
+#include "../memory.h"
+
 namespace morphio {
 namespace mut {
 
@@ -143,5 +145,36 @@ uint32_t Mitochondria::_register(const MitoSectionP& section_) {
     return section_->id();
 }
 
+MemoryUsage Mitochondria::memoryUsage() const {
+    MemoryUsage usage;
+    detail::MemoryCounter counter(usage);
+    size_t bytes = counter.mapNodes(_sections) + counter.mapNodes(_parent) +
+                   counter.mapNodes(_children) + counter.vector(_rootSections);
+    for (const auto& kv : _children) {
+        bytes += counter.vector(kv.second);
+    }
+    for (const auto& kv : _sections) {
+        const auto& points = kv.second->_mitoPoints;
+        bytes += counter.block(detail::sharedObjectBytes<MitoSection>()) +
+                 counter.vector(points._sectionIds) + counter.vector(points._relativePathLengths) +
+                 counter.vector(points._diameters);
+    }
+    usage.mitochondria = bytes;
+    return usage;
+}
+
+void Mitochondria::shrinkToFit() {
+    _rootSections.shrink_to_fit();
+    for (auto& kv : _children) {
+        kv.second.shrink_to_fit();
+    }
+    for (auto& kv : _sections) {
+        auto& points = kv.second->_mitoPoints;
+        points._sectionIds.shrink_to_fit();
+        points._relativePathLengths.shrink_to_fit();
+        points._diameters.shrink_to_fit();
+    }
+}
+
 }  // namespace mut
 }  // namespace morphio
@@ -1,8 +1,9 @@
 #include <algorithm>
-#include <cmath>
 #include <morphio/mut/modifiers.h>
 #include <morphio/mut/morphology.h>
 
+#include "../modifiers.h"
+
 namespace morphio {
 namespace mut {
 namespace modifiers {
@@ -38,28 +39,7 @@ void no_duplicate_point(morphio::mut::Morphology& morpho) {
 
 void soma_sphere(morphio::mut::Morphology& morpho) {
     auto soma = morpho.soma();
-    floatType size = static_cast<morphio::floatType>(soma->points().size());
-
-    if (size < 2)
-        return;
-
-    floatType x = 0, y = 0, z = 0, r = 0;
-    for (const Point& point : soma->points()) {
-        x += point[0] / size;
-        y += point[1] / size;
-        z += point[2] / size;
-    }
-
-    for (auto point : soma->points()) {
-#ifdef MORPHIO_USE_DOUBLE
-        r += sqrt(pow(point[0] - x, 2) + pow(point[1] - y, 2) + pow(point[2] - z, 2)) / size;
-#else
-        r += sqrtf(powf(point[0] - x, 2) + powf(point[1] - y, 2) + powf(point[2] - z, 2)) / size;
-#endif
-    }
-
-    soma->points() = {{x, y, z}};
-    soma->diameters() = {r};
+    morphio::modifiers::somaSphere(soma->points(), soma->diameters());
 }
 
 static bool NRN_order_comparator(std::shared_ptr<Section> a, std::shared_ptr<Section> b) {
@@ -1,5 +1,6 @@
 #include <assert.h>
 
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -13,12 +14,28 @@
 #include <morphio/soma.h>
 #include <morphio/tools.h>
 
+#include "../memory.h"
+#include "../stats.h"
+#include "section_arena.h"
+
 namespace morphio {
 namespace mut {
 
 void _appendProperties(Property::PointLevel& to, const Property::PointLevel& from, int offset);
 
+namespace {
+/** Append the values of a section view, skipping the first one if asked and there is one **/
+template <typename T>
+void _appendView(std::vector<T>& to, range<const T> from, bool skipFirst) {
+    const std::ptrdiff_t offset = skipFirst && !from.empty() ? 1 : 0;
+    to.insert(to.end(), from.begin() + offset, from.end());
+}
+}  // namespace
+
 using morphio::readers::ErrorMessages;
+
+constexpr uint32_t Morphology::NO_PARENT;
+
 Morphology::Morphology(const std::string& uri, unsigned int options)
     : Morphology(morphio::Morphology(uri, options)) {}
 
@@ -63,14 +80,18 @@ Morphology::Morphology(const morphio::Morphology& morphology, unsigned int optio
  **/
 bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
                           const std::shared_ptr<Section>& current) {
+    // Compare through the views, not to copy the points of sections sharing them
+    const auto parentPoints = parent->_pointsView();
+    const auto currentPoints = current->_pointsView();
+
     // Weird edge case where parent is empty: skipping it
-    if (parent->points().empty())
+    if (parentPoints.empty())
         return true;
 
-    if (current->points().empty())
+    if (currentPoints.empty())
         return false;
 
-    if (parent->points().back() != current->points().front())
+    if (parentPoints[parentPoints.size() - 1] != currentPoints[0])
         return false;
 
     // // As perimeter is optional, it must either be defined for parent and
@@ -89,13 +110,13 @@ bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
 
 std::shared_ptr<Section> Morphology::appendRootSection(const morphio::Section& section_,
                                                        bool recursive) {
-    const std::shared_ptr<Section> ptr(new Section(this, _counter, section_));
+    const std::shared_ptr<Section> ptr = _createSection(section_);
     _register(ptr);
     _rootSections.push_back(ptr);
 
-    const bool emptySection = ptr->points().empty();
+    const bool emptySection = ptr->_pointsView().empty();
     if (emptySection)
-        printError(Warning::APPENDING_EMPTY_SECTION, _err.WARNING_APPENDING_EMPTY_SECTION(ptr));
+        printError(readers::AppendingEmptySectionWarning(_err, ptr));
 
     if (recursive) {
         for (const auto& child : section_.children()) {
@@ -108,14 +129,13 @@ std::shared_ptr<Section> Morphology::appendRootSection(const morphio::Section& s
 
 std::shared_ptr<Section> Morphology::appendRootSection(const std::shared_ptr<Section>& section_,
                                                        bool recursive) {
-    const std::shared_ptr<Section> section_copy(new Section(this, _counter, *section_));
+    const std::shared_ptr<Section> section_copy = _createSection(*section_);
     _register(section_copy);
     _rootSections.push_back(section_copy);
 
-    const bool emptySection = section_copy->points().empty();
+    const bool emptySection = section_copy->_pointsView().empty();
     if (emptySection)
-        printError(Warning::APPENDING_EMPTY_SECTION,
-                   _err.WARNING_APPENDING_EMPTY_SECTION(section_copy));
+        printError(readers::AppendingEmptySectionWarning(_err, section_copy));
 
     if (recursive) {
         for (const auto& child : section_->children()) {
@@ -128,13 +148,13 @@ std::shared_ptr<Section> Morphology::appendRootSection(const std::shared_ptr<Sec
 
 std::shared_ptr<Section> Morphology::appendRootSection(const Property::PointLevel& pointProperties,
                                                        SectionType type) {
-    const std::shared_ptr<Section> ptr(new Section(this, _counter, type, pointProperties));
+    const std::shared_ptr<Section> ptr = _createSection(type, pointProperties);
     _register(ptr);
     _rootSections.push_back(ptr);
 
     bool emptySection = ptr->points().empty();
     if (emptySection)
-        printError(Warning::APPENDING_EMPTY_SECTION, _err.WARNING_APPENDING_EMPTY_SECTION(ptr));
+        printError(readers::AppendingEmptySectionWarning(_err, ptr));
 
     return ptr;
 }
@@ -143,21 +163,21 @@ uint32_t Morphology::_register(const std::shared_ptr<Section>& section_) {
     if (_sections.count(section_->id()))
         throw SectionBuilderError("Section already exists");
     _counter = std::max(_counter, section_->id()) + 1;
+    if (_parent.size() < _counter) {
+        _parent.resize(_counter, NO_PARENT);
+        _children.resize(_counter);
+    }
 
     _sections[section_->id()] = section_;
     return section_->id();
 }
 
-Morphology::~Morphology() {
-    auto roots = _rootSections;  // Need to iterate on a copy
-    for (const auto& root : roots) {
-        deleteSection(root, true);
-    }
-}
+Morphology::~Morphology() = default;
 
-static void eraseByValue(std::vector<std::shared_ptr<Section>>& vec,
-                         const std::shared_ptr<Section>& section) {
-    vec.erase(std::remove(vec.begin(), vec.end(), section), vec.end());
+void Morphology::_unlink(uint32_t id) {
+    _parent[id] = NO_PARENT;
+    std::vector<std::shared_ptr<Section>>().swap(_children[id]);
+    _sections.erase(id);
 }
 
 void Morphology::deleteSection(const std::shared_ptr<Section>& section_, bool recursive)
@@ -165,31 +185,33 @@ void Morphology::deleteSection(const std::shared_ptr<Section>& section_, bool re
 {
     if (!section_)
         return;
-    unsigned int id = section_->id();
+    const uint32_t id = section_->id();
 
-    if (recursive) {
-        // The deletion must start by the furthest leaves, otherwise you may cut
-        // the topology and forget to remove some sections
-        std::vector<std::shared_ptr<Section>> ids;
-        std::copy(section_->breadth_begin(), breadth_end(), std::back_inserter(ids));
+    const auto registered = _sections.find(id);
+    if (registered == _sections.end() || registered->second != section_)
+        return;
+
+    const uint32_t parentId = _parent[id];
+    auto& siblings = parentId == NO_PARENT ? _rootSections : _children[parentId];
+    siblings.erase(std::find(siblings.begin(), siblings.end(), section_));
 
-        for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
-            deleteSection(*it, false);
+    if (recursive) {
+        std::vector<uint32_t> subtree{id};
+        while (!subtree.empty()) {
+            const uint32_t current = subtree.back();
+            subtree.pop_back();
+            for (const auto& child : _children[current]) {
+                subtree.push_back(child->id());
+            }
+            _unlink(current);
         }
     } else {
-        for (auto& child : section_->children()) {
-            // Re-link children to their "grand-parent"
-            _parent[child->id()] = _parent[id];
-            _children[_parent[id]].push_back(child);
-            if (section_->isRoot())
-                _rootSections.push_back(child);
+        // Re-link children to their "grand-parent"
+        for (const auto& child : _children[id]) {
+            _parent[child->id()] = parentId;
+            siblings.push_back(child);
         }
-
-        eraseByValue(_rootSections, section_);
-        eraseByValue(_children[_parent[id]], section_);
-        _children.erase(id);
-        _parent.erase(id);
-        _sections.erase(id);
+        _unlink(id);
     }
 }
 
@@ -202,64 +224,195 @@ void _appendProperties(Property::PointLevel& to, const Property::PointLevel& fro
         _appendVector(to._perimeters, from._perimeters, offset);
 }
 
+void _appendRange(Property::PointLevel& to, const Property::PointLevel& from, SectionRange range) {
+    auto append = [range](std::vector<floatType>& to_, const std::vector<floatType>& from_) {
+        to_.insert(to_.end(),
+                   from_.begin() + static_cast<std::ptrdiff_t>(range.first),
+                   from_.begin() + static_cast<std::ptrdiff_t>(range.second));
+    };
+    to._points.insert(to._points.end(),
+                      from._points.begin() + static_cast<std::ptrdiff_t>(range.first),
+                      from._points.begin() + static_cast<std::ptrdiff_t>(range.second));
+    append(to._diameters, from._diameters);
+
+    if (!from._perimeters.empty())
+        append(to._perimeters, from._perimeters);
+}
+
 void Morphology::sanitize() {
     sanitize(morphio::readers::DebugInfo());
 }
 
-void Morphology::sanitize(const morphio::readers::DebugInfo& debugInfo) {
+void Morphology::sanitize(const morphio::readers::DebugInfo& debugInfo, bool copyAnnotationPoints) {
+    _sanitize(debugInfo, copyAnnotationPoints, nullptr);
+}
+
+void Morphology::_sanitize(const morphio::readers::DebugInfo& debugInfo,
+                           bool copyAnnotationPoints,
+                           const std::function<void(uint32_t, uint32_t, bool)>& onMerge) {
+    const detail::PhaseTimer timer(Stats::SANITIZE);
     morphio::readers::ErrorMessages err(debugInfo._filename);
 
-    auto it = depth_begin();
-    while (it != depth_end()) {
-        std::shared_ptr<Section> section_ = *it;
+    // First pass: find the merge chains. A section that is the only child of its parent gets
+    // merged into the head of the chain, that is the closest ancestor which is not merged
+    std::vector<std::shared_ptr<Section>> sections(depth_begin(), depth_end());
+    std::vector<uint32_t> head(_counter, NO_PARENT);
+    std::vector<size_t> chainSize(_counter, 0);
+    for (const auto& section_ : sections) {
+        const uint32_t parentId = _parent[section_->id()];
+        if (parentId != NO_PARENT && _children[parentId].size() == 1) {
+            const uint32_t headId = head[parentId] == NO_PARENT ? parentId : head[parentId];
+            head[section_->id()] = headId;
+            chainSize[headId] += section_->_pointsView().size();
+        }
+    }
 
-        // Incrementing iterator here before we potentially delete the section
-        ++it;
-        unsigned int sectionId = section_->id();
+    for (uint32_t id = 0; id < _counter; ++id) {
+        if (chainSize[id] > 0) {
+            _sections.at(id)->_materialize();
+            auto& points = _sections.at(id)->_pointProperties;
+            const size_t size = points._points.size() + chainSize[id];
+            points._points.reserve(size);
+            points._diameters.reserve(size);
+            if (!points._perimeters.empty())
+                points._perimeters.reserve(size);
+        }
+    }
 
-        if (section_->isRoot())
+    // Second pass, in depth first order so that warnings and annotations come in file order:
+    // check the duplicate points and append each merged section to its head
+    std::vector<uint32_t> merged;
+    for (const auto& section_ : sections) {
+        const uint32_t sectionId = section_->id();
+        uint32_t parentId = _parent[sectionId];
+        if (parentId == NO_PARENT)
             continue;
-
-        unsigned int parentId = section_->parent()->id();
+        if (head[parentId] != NO_PARENT)
+            parentId = head[parentId];
+        const auto& parent = _sections.at(parentId);
 
         if (!ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) &&
-            !_checkDuplicatePoint(section_->parent(), section_))
-            printError(Warning::WRONG_DUPLICATE,
-                       err.WARNING_WRONG_DUPLICATE(section_, section_->parent()));
+            !_checkDuplicatePoint(parent, section_))
+            printError(readers::WrongDuplicateWarning(err, section_, parent));
 
-        auto parent = section_->parent();
-        bool isUnifurcation = parent->children().size() == 1;
-
-        // This "if" condition ensures that "unifurcations" (ie. successive
-        // sections with only 1 child) get merged together into a bigger section
-        if (isUnifurcation) {
-            printError(Warning::ONLY_CHILD, err.WARNING_ONLY_CHILD(debugInfo, parentId, sectionId));
-            bool duplicate = _checkDuplicatePoint(section_->parent(), section_);
+        if (head[sectionId] == NO_PARENT)
+            continue;
 
+        if (!ErrorMessages::isIgnored(Warning::ONLY_CHILD))
+            printError(readers::OnlyChildWarning(err, debugInfo, parentId, sectionId));
+        // Skip the duplicate first point, unless there is none. The merged section is read
+        // through its views: it is unlinked below, copying its shared points would be wasted
+        const bool duplicate = _checkDuplicatePoint(parent, section_);
+        const auto points = section_->_pointsView();
+        const auto diameters = section_->_diametersView();
+        const auto perimeters = section_->_perimetersView();
+
+        const size_t start = parent->points().size();
+        _appendView(parent->points(), points, duplicate);
+        _appendView(parent->diameters(), diameters, duplicate);
+        if (!parent->perimeters().empty())
+            _appendView(parent->perimeters(), perimeters, duplicate);
+        if (onMerge)
+            onMerge(parentId, sectionId, duplicate);
+
+        const int32_t lineNumber = debugInfo.getLineNumber(parentId);
+        if (copyAnnotationPoints) {
+            const Property::PointLevel copy({points.begin(), points.end()},
+                                            {diameters.begin(), diameters.end()},
+                                            {perimeters.begin(), perimeters.end()});
             addAnnotation(morphio::Property::Annotation(morphio::AnnotationType::SINGLE_CHILD,
                                                         sectionId,
-                                                        section_->properties(),
+                                                        copy,
                                                         "",
-                                                        debugInfo.getLineNumber(parentId)));
-
-            morphio::_appendVector(parent->points(), section_->points(), duplicate ? 1 : 0);
-
-            morphio::_appendVector(parent->diameters(), section_->diameters(), duplicate ? 1 : 0);
+                                                        lineNumber));
+        } else {
+            addAnnotation(morphio::Property::Annotation(morphio::AnnotationType::SINGLE_CHILD,
+                                                        parentId,
+                                                        {start, parent->points().size()},
+                                                        "",
+                                                        lineNumber));
+        }
+        merged.push_back(sectionId);
+    }
 
-            if (!parent->perimeters().empty())
-                morphio::_appendVector(parent->perimeters(),
-                                       section_->perimeters(),
-                                       duplicate ? 1 : 0);
+    // Last pass: the head of a chain adopts the children of the last section of the chain
+    for (const uint32_t sectionId : merged) {
+        const uint32_t headId = head[sectionId];
+        for (const auto& child : _children[sectionId]) {
+            _parent[child->id()] = headId;
+        }
+        _children[headId] = std::move(_children[sectionId]);
+        _unlink(sectionId);
+    }
+}
 
-            deleteSection(section_, false);
+void Morphology::_buildSectionLevels(Property::Properties& properties, bool releasePoints) const {
+    const std::vector<std::shared_ptr<Section>> sections(depth_begin(), depth_end());
+
+    // Size everything up front: sections sharing the points of an immutable morphology are
+    // measured without copying them
+    size_t nPoints = 0;
+    bool hasPerimeters = false;
+    for (const auto& section_ : sections) {
+        const Property::PointLevel* shared = section_->_sharedPoints();
+        nPoints += section_->_pointsView().size();
+        hasPerimeters = hasPerimeters || !(shared != nullptr
+                                               ? shared->_perimeters.empty()
+                                               : section_->_pointProperties._perimeters.empty());
+    }
+    auto& sectionLevel = properties._sectionLevel;
+    auto& pointLevel = properties._pointLevel;
+    sectionLevel._sections.reserve(sections.size());
+    sectionLevel._sectionTypes.reserve(sections.size());
+    pointLevel._points.reserve(nPoints);
+    pointLevel._diameters.reserve(nPoints);
+    if (hasPerimeters)
+        pointLevel._perimeters.reserve(nPoints);
+
+    // Shared sections are copied by runs of contiguous ranges of their source, instead of
+    // section by section
+    const Property::PointLevel* runSource = nullptr;
+    SectionRange run;
+    auto appendRun = [&pointLevel, &runSource, &run]() {
+        if (runSource != nullptr) {
+            _appendRange(pointLevel, *runSource, run);
+            runSource = nullptr;
+        }
+    };
+
+    std::vector<int32_t> newIds(_counter, -1);
+    size_t start = 0;
+    for (const auto& section_ : sections) {
+        const uint32_t sectionId = section_->id();
+        const uint32_t parentId = _parent[sectionId];
+        const int32_t parentOnDisk = parentId == NO_PARENT ? -1 : newIds[parentId];
+
+        sectionLevel._sections.push_back({static_cast<int>(start), parentOnDisk});
+        sectionLevel._sectionTypes.push_back(section_->type());
+        newIds[sectionId] = static_cast<int32_t>(sectionLevel._sections.size() - 1);
+        start += section_->_pointsView().size();
+
+        const Property::PointLevel* shared = section_->_sharedPoints();
+        const SectionRange range = section_->_sourceRange;
+        if (shared != nullptr && shared == runSource && range.first == run.second) {
+            run.second = range.second;
+            continue;
+        }
+        appendRun();
+        if (shared != nullptr) {
+            runSource = shared;
+            run = range;
+        } else {
+            _appendProperties(pointLevel, section_->_pointProperties);
+            if (releasePoints)
+                section_->_pointProperties = Property::PointLevel();
         }
     }
+    appendRun();
 }
 
-Property::Properties Morphology::buildReadOnly() const {
-    using std::setw;
-    int sectionIdOnDisk = 0;
-    std::map<uint32_t, int32_t> newIds;
+Property::Properties Morphology::buildReadOnly() const& {
+    const detail::PhaseTimer timer(Stats::BUILD_READ_ONLY);
     Property::Properties properties{};
 
     if (_cellProperties) {
@@ -267,25 +420,103 @@ Property::Properties Morphology::buildReadOnly() const {
         properties._cellLevel._somaType = _soma->type();
     }
     _appendProperties(properties._somaLevel, _soma->_pointProperties);
+    _buildSectionLevels(properties, false);
 
-    for (auto it = depth_begin(); it != depth_end(); ++it) {
-        const std::shared_ptr<Section>& section_ = *it;
-        unsigned int sectionId = section_->id();
-        int parentOnDisk = (section_->isRoot() ? -1 : newIds[section_->parent()->id()]);
+    mitochondria()._buildMitochondria(properties);
+    properties._annotations = annotations();
+    properties._endoplasmicReticulumLevel = endoplasmicReticulum().buildReadOnly();
+    return properties;
+}
+
+Property::Properties Morphology::buildReadOnly() && {
+    const detail::PhaseTimer timer(Stats::BUILD_READ_ONLY);
+    Property::Properties properties{};
 
-        auto start = static_cast<int>(properties._pointLevel._points.size());
-        properties._sectionLevel._sections.push_back({start, parentOnDisk});
-        properties._sectionLevel._sectionTypes.push_back(section_->type());
-        newIds[sectionId] = sectionIdOnDisk++;
-        _appendProperties(properties._pointLevel, section_->_pointProperties);
+    if (_cellProperties) {
+        properties._cellLevel = *_cellProperties;
+        properties._cellLevel._somaType = _soma->type();
+    }
+    // Other morphologies may share the soma: it is only moved from its last owner
+    if (_soma.use_count() == 1) {
+        properties._somaLevel = std::move(_soma->_pointProperties);
+    } else {
+        properties._somaLevel = _soma->_pointProperties;
     }
+    _buildSectionLevels(properties, true);
 
     mitochondria()._buildMitochondria(properties);
-    properties._annotations = annotations();
+    properties._annotations = std::move(_annotations);
     properties._endoplasmicReticulumLevel = endoplasmicReticulum().buildReadOnly();
     return properties;
 }
 
+MemoryUsage Morphology::memoryUsage() const {
+    MemoryUsage usage;
+    detail::MemoryCounter counter(usage);
+    usage.objects = counter.block(detail::sharedObjectBytes<Soma>());
+    if (_sectionArena) {
+        usage.objects += counter.block(detail::sharedObjectBytes<SectionArena>());
+        // Chunks are heap blocks of their own
+        usage.allocatorOverhead += _sectionArena->chunkCount() * detail::kAllocationOverhead;
+        usage.sections = _sectionArena->reservedBytes();
+    }
+    usage.sections += counter.mapNodes(_sections) + counter.vector(_rootSections);
+
+    std::set<const Property::Properties*> sources;
+    for (const auto& kv : _sections) {
+        const Section& section_ = *kv.second;
+        if (section_._sharedPoints() != nullptr) {
+            sources.insert(section_._source.get());
+        } else {
+            usage.points += counter.pointLevel(section_._pointProperties);
+        }
+    }
+    for (const Property::Properties* source : sources) {
+        usage += source->memoryUsage();
+        usage.objects += counter.block(detail::sharedObjectBytes<Property::Properties>());
+    }
+
+    usage.soma += counter.pointLevel(_soma->_pointProperties);
+    usage.children += counter.vector(_parent) + counter.vector(_children);
+    for (const auto& children : _children) {
+        usage.children += counter.vector(children);
+    }
+    usage.annotations += counter.annotations(_annotations);
+    if (_cellProperties) {
+        usage.objects += counter.block(detail::sharedObjectBytes<Property::CellLevel>());
+        usage.annotations += counter.annotations(_cellProperties->annotation);
+    }
+    usage += _mitochondria.memoryUsage();
+
+    const EndoplasmicReticulum& reticulum = _endoplasmicReticulum;
+    usage.endoplasmicReticulum += counter.vector(reticulum.sectionIndices()) +
+                                  counter.vector(reticulum.volumes()) +
+                                  counter.vector(reticulum.surfaceAreas()) +
+                                  counter.vector(reticulum.filamentCounts());
+    return usage;
+}
+
+void Morphology::shrinkToFit() {
+    for (const auto& kv : _sections) {
+        if (kv.second->_sharedPoints() == nullptr) {
+            detail::shrinkToFit(kv.second->_pointProperties);
+        }
+    }
+    detail::shrinkToFit(_soma->_pointProperties);
+    _rootSections.shrink_to_fit();
+    _parent.shrink_to_fit();
+    _children.shrink_to_fit();
+    for (auto& children : _children) {
+        children.shrink_to_fit();
+    }
+    detail::shrinkToFit(_annotations);
+    _mitochondria.shrinkToFit();
+    _endoplasmicReticulum.sectionIndices().shrink_to_fit();
+    _endoplasmicReticulum.volumes().shrink_to_fit();
+    _endoplasmicReticulum.surfaceAreas().shrink_to_fit();
+    _endoplasmicReticulum.filamentCounts().shrink_to_fit();
+}
+
 depth_iterator Morphology::depth_begin() const {
     return depth_iterator(*this);
 }
@@ -330,11 +561,14 @@ std::unordered_map<int, std::vector<unsigned int>> Morphology::connectivity() {
                    std::back_inserter(connectivity[-1]),
                    [](const std::shared_ptr<Section>& section) { return section->id(); });
 
-    for (const auto& kv : _children) {
-        auto& nodeEdges = connectivity[static_cast<int>(kv.first)];
-        nodeEdges.reserve(kv.second.size());
-        std::transform(kv.second.begin(),
-                       kv.second.end(),
+    for (uint32_t id = 0; id < _children.size(); ++id) {
+        const auto& children = _children[id];
+        if (children.empty())
+            continue;
+        auto& nodeEdges = connectivity[static_cast<int>(id)];
+        nodeEdges.reserve(children.size());
+        std::transform(children.begin(),
+                       children.end(),
                        std::back_inserter(nodeEdges),
                        [](const std::shared_ptr<Section>& section) { return section->id(); });
     }
@@ -366,6 +600,8 @@ void Morphology::write(const std::string& filename) {
         writer::asc(clean, filename);
     else if (extension == ".swc")
         writer::swc(clean, filename);
+    else if (extension == ".mbin")
+        writer::binary(clean, filename);
     else
         throw UnknownFileType(_err.ERROR_WRONG_EXTENSION(filename));
 }
@@ -5,14 +5,12 @@
 #include <morphio/mut/section.h>
 #include <morphio/tools.h>
 
+#include "section_arena.h"
+
 namespace morphio {
 namespace mut {
 using morphio::readers::ErrorMessages;
 
-static inline bool _emptySection(const std::shared_ptr<Section>& section) {
-    return section->points().empty();
-}
-
 Section::Section(Morphology* morphology,
                  unsigned int id_,
                  SectionType type_,
@@ -23,36 +21,73 @@ Section::Section(Morphology* morphology,
     , _sectionType(type_) {}
 
 Section::Section(Morphology* morphology, unsigned int id_, const morphio::Section& section_)
-    : Section(morphology,
-              id_,
-              section_.type(),
-              Property::PointLevel(section_._properties->_pointLevel, section_._range)) {}
+    : _morphology(morphology)
+    , _source(section_._properties)
+    , _sourceRange(section_._range)
+    , _shared(true)
+    , _id(id_)
+    , _sectionType(section_.type()) {}
 
 Section::Section(Morphology* morphology, unsigned int id_, const Section& section_)
     : _morphology(morphology)
-    , _pointProperties(section_._pointProperties)
     , _id(id_)
-    , _sectionType(section_._sectionType) {}
+    , _sectionType(section_._sectionType) {
+    // A copy of a section still sharing its points shares them too
+    if (section_._sharedPoints() != nullptr) {
+        _source = section_._source;
+        _sourceRange = section_._sourceRange;
+        _shared = true;
+    } else {
+        _pointProperties = section_._pointProperties;
+    }
+}
+
+void Section::_copySharedPoints() const noexcept {
+    // Const accessors materialize too, possibly from several threads
+    std::call_once(_materializeOnce, [this]() {
+        _pointProperties = Property::PointLevel(_source->_pointLevel, _sourceRange);
+        _shared.store(false, std::memory_order_release);
+    });
+}
+
+range<const Point> Section::_pointsView() const noexcept {
+    if (const Property::PointLevel* shared = _sharedPoints()) {
+        return {shared->_points.data() + _sourceRange.first,
+                _sourceRange.second - _sourceRange.first};
+    }
+    return {_pointProperties._points.data(), _pointProperties._points.size()};
+}
+
+range<const floatType> Section::_diametersView() const noexcept {
+    if (const Property::PointLevel* shared = _sharedPoints()) {
+        return {shared->_diameters.data() + _sourceRange.first,
+                _sourceRange.second - _sourceRange.first};
+    }
+    return {_pointProperties._diameters.data(), _pointProperties._diameters.size()};
+}
+
+range<const floatType> Section::_perimetersView() const noexcept {
+    if (const Property::PointLevel* shared = _sharedPoints()) {
+        if (shared->_perimeters.empty()) {
+            return {};
+        }
+        return {shared->_perimeters.data() + _sourceRange.first,
+                _sourceRange.second - _sourceRange.first};
+    }
+    return {_pointProperties._perimeters.data(), _pointProperties._perimeters.size()};
+}
 
 const std::shared_ptr<Section>& Section::parent() const {
+    // Throws std::out_of_range for root sections, NO_PARENT is not a section id
     return _morphology->_sections.at(_morphology->_parent.at(id()));
 }
 
 bool Section::isRoot() const {
-    const auto parentId = _morphology->_parent.find(id());
-    if (parentId != _morphology->_parent.end()) {
-        return _morphology->_sections.find(parentId->second) == _morphology->_sections.end();
-    }
-    return true;
+    return _morphology->_parent.at(id()) == Morphology::NO_PARENT;
 }
 
 const std::vector<std::shared_ptr<Section>>& Section::children() const {
-    const auto it = _morphology->_children.find(id());
-    if (it == _morphology->_children.end()) {
-        static std::vector<std::shared_ptr<Section>> empty;
-        return empty;
-    }
-    return it->second;
+    return _morphology->_children.at(id());
 }
 
 depth_iterator Section::depth_begin() const {
@@ -91,22 +126,20 @@ std::ostream& operator<<(std::ostream& os, const std::shared_ptr<Section>& secti
 
 std::shared_ptr<Section> Section::appendSection(const std::shared_ptr<Section>& original_section,
                                                 bool recursive) {
-    const std::shared_ptr<Section> ptr(
-        new Section(_morphology, _morphology->_counter, *original_section));
+    const std::shared_ptr<Section> ptr = _morphology->_createSection(*original_section);
     unsigned int parentId = id();
     uint32_t childId = _morphology->_register(ptr);
     auto& _sections = _morphology->_sections;
 
-    bool emptySection = _emptySection(_sections[childId]);
+    bool emptySection = _sections[childId]->_pointsView().empty();
     if (emptySection)
-        printError(Warning::APPENDING_EMPTY_SECTION,
-                   _morphology->_err.WARNING_APPENDING_EMPTY_SECTION(_sections[childId]));
+        printError(readers::AppendingEmptySectionWarning(_morphology->_err, _sections[childId]));
 
     if (!ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) && !emptySection &&
         !_checkDuplicatePoint(_sections[parentId], _sections[childId])) {
-        printError(Warning::WRONG_DUPLICATE,
-                   _morphology->_err.WARNING_WRONG_DUPLICATE(_sections[childId],
-                                                             _sections.at(parentId)));
+        printError(readers::WrongDuplicateWarning(_morphology->_err,
+                                                  _sections[childId],
+                                                  _sections.at(parentId)));
     }
 
     _morphology->_parent[childId] = parentId;
@@ -122,21 +155,20 @@ std::shared_ptr<Section> Section::appendSection(const std::shared_ptr<Section>&
 }
 
 std::shared_ptr<Section> Section::appendSection(const morphio::Section& section, bool recursive) {
-    const std::shared_ptr<Section> ptr(new Section(_morphology, _morphology->_counter, section));
+    const std::shared_ptr<Section> ptr = _morphology->_createSection(section);
     unsigned int parentId = id();
     uint32_t childId = _morphology->_register(ptr);
     auto& _sections = _morphology->_sections;
 
-    bool emptySection = _emptySection(_sections[childId]);
+    bool emptySection = _sections[childId]->_pointsView().empty();
     if (emptySection)
-        printError(Warning::APPENDING_EMPTY_SECTION,
-                   _morphology->_err.WARNING_APPENDING_EMPTY_SECTION(_sections[childId]));
+        printError(readers::AppendingEmptySectionWarning(_morphology->_err, _sections[childId]));
 
     if (!ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) && !emptySection &&
         !_checkDuplicatePoint(_sections[parentId], _sections[childId]))
-        printError(Warning::WRONG_DUPLICATE,
-                   _morphology->_err.WARNING_WRONG_DUPLICATE(_sections[childId],
-                                                             _sections.at(parentId)));
+        printError(readers::WrongDuplicateWarning(_morphology->_err,
+                                                  _sections[childId],
+                                                  _sections.at(parentId)));
 
     _morphology->_parent[childId] = parentId;
     _morphology->_children[parentId].push_back(ptr);
@@ -161,21 +193,19 @@ std::shared_ptr<Section> Section::appendSection(const Property::PointLevel& poin
     if (sectionType == SECTION_SOMA)
         throw morphio::SectionBuilderError("Cannot create section with type soma");
 
-    std::shared_ptr<Section> ptr(
-        new Section(_morphology, _morphology->_counter, sectionType, pointProperties));
+    std::shared_ptr<Section> ptr = _morphology->_createSection(sectionType, pointProperties);
 
     uint32_t childId = _morphology->_register(ptr);
 
-    bool emptySection = _emptySection(_sections[childId]);
+    bool emptySection = _sections[childId]->_pointsView().empty();
     if (emptySection)
-        printError(Warning::APPENDING_EMPTY_SECTION,
-                   _morphology->_err.WARNING_APPENDING_EMPTY_SECTION(_sections[childId]));
+        printError(readers::AppendingEmptySectionWarning(_morphology->_err, _sections[childId]));
 
     if (!ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) && !emptySection &&
         !_checkDuplicatePoint(_sections[parentId], _sections[childId]))
-        printError(Warning::WRONG_DUPLICATE,
-                   _morphology->_err.WARNING_WRONG_DUPLICATE(_sections[childId],
-                                                             _sections[parentId]));
+        printError(readers::WrongDuplicateWarning(_morphology->_err,
+                                                  _sections[childId],
+                                                  _sections[parentId]));
 
     _morphology->_parent[childId] = parentId;
     _morphology->_children[parentId].push_back(ptr);
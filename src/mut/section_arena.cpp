@@ -0,0 +1,69 @@
+#include "section_arena.h"
+
+namespace morphio {
+namespace mut {
+
+constexpr size_t SectionArena::kAlignment;
+constexpr size_t SectionArena::kChunkSize;
+
+SectionArena::FreeBlock*& SectionArena::_freeList(size_t bytes) {
+    for (auto& freeList : _freeLists) {
+        if (freeList.first == bytes) {
+            return freeList.second;
+        }
+    }
+    _freeLists.emplace_back(bytes, nullptr);
+    return _freeLists.back().second;
+}
+
+void* SectionArena::allocate(size_t bytes) {
+    bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    FreeBlock*& freeList = _freeList(bytes);
+    if (freeList != nullptr) {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        return block;
+    }
+
+    if (bytes > kChunkSize / 4) {
+        // Too big to be carved out of a chunk, give it its own
+        _chunks.emplace_back(new char[bytes]);
+        _reservedBytes += bytes;
+        return _chunks.back().get();
+    }
+
+    if (_cursor == nullptr || static_cast<size_t>(_end - _cursor) < bytes) {
+        // The tail of the previous chunk is lost, at most kChunkSize / 4 bytes
+        _chunks.emplace_back(new char[kChunkSize]);
+        _reservedBytes += kChunkSize;
+        _cursor = _chunks.back().get();
+        _end = _cursor + kChunkSize;
+    }
+    void* block = _cursor;
+    _cursor += bytes;
+    return block;
+}
+
+void SectionArena::deallocate(void* pointer, size_t bytes) noexcept {
+    bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    FreeBlock*& freeList = _freeList(bytes);
+    FreeBlock* block = new (pointer) FreeBlock{freeList};
+    freeList = block;
+}
+
+size_t SectionArena::reservedBytes() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _reservedBytes;
+}
+
+size_t SectionArena::chunkCount() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _chunks.size();
+}
+
+}  // namespace mut
+}  // namespace morphio
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>  // std::max_align_t
+#include <memory>   // std::shared_ptr, std::unique_ptr
+#include <mutex>    // std::mutex
+#include <new>      // placement new
+#include <utility>  // std::forward, std::pair
+#include <vector>   // std::vector
+
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+
+namespace morphio {
+namespace mut {
+
+/**
+   Pool backing the Section objects of a mut::Morphology and their shared_ptr control blocks.
+
+   Memory is carved out of large chunks and recycled through one free list per block size, so
+   that building or editing a morphology does not go through malloc for every section. All the
+   chunks are released at once when the arena dies: the Morphology and every Section it handed
+   out each hold a reference to it.
+
+   Sections can be released from any thread, hence the lock.
+**/
+class SectionArena
+{
+  public:
+    SectionArena() = default;
+    SectionArena(const SectionArena&) = delete;
+    SectionArena& operator=(const SectionArena&) = delete;
+
+    void* allocate(size_t bytes);
+    void deallocate(void* pointer, size_t bytes) noexcept;
+
+    /** The bytes of the chunks, used or not **/
+    size_t reservedBytes();
+    /** The number of chunks **/
+    size_t chunkCount();
+
+  private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t kAlignment = alignof(std::max_align_t);
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    FreeBlock*& _freeList(size_t bytes);
+
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    char* _cursor = nullptr;
+    char* _end = nullptr;
+    size_t _reservedBytes = 0;
+    // (block size, first free block): only a couple of sizes are ever requested
+    std::vector<std::pair<size_t, FreeBlock*>> _freeLists;
+};
+
+/** Standard allocator for the shared_ptr control blocks; keeps the arena alive **/
+template <typename T>
+class SectionArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit SectionArenaAllocator(std::shared_ptr<SectionArena> arena) noexcept
+        : _arena(std::move(arena)) {}
+
+    template <typename U>
+    SectionArenaAllocator(const SectionArenaAllocator<U>& other) noexcept
+        : _arena(other._arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept {
+        _arena->deallocate(pointer, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SectionArenaAllocator<U>& other) const noexcept {
+        return _arena == other._arena;
+    }
+
+    template <typename U>
+    bool operator!=(const SectionArenaAllocator<U>& other) const noexcept {
+        return _arena != other._arena;
+    }
+
+  private:
+    template <typename U>
+    friend class SectionArenaAllocator;
+
+    std::shared_ptr<SectionArena> _arena;
+};
+
+/**
+   shared_ptr deleter of the arena sections
+
+   A raw pointer is enough: the control block, which owns the deleter, also owns an allocator
+   referencing the arena
+**/
+struct SectionArenaDeleter {
+    SectionArena* arena;
+
+    void operator()(Section* section) const noexcept {
+        section->~Section();
+        arena->deallocate(section, sizeof(Section));
+    }
+};
+
+template <typename... Args>
+std::shared_ptr<Section> Morphology::_createSection(Args&&... args) {
+    if (!_sectionArena) {
+        _sectionArena = std::make_shared<SectionArena>();
+    }
+
+    void* memory = _sectionArena->allocate(sizeof(Section));
+    Section* section = nullptr;
+    try {
+        section = new (memory) Section(this, _counter, std::forward<Args>(args)...);
+    } catch (...) {
+        _sectionArena->deallocate(memory, sizeof(Section));
+        throw;
+    }
+    // Should the control block allocation fail, shared_ptr calls the deleter
+    return std::shared_ptr<Section>(section,
+                                    SectionArenaDeleter{_sectionArena.get()},
+                                    SectionArenaAllocator<Section>(_sectionArena));
+}
+
+}  // namespace mut
+}  // namespace morphio
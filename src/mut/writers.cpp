@@ -8,6 +8,8 @@
 #include <morphio/mut/writers.h>
 #include <morphio/version.h>
 
+#include "../readers/morphologyBinary.h"
+
 #include <highfive/H5DataSet.hpp>
 #include <highfive/H5File.hpp>
 #include <highfive/H5Object.hpp>
@@ -386,6 +388,22 @@ void h5(const Morphology& morpho, const std::string& filename) {
     endoplasmicReticulumH5(h5_file, morpho.endoplasmicReticulum());
 }
 
+void binary(const Morphology& morpho, const std::string& filename) {
+    if (morpho.soma()->points().empty() && morpho.rootSections().empty()) {
+        printError(Warning::WRITE_EMPTY_MORPHOLOGY,
+                   readers::ErrorMessages().WARNING_WRITE_EMPTY_MORPHOLOGY());
+        return;
+    }
+
+    const std::vector<char> buffer = readers::binary::serialize(morpho.buildReadOnly());
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file) {
+        throw WriterError("Could not write file: " + filename);
+    }
+}
+
 }  // end namespace writer
 }  // end namespace mut
 }  // end namespace morphio
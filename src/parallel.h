@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>  // std::min, std::max
+#include <cstddef>    // size_t
+#include <exception>  // std::exception_ptr
+#include <thread>     // std::thread
+#include <vector>     // std::vector
+
+namespace morphio {
+namespace detail {
+
+/** Below this many points per thread, starting threads costs more than it saves **/
+constexpr size_t kMinPointsPerThread = 1 << 16;
+
+/** Number of threads used when the caller asks for 0 threads **/
+inline unsigned int defaultThreadCount() {
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+/**
+   Number of threads to use for `size` items of work: nThreads if not 0, otherwise one thread per
+   `minPerThread` items, at most one per core and at least one
+**/
+inline unsigned int threadCount(size_t size, size_t minPerThread, unsigned int nThreads) {
+    if (nThreads != 0) {
+        return nThreads;
+    }
+    const size_t useful = std::max(size / minPerThread, size_t{1});
+    return static_cast<unsigned int>(std::min(useful, static_cast<size_t>(defaultThreadCount())));
+}
+
+/**
+   Split [0, size) into contiguous chunks and call function(begin, end) on each of them from
+   its own thread. The work is done in the calling thread when a single chunk is enough.
+
+   An exception thrown by one of the chunks is rethrown in the calling thread once all the
+   threads have been joined.
+**/
+template <typename Function>
+void parallelFor(size_t size, unsigned int nThreads, Function function) {
+    if (nThreads == 0) {
+        nThreads = defaultThreadCount();
+    }
+    const size_t nChunks = std::min(static_cast<size_t>(nThreads), size);
+    if (nChunks <= 1) {
+        function(size_t{0}, size);
+        return;
+    }
+
+    const size_t chunkSize = (size + nChunks - 1) / nChunks;
+    std::vector<std::exception_ptr> errors(nChunks);
+    std::vector<std::thread> threads;
+    threads.reserve(nChunks);
+    for (size_t i = 0; i < nChunks; ++i) {
+        const size_t begin = i * chunkSize;
+        const size_t end = std::min(size, begin + chunkSize);
+        if (begin >= end) {
+            break;
+        }
+        threads.emplace_back([&function, &errors, i, begin, end]() {
+            try {
+                function(begin, end);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace morphio
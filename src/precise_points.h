@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <cstdint>    // uint32_t
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+#include <morphio/errorMessages.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace detail {
+
+/**
+   The points, diameters and perimeters of the sections of a mut::Morphology in precision T,
+   indexed by section id.
+
+   For load_as<T>, T other than floatType, the readers parse the values of the file again in T.
+   The morphology itself is built and sanitized in floatType, which decides the structure and the
+   warnings: these values go through the same appends and merges, so that build() lays them out
+   as buildReadOnly lays out the sections.
+**/
+template <typename T>
+class PrecisePoints
+{
+  public:
+    PrecisePoints() = default;
+
+    /**
+       The sections of mut::Morphology(Morphology(properties)), geometry holding the points of
+       properties in precision T. The children of properties must be built: the mutable
+       morphology numbers the sections it copies depth first, one root after the other
+    **/
+    PrecisePoints(const Property::Properties& properties, Property::GeometryT<T>& geometry)
+        : _soma(std::move(geometry._somaLevel)) {
+        _copy(properties, geometry._pointLevel, -1);
+        geometry._pointLevel = Property::PointLevelT<T>();
+    }
+
+    Property::PointLevelT<T>& section(uint32_t id) {
+        if (id >= _sections.size()) {
+            _sections.resize(id + 1);
+        }
+        return _sections[id];
+    }
+
+    Property::PointLevelT<T>& soma() noexcept {
+        return _soma;
+    }
+
+    /** Sanitize morphology, see mut::Morphology::sanitize, and merge the values along **/
+    void sanitize(mut::Morphology& morphology, const readers::DebugInfo& debugInfo) {
+        morphology._sanitize(debugInfo, true, [this](uint32_t head, uint32_t id, bool duplicate) {
+            _merge(head, id, duplicate);
+        });
+    }
+
+    /** The point and soma levels of morphology.buildReadOnly(), in precision T **/
+    void build(const mut::Morphology& morphology, Property::GeometryT<T>& geometry) {
+        size_t nPoints = 0;
+        for (const auto& level : _sections) {
+            nPoints += level._points.size();
+        }
+        auto& pointLevel = geometry._pointLevel;
+        pointLevel._points.reserve(nPoints);
+        pointLevel._diameters.reserve(nPoints);
+        for (auto it = morphology.depth_begin(); it != morphology.depth_end(); ++it) {
+            Property::PointLevelT<T>& level = section((*it)->id());
+            _append(pointLevel._points, level._points, 0);
+            _append(pointLevel._diameters, level._diameters, 0);
+            _append(pointLevel._perimeters, level._perimeters, 0);
+            level = Property::PointLevelT<T>();
+        }
+        geometry._somaLevel = std::move(_soma);
+    }
+
+  private:
+    template <typename U>
+    static void _append(std::vector<U>& to, const std::vector<U>& from, size_t skip) {
+        to.insert(to.end(),
+                  from.begin() + static_cast<std::ptrdiff_t>(std::min(skip, from.size())),
+                  from.end());
+    }
+
+    // As the second pass of mut::Morphology::sanitize: the head of the chain gets the values
+    // of the section, without the first one if it duplicates the last point of the head
+    void _merge(uint32_t head, uint32_t id, bool duplicate) {
+        section(std::max(head, id));
+        const Property::PointLevelT<T> from = std::move(_sections[id]);
+        _sections[id] = Property::PointLevelT<T>();
+        Property::PointLevelT<T>& to = _sections[head];
+        const size_t skip = duplicate ? 1 : 0;
+        _append(to._points, from._points, skip);
+        _append(to._diameters, from._diameters, skip);
+        if (!to._perimeters.empty()) {
+            _append(to._perimeters, from._perimeters, skip);
+        }
+    }
+
+    void _copy(const Property::Properties& properties,
+               const Property::PointLevelT<T>& points,
+               int32_t parent) {
+        const auto& children = properties.children<Property::Section>();
+        const auto found = children.find(parent);
+        if (found == children.end()) {
+            return;
+        }
+        const auto& sections = properties._sectionLevel._sections;
+        for (const uint32_t id : found->second) {
+            const size_t end = id + 1 < sections.size()
+                                   ? static_cast<size_t>(sections[id + 1][0])
+                                   : points._points.size();
+            const SectionRange range(static_cast<size_t>(sections[id][0]), end);
+            _sections.emplace_back(points, range);
+            _copy(properties, points, static_cast<int32_t>(id));
+        }
+    }
+
+    std::vector<Property::PointLevelT<T>> _sections;
+    Property::PointLevelT<T> _soma;
+};
+
+}  // namespace detail
+}  // namespace morphio
@@ -6,13 +6,28 @@
 #include <morphio/shared_utils.tpp>
 #include <morphio/vector_types.h>
 
+#include "content_hash.h"
+#include "memory.h"
+
 
 namespace morphio {
 namespace Property {
 
-PointLevel::PointLevel(std::vector<Point::Type> points,
-                       std::vector<Diameter::Type> diameters,
-                       std::vector<Perimeter::Type> perimeters)
+namespace {
+template <typename T>
+std::vector<T> copyRange(const std::vector<T>& data, SectionRange range) {
+    if (data.empty())
+        return {};
+
+    return {data.begin() + static_cast<long int>(range.first),
+            data.begin() + static_cast<long int>(range.second)};
+}
+}  // namespace
+
+template <typename T>
+PointLevelT<T>::PointLevelT(std::vector<PointT<T>> points,
+                            std::vector<T> diameters,
+                            std::vector<T> perimeters)
     : _points(std::move(points))
     , _diameters(std::move(diameters))
     , _perimeters(std::move(perimeters)) {
@@ -27,16 +42,18 @@ PointLevel::PointLevel(std::vector<Point::Type> points,
             " while Perimeter vector has size: " + std::to_string(_perimeters.size()));
 }
 
-PointLevel::PointLevel(const PointLevel& data)
-    : PointLevel(data._points, data._diameters, data._perimeters) {}
+template <typename T>
+PointLevelT<T>::PointLevelT(const PointLevelT& data)
+    : PointLevelT(data._points, data._diameters, data._perimeters) {}
 
-PointLevel::PointLevel(const PointLevel& data, SectionRange range) {
-    _points = copySpan<Property::Point>(data._points, range);
-    _diameters = copySpan<Property::Diameter>(data._diameters, range);
-    _perimeters = copySpan<Property::Perimeter>(data._perimeters, range);
-}
+template <typename T>
+PointLevelT<T>::PointLevelT(const PointLevelT& data, SectionRange range)
+    : _points(copyRange(data._points, range))
+    , _diameters(copyRange(data._diameters, range))
+    , _perimeters(copyRange(data._perimeters, range)) {}
 
-PointLevel& PointLevel::operator=(const PointLevel& other) {
+template <typename T>
+PointLevelT<T>& PointLevelT<T>::operator=(const PointLevelT& other) {
     if (&other == this)
         return *this;
 
@@ -46,6 +63,9 @@ PointLevel& PointLevel::operator=(const PointLevel& other) {
     return *this;
 }
 
+template struct PointLevelT<float>;
+template struct PointLevelT<double>;
+
 template <typename T>
 bool compare(const std::vector<T>& vec1,
              const std::vector<T>& vec2,
@@ -289,7 +309,19 @@ Annotation::Annotation(AnnotationType type,
     , _sectionId(sectionId)
     , _points(std::move(points))
     , _lineNumber(lineNumber)
-    , _details(std::move(details)) {}
+    , _details(std::move(details))
+    , _pointRange(0, 0) {}
+
+Annotation::Annotation(AnnotationType type,
+                       uint32_t sectionId,
+                       SectionRange pointRange,
+                       std::string details,
+                       int32_t lineNumber)
+    : _type(type)
+    , _sectionId(sectionId)
+    , _lineNumber(lineNumber)
+    , _details(std::move(details))
+    , _pointRange(pointRange) {}
 
 template <>
 std::vector<Section::Type>& Properties::get<Section>() noexcept {
@@ -390,6 +422,84 @@ const std::map<int32_t, std::vector<uint32_t>>& Properties::children<MitoSection
     return _mitochondriaSectionLevel._children;
 }
 
+MemoryUsage Properties::memoryUsage() const {
+    MemoryUsage usage;
+    detail::MemoryCounter counter(usage);
+    usage.points = counter.pointLevel(_pointLevel);
+    usage.soma = counter.pointLevel(_somaLevel);
+    usage.sections = counter.vector(_sectionLevel._sections) +
+                     counter.vector(_sectionLevel._sectionTypes);
+    usage.children = counter.children(_sectionLevel._children);
+    usage.annotations = counter.annotations(_annotations) +
+                        counter.annotations(_cellLevel.annotation);
+
+    const auto& mitoPoints = _mitochondriaPointLevel;
+    usage.mitochondria = counter.vector(mitoPoints._sectionIds) +
+                         counter.vector(mitoPoints._relativePathLengths) +
+                         counter.vector(mitoPoints._diameters) +
+                         counter.vector(_mitochondriaSectionLevel._sections) +
+                         counter.children(_mitochondriaSectionLevel._children);
+
+    const auto& reticulum = _endoplasmicReticulumLevel;
+    usage.endoplasmicReticulum = counter.vector(reticulum._sectionIndices) +
+                                 counter.vector(reticulum._volumes) +
+                                 counter.vector(reticulum._surfaceAreas) +
+                                 counter.vector(reticulum._filamentCounts);
+    return usage;
+}
+
+uint64_t Properties::contentHash(const HashOptions& options) const {
+    detail::ContentHasher hasher(options.tolerance);
+    hasher.add(static_cast<int32_t>(_cellLevel._cellFamily));
+    hasher.add(static_cast<int32_t>(_cellLevel._somaType));
+    hasher.add(_sectionLevel._sections);
+    hasher.add(_sectionLevel._sectionTypes);
+    hasher.addSize(_pointLevel._points.size());
+    hasher.addSize(_pointLevel._perimeters.size());
+    hasher.addSize(_somaLevel._points.size());
+
+    if (options.points) {
+        hasher.add(_pointLevel._points);
+        hasher.add(_pointLevel._diameters);
+        hasher.add(_pointLevel._perimeters);
+        hasher.add(_somaLevel._points);
+        hasher.add(_somaLevel._diameters);
+    }
+
+    if (options.organelles) {
+        hasher.add(_mitochondriaPointLevel._sectionIds);
+        hasher.add(_mitochondriaPointLevel._relativePathLengths);
+        hasher.add(_mitochondriaPointLevel._diameters);
+        hasher.add(_mitochondriaSectionLevel._sections);
+        hasher.add(_endoplasmicReticulumLevel._sectionIndices);
+        hasher.add(_endoplasmicReticulumLevel._volumes);
+        hasher.add(_endoplasmicReticulumLevel._surfaceAreas);
+        hasher.add(_endoplasmicReticulumLevel._filamentCounts);
+    }
+    return hasher.digest();
+}
+
+void Properties::shrinkToFit() {
+    detail::shrinkToFit(_pointLevel);
+    detail::shrinkToFit(_somaLevel);
+    _sectionLevel._sections.shrink_to_fit();
+    _sectionLevel._sectionTypes.shrink_to_fit();
+    detail::shrinkToFit(_sectionLevel._children);
+    detail::shrinkToFit(_annotations);
+    detail::shrinkToFit(_cellLevel.annotation);
+
+    _mitochondriaPointLevel._sectionIds.shrink_to_fit();
+    _mitochondriaPointLevel._relativePathLengths.shrink_to_fit();
+    _mitochondriaPointLevel._diameters.shrink_to_fit();
+    _mitochondriaSectionLevel._sections.shrink_to_fit();
+    detail::shrinkToFit(_mitochondriaSectionLevel._children);
+
+    _endoplasmicReticulumLevel._sectionIndices.shrink_to_fit();
+    _endoplasmicReticulumLevel._volumes.shrink_to_fit();
+    _endoplasmicReticulumLevel._surfaceAreas.shrink_to_fit();
+    _endoplasmicReticulumLevel._filamentCounts.shrink_to_fit();
+}
+
 std::ostream& operator<<(std::ostream& os, const PointLevel& prop) {
     os << "Point level properties:\n"
        << "Point Diameter"
@@ -0,0 +1,162 @@
+#include <algorithm>  // std::minmax_element
+#include <cmath>      // std::fabs, std::lround
+#include <limits>     // std::numeric_limits
+
+#include <morphio/quantized_point_level.h>
+
+#include "memory.h"
+
+namespace morphio {
+namespace Property {
+namespace {
+
+constexpr double kMaxQuantized = std::numeric_limits<uint16_t>::max();
+
+/** Round value to T; a template, as the cast is a no-op when floatType is double **/
+template <typename T>
+T narrow(double value) noexcept {
+    return static_cast<T>(value);
+}
+
+/** The fixed point encoding of values within [min, max] **/
+struct Quantizer {
+    floatType offset = 0;
+    floatType step = 0;
+    floatType tolerance = 0;
+
+    Quantizer() = default;
+    Quantizer(floatType min, floatType max) {
+        // Computed in double, whatever floatType is
+        const double min_ = min;
+        const double max_ = max;
+        const double extent = max_ - min_;
+        offset = min;
+        step = narrow<floatType>(extent / kMaxQuantized);
+        // Half a step, and the rounding of the step and of the decoding in floatType
+        const double epsilon_ = std::numeric_limits<floatType>::epsilon();
+        const double step_ = step;
+        const double rounding = 4 * epsilon_ * (std::fabs(min_) + extent);
+        tolerance = narrow<floatType>(step_ / 2 + rounding);
+    }
+
+    uint16_t encode(floatType value) const noexcept {
+        if (step == 0) {
+            return 0;
+        }
+        const double value_ = value;
+        const double offset_ = offset;
+        const double step_ = step;
+        const double steps = (value_ - offset_) / step_;
+        return static_cast<uint16_t>(std::min(std::max(std::lround(steps), 0L), 65535L));
+    }
+};
+
+inline floatType decodeValue(uint16_t value, floatType offset, floatType step) noexcept {
+    return offset + static_cast<floatType>(value) * step;
+}
+
+Quantizer makeQuantizer(const std::vector<floatType>& values) {
+    if (values.empty()) {
+        return {};
+    }
+    const auto bounds = std::minmax_element(values.begin(), values.end());
+    return {*bounds.first, *bounds.second};
+}
+
+std::vector<uint16_t> encodeValues(const std::vector<floatType>& values,
+                                   const Quantizer& quantizer) {
+    std::vector<uint16_t> encoded;
+    encoded.reserve(values.size());
+    for (const auto value : values) {
+        encoded.push_back(quantizer.encode(value));
+    }
+    return encoded;
+}
+
+}  // namespace
+
+QuantizedPointLevel::QuantizedPointLevel(const PointLevel& level) {
+    std::array<Quantizer, 3> axes;
+    if (!level._points.empty()) {
+        BoundingBox box{level._points[0], level._points[0]};
+        for (const auto& point : level._points) {
+            box.expand(point);
+        }
+        for (size_t axis = 0; axis < 3; ++axis) {
+            axes[axis] = Quantizer(box.min[axis], box.max[axis]);
+            _offset[axis] = axes[axis].offset;
+            _step[axis] = axes[axis].step;
+            _pointTolerance = std::max(_pointTolerance, axes[axis].tolerance);
+        }
+    }
+
+    _points.reserve(level._points.size());
+    for (const auto& point : level._points) {
+        _points.push_back(
+            {{axes[0].encode(point[0]), axes[1].encode(point[1]), axes[2].encode(point[2])}});
+    }
+
+    const Quantizer diameters = makeQuantizer(level._diameters);
+    _diameters = encodeValues(level._diameters, diameters);
+    _diameterOffset = diameters.offset;
+    _diameterStep = diameters.step;
+    _diameterTolerance = diameters.tolerance;
+
+    const Quantizer perimeters = makeQuantizer(level._perimeters);
+    _perimeters = encodeValues(level._perimeters, perimeters);
+    _perimeterOffset = perimeters.offset;
+    _perimeterStep = perimeters.step;
+    _perimeterTolerance = perimeters.tolerance;
+}
+
+morphio::Point QuantizedPointLevel::point(size_t index) const noexcept {
+    const auto& point = _points[index];
+    return {{decodeValue(point[0], _offset[0], _step[0]),
+             decodeValue(point[1], _offset[1], _step[1]),
+             decodeValue(point[2], _offset[2], _step[2])}};
+}
+
+floatType QuantizedPointLevel::diameter(size_t index) const noexcept {
+    return decodeValue(_diameters[index], _diameterOffset, _diameterStep);
+}
+
+floatType QuantizedPointLevel::perimeter(size_t index) const noexcept {
+    if (_perimeters.empty()) {
+        return 0;
+    }
+    return decodeValue(_perimeters[index], _perimeterOffset, _perimeterStep);
+}
+
+PointLevel QuantizedPointLevel::decode() const {
+    PointLevel level;
+    decode({0, size()}, level);
+    return level;
+}
+
+void QuantizedPointLevel::decode(SectionRange range, PointLevel& buffer) const {
+    buffer._points.clear();
+    buffer._diameters.clear();
+    buffer._perimeters.clear();
+    buffer._points.reserve(range.second - range.first);
+    buffer._diameters.reserve(range.second - range.first);
+    for (size_t i = range.first; i < range.second; ++i) {
+        buffer._points.push_back(point(i));
+        buffer._diameters.push_back(diameter(i));
+    }
+    if (!_perimeters.empty()) {
+        for (size_t i = range.first; i < range.second; ++i) {
+            buffer._perimeters.push_back(perimeter(i));
+        }
+    }
+}
+
+MemoryUsage QuantizedPointLevel::memoryUsage() const {
+    MemoryUsage usage;
+    detail::MemoryCounter counter(usage);
+    usage.points = counter.vector(_points) + counter.vector(_diameters) +
+                   counter.vector(_perimeters);
+    return usage;
+}
+
+}  // namespace Property
+}  // namespace morphio
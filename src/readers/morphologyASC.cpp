@@ -1,10 +1,14 @@
 #include "morphologyASC.h"
+#include "../modifiers.h"
 
 #include <fstream>
 
 #include <morphio/mut/morphology.h>
 #include <morphio/mut/section.h>
 
+#include "../precise_points.h"
+#include "../stats.h"
+
 
 #include "lex.cpp"
 
@@ -37,14 +41,32 @@ bool skip_sexp(size_t id) {
             id == +Token::GENERATED || id == +Token::HIGH || id == +Token::INCOMPLETE ||
             id == +Token::LOW || id == +Token::NORMAL);
 }
+
+template <typename T>
+T parse_value(const std::string& value);
+
+template <>
+float parse_value(const std::string& value) {
+    return std::stof(value);
+}
+
+template <>
+double parse_value(const std::string& value) {
+    return std::stod(value);
+}
 }  // namespace
 
+/**
+   With precise, the points are also parsed in precision T, see load_as
+**/
+template <typename T>
 class NeurolucidaParser
 {
   public:
-    explicit NeurolucidaParser(const std::string& uri)
+    NeurolucidaParser(const std::string& uri, Property::GeometryT<T>* precise)
         : uri_(uri)
         , lex_(uri)
+        , precise_(precise)
         , debugInfo_(uri)
         , err_(uri) {}
 
@@ -52,10 +74,15 @@ class NeurolucidaParser
     NeurolucidaParser& operator=(NeurolucidaParser const&) = delete;
 
     morphio::mut::Morphology& parse() {
-        std::ifstream ifs(uri_);
-        std::string input((std::istreambuf_iterator<char>(ifs)),
-                          (std::istreambuf_iterator<char>()));
+        std::string input;
+        {
+            const detail::PhaseTimer timer(Stats::READ);
+            std::ifstream ifs(uri_);
+            input.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            detail::countBytesRead(input.size());
+        }
 
+        const detail::PhaseTimer timer(Stats::PARSE);
         lex_.start_parse(input);
 
         parse_block();
@@ -64,16 +91,18 @@ class NeurolucidaParser
     }
 
   private:
-    std::tuple<Point, floatType> parse_point(NeurolucidaLexer& lex) {
+    std::tuple<Point, floatType> parse_point(NeurolucidaLexer& lex,
+                                             Property::PointLevelT<T>& precise) {
         lex.expect(Token::LPAREN, "Point should start in LPAREN");
         std::array<morphio::floatType, 4> point{};  // X,Y,Z,R
-        for (auto& p : point) {
+        std::array<T, 4> precisePoint{};
+        for (size_t i = 0; i < point.size(); ++i) {
             try {
-#ifdef MORPHIO_USE_DOUBLE
-                p = std::stod(lex.consume()->str());
-#else
-                p = std::stof(lex.consume()->str());
-#endif
+                const std::string value = lex.consume()->str();
+                point[i] = parse_value<floatType>(value);
+                if (precise_ != nullptr) {
+                    precisePoint[i] = parse_value<T>(value);
+                }
             } catch (const std::invalid_argument&) {
                 throw RawDataError(err_.ERROR_PARSING_POINT(lex.line_num(), lex.current()->str()));
             }
@@ -87,6 +116,10 @@ class NeurolucidaParser
 
         lex.consume(Token::RPAREN, "Point should end in RPAREN");
 
+        if (precise_ != nullptr) {
+            precise._points.push_back({precisePoint[0], precisePoint[1], precisePoint[2]});
+            precise._diameters.push_back(precisePoint[3]);
+        }
         return std::tuple<Point, floatType>({point[0], point[1], point[2]}, point[3]);
     }
 
@@ -109,7 +142,8 @@ class NeurolucidaParser
     int32_t _create_soma_or_section(Token token,
                                     int32_t parent_id,
                                     std::vector<Point>& points,
-                                    std::vector<morphio::floatType>& diameters) {
+                                    std::vector<morphio::floatType>& diameters,
+                                    Property::PointLevelT<T>& precise) {
         lex_.current_section_start_ = lex_.line_num();
         int32_t return_id;
         morphio::Property::PointLevel properties;
@@ -119,10 +153,14 @@ class NeurolucidaParser
             if (!nb_.soma()->points().empty())
                 throw SomaError(err_.ERROR_SOMA_ALREADY_DEFINED(lex_.line_num()));
             nb_.soma()->properties() = properties;
+            if (precise_ != nullptr) {
+                precisePoints_.soma() = precise;
+            }
 
             return_id = -1;
         } else {
             SectionType section_type = TokenSectionTypeMap.at(token);
+            const size_t nPoints = properties._points.size();
             insertLastPointParentSection(parent_id, properties);
 
             // Condition to remove single point section that duplicate parent
@@ -140,10 +178,17 @@ class NeurolucidaParser
                 return_id = static_cast<int>(section->id());
                 debugInfo_.setLineNumber(section->id(),
                                          static_cast<unsigned int>(lex_.current_section_start_));
+                if (precise_ != nullptr) {
+                    _setPreciseSection(section->id(),
+                                       parent_id,
+                                       properties._points.size() > nPoints,
+                                       precise);
+                }
             }
         }
         points.clear();
         diameters.clear();
+        precise = Property::PointLevelT<T>();
 
         return return_id;
     }
@@ -180,9 +225,25 @@ class NeurolucidaParser
         properties._diameters.insert(properties._diameters.begin(), lastParentDiameter);
     }
 
+    // The values in precision T of a new section, with the last point of its parent if the
+    // section got it
+    void _setPreciseSection(uint32_t id,
+                            int32_t parentId,
+                            bool withParentPoint,
+                            const Property::PointLevelT<T>& values) {
+        Property::PointLevelT<T>& section = precisePoints_.section(id);
+        section = values;
+        if (withParentPoint) {
+            const auto& parent = precisePoints_.section(static_cast<uint32_t>(parentId));
+            section._points.insert(section._points.begin(), parent._points.back());
+            section._diameters.insert(section._diameters.begin(), parent._diameters.back());
+        }
+    }
+
     bool parse_neurite_section(int32_t parent_id, Token token) {
         Points points;
         std::vector<morphio::floatType> diameters;
+        Property::PointLevelT<T> precise;
         auto section_id = static_cast<int>(nb_.sections().size());
 
         while (true) {
@@ -193,7 +254,7 @@ class NeurolucidaParser
                 throw RawDataError(err_.ERROR_EOF_IN_NEURITE(lex_.line_num()));
             } else if (is_end_of_section(id)) {
                 if (!points.empty()) {
-                    _create_soma_or_section(token, parent_id, points, diameters);
+                    _create_soma_or_section(token, parent_id, points, diameters, precise);
                 }
                 return true;
             } else if (is_end_of_branch(id)) {
@@ -211,12 +272,13 @@ class NeurolucidaParser
                 } else if (peek_id == +Token::NUMBER) {
                     Point point;
                     floatType radius;
-                    std::tie(point, radius) = parse_point(lex_);
+                    std::tie(point, radius) = parse_point(lex_, precise);
                     points.push_back(point);
                     diameters.push_back(radius);
                 } else if (peek_id == +Token::LPAREN) {
                     if (!points.empty()) {
-                        section_id = _create_soma_or_section(token, parent_id, points, diameters);
+                        section_id =
+                            _create_soma_or_section(token, parent_id, points, diameters, precise);
                     }
                     parse_neurite_branch(section_id, token);
                 } else {
@@ -253,27 +315,56 @@ class NeurolucidaParser
 
     std::string uri_;
     NeurolucidaLexer lex_;
+    Property::GeometryT<T>* precise_;
 
   public:
     DebugInfo debugInfo_;
+    detail::PrecisePoints<T> precisePoints_;
 
   private:
     ErrorMessages err_;
 };
 
-Property::Properties load(const std::string& uri, unsigned int options) {
-    NeurolucidaParser parser(uri);
+template <typename T>
+Property::Properties _load(const std::string& uri,
+                           unsigned int options,
+                           Property::GeometryT<T>* precise) {
+    NeurolucidaParser<T> parser(uri, precise);
 
     morphio::mut::Morphology& nb_ = parser.parse();
-    nb_.sanitize(parser.debugInfo_);
-    nb_.applyModifiers(options);
-
-    Property::Properties properties = nb_.buildReadOnly();
+    Property::Properties properties;
+    if (precise != nullptr) {
+        parser.precisePoints_.sanitize(nb_, parser.debugInfo_);
+        parser.precisePoints_.build(nb_, *precise);
+        properties = std::move(nb_).buildReadOnly();
+        precise->_sectionLevel = properties._sectionLevel;
+        modifiers::apply(*precise, options);
+    } else {
+        nb_.sanitize(parser.debugInfo_);
+        properties = std::move(nb_).buildReadOnly();
+    }
+    modifiers::apply(properties, options);
     properties._cellLevel._cellFamily = NEURON;
     properties._cellLevel._version = MORPHOLOGY_VERSION_ASC_1;
     return properties;
 }
 
+Property::Properties load(const std::string& uri, unsigned int options) {
+    return _load<floatType>(uri, options, nullptr);
+}
+
+template <typename T>
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          Property::GeometryT<T>& precise) {
+    return _load(uri, options, &precise);
+}
+
+template Property::Properties load(const std::string&, unsigned int, Property::GeometryT<float>&);
+template Property::Properties load(const std::string&,
+                                   unsigned int,
+                                   Property::GeometryT<double>&);
+
 }  // namespace asc
 }  // namespace readers
 }  // namespace morphio
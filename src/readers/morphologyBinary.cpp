@@ -0,0 +1,599 @@
+#include "morphologyBinary.h"
+
+#include <cstdint>  // uint32_t, uint64_t
+#include <cstring>  // std::memcpy
+
+#if defined(WIN32) || defined(__WIN32__) || defined(_WIN32) || defined(_MSC_VER) || \
+    defined(__MINGW32__)
+#include <fstream>  // std::ifstream
+#define MORPHIO_BINARY_NO_MMAP
+#else
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#endif
+
+#include "../stats.h"
+
+namespace morphio {
+namespace readers {
+namespace binary {
+namespace {
+
+const char kMagic[8] = {'M', 'O', 'R', 'P', 'H', 'I', 'O', 'B'};
+// 2: annotation records hold their point range
+constexpr uint32_t kFormatVersion = 2;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kAlignment = 64;
+
+enum BlockId : uint32_t {
+    POINTS = 1,
+    DIAMETERS,
+    PERIMETERS,
+    SECTIONS,
+    SECTION_TYPES,
+    SOMA_POINTS,
+    SOMA_DIAMETERS,
+    SOMA_PERIMETERS,
+    MITO_SECTION_IDS,
+    MITO_PATH_LENGTHS,
+    MITO_DIAMETERS,
+    MITO_SECTIONS,
+    ER_SECTION_INDICES,
+    ER_VOLUMES,
+    ER_SURFACE_AREAS,
+    ER_FILAMENT_COUNTS,
+    ANNOTATIONS,
+    ANNOTATION_POINTS,
+    ANNOTATION_DIAMETERS,
+    ANNOTATION_PERIMETERS,
+    ANNOTATION_DETAILS,
+};
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t floatSize;
+    uint32_t cellFamily;
+    uint32_t somaType;
+    uint32_t nBlocks;
+};
+
+struct BlockEntry {
+    uint32_t id;
+    uint32_t elementSize;
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct AnnotationRecord {
+    uint32_t type;
+    uint32_t sectionId;
+    int32_t lineNumber;
+    uint32_t nPoints;
+    uint32_t detailsSize;
+    uint32_t pointRangeStart;
+    uint32_t pointRangeEnd;
+};
+
+// The annotation record of format version 1, without the point range
+struct AnnotationRecordV1 {
+    uint32_t type;
+    uint32_t sectionId;
+    int32_t lineNumber;
+    uint32_t nPoints;
+    uint32_t detailsSize;
+};
+
+static_assert(sizeof(Header) <= kHeaderSize, "The header must fit in kHeaderSize bytes");
+static_assert(sizeof(BlockEntry) == 24, "Block entries must not be padded");
+static_assert(sizeof(AnnotationRecord) == 28, "Annotation records must not be padded");
+static_assert(sizeof(AnnotationRecordV1) == 20, "Annotation records must not be padded");
+
+bool isLittleEndian() {
+    const uint16_t value = 1;
+    unsigned char first;
+    std::memcpy(&first, &value, 1);
+    return first == 1;
+}
+
+size_t aligned(size_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/** The floating point type of the elements of a floating point block **/
+template <typename T>
+struct Scalar {
+    using type = T;
+};
+
+template <typename T>
+struct Scalar<PointT<T>> {
+    using type = T;
+};
+
+/** Read-only view of a file, memory mapped when the platform allows it **/
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string& path) {
+#ifdef MORPHIO_BINARY_NO_MMAP
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw RawDataError("File: " + path + " does not exist.");
+        }
+        _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        _data = _buffer.data();
+        _size = _buffer.size();
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw RawDataError("File: " + path + " does not exist.");
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0) {
+            close(fd);
+            throw RawDataError("Cannot stat file: " + path);
+        }
+        _size = static_cast<size_t>(status.st_size);
+        if (_size > 0) {
+            void* address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                close(fd);
+                throw RawDataError("Cannot map file: " + path);
+            }
+            _data = static_cast<const char*>(address);
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef MORPHIO_BINARY_NO_MMAP
+        if (_data != nullptr) {
+            munmap(const_cast<char*>(_data), _size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const noexcept {
+        return _data;
+    }
+    size_t size() const noexcept {
+        return _size;
+    }
+
+  private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+#ifdef MORPHIO_BINARY_NO_MMAP
+    std::vector<char> _buffer;
+#endif
+};
+
+class Reader
+{
+  public:
+    Reader(const char* data, size_t size, const std::string& uri)
+        : _data(data)
+        , _size(size)
+        , _uri(uri) {}
+
+    Property::Properties read() {
+        if (!isLittleEndian()) {
+            _fail("the binary format is only supported on little-endian platforms");
+        }
+        if (_size < kHeaderSize) {
+            _fail("file too small");
+        }
+        Header header;
+        std::memcpy(&header, _data, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+            _fail("not a MorphIO binary file");
+        }
+        if (header.formatVersion == 0 || header.formatVersion > kFormatVersion) {
+            _fail("unsupported format version " + std::to_string(header.formatVersion));
+        }
+        if (header.floatSize != sizeof(float) && header.floatSize != sizeof(double)) {
+            _fail("unsupported floating point size " + std::to_string(header.floatSize));
+        }
+        _floatSize = header.floatSize;
+        _formatVersion = header.formatVersion;
+        if (kHeaderSize + header.nBlocks * sizeof(BlockEntry) > _size) {
+            _fail("truncated block table");
+        }
+
+        _blocks.resize(header.nBlocks);
+        std::memcpy(_blocks.data(), _data + kHeaderSize, header.nBlocks * sizeof(BlockEntry));
+        for (const auto& block : _blocks) {
+            if (block.elementSize == 0 || block.offset > _size ||
+                block.count > (_size - block.offset) / block.elementSize) {
+                _fail("truncated block " + std::to_string(block.id));
+            }
+        }
+
+        Property::Properties properties;
+        properties._cellLevel._cellFamily = static_cast<CellFamily>(header.cellFamily);
+        properties._cellLevel._somaType = static_cast<SomaType>(header.somaType);
+        properties._cellLevel._version = MORPHOLOGY_VERSION_BINARY_1;
+
+        _readFloating(POINTS, properties._pointLevel._points);
+        _readFloating(DIAMETERS, properties._pointLevel._diameters);
+        _readFloating(PERIMETERS, properties._pointLevel._perimeters);
+        _read(SECTIONS, properties._sectionLevel._sections);
+        _read(SECTION_TYPES, properties._sectionLevel._sectionTypes);
+
+        _readFloating(SOMA_POINTS, properties._somaLevel._points);
+        _readFloating(SOMA_DIAMETERS, properties._somaLevel._diameters);
+        _readFloating(SOMA_PERIMETERS, properties._somaLevel._perimeters);
+
+        auto& mitoPoints = properties._mitochondriaPointLevel;
+        _read(MITO_SECTION_IDS, mitoPoints._sectionIds);
+        _readFloating(MITO_PATH_LENGTHS, mitoPoints._relativePathLengths);
+        _readFloating(MITO_DIAMETERS, mitoPoints._diameters);
+        _read(MITO_SECTIONS, properties._mitochondriaSectionLevel._sections);
+
+        auto& reticulum = properties._endoplasmicReticulumLevel;
+        _read(ER_SECTION_INDICES, reticulum._sectionIndices);
+        _readFloating(ER_VOLUMES, reticulum._volumes);
+        _readFloating(ER_SURFACE_AREAS, reticulum._surfaceAreas);
+        _read(ER_FILAMENT_COUNTS, reticulum._filamentCounts);
+
+        _readAnnotations(properties._annotations);
+        _checkSections(properties);
+        return properties;
+    }
+
+    /** The points, diameters and perimeters of the last read() in precision T, see load_as **/
+    template <typename T>
+    void readPoints(Property::GeometryT<T>& precise) const {
+        _readFloating(POINTS, precise._pointLevel._points);
+        _readFloating(DIAMETERS, precise._pointLevel._diameters);
+        _readFloating(PERIMETERS, precise._pointLevel._perimeters);
+        _readFloating(SOMA_POINTS, precise._somaLevel._points);
+        _readFloating(SOMA_DIAMETERS, precise._somaLevel._diameters);
+        _readFloating(SOMA_PERIMETERS, precise._somaLevel._perimeters);
+    }
+
+  private:
+    [[noreturn]] void _fail(const std::string& reason) const {
+        throw RawDataError("Error reading binary morphology " + _uri + ": " + reason);
+    }
+
+    const BlockEntry* _find(uint32_t id) const {
+        for (const auto& block : _blocks) {
+            if (block.id == id) {
+                return &block;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    void _read(uint32_t id, std::vector<T>& output) const {
+        const BlockEntry* block = _find(id);
+        if (block == nullptr) {
+            return;
+        }
+        if (block->elementSize != sizeof(T)) {
+            _fail("unexpected element size in block " + std::to_string(id));
+        }
+        output.resize(block->count);
+        std::memcpy(output.data(), _data + block->offset, block->count * sizeof(T));
+    }
+
+    // Floating point blocks hold `components` scalars of the file precision per element, they
+    // are converted when the file was written with another precision than the one of output
+    template <typename T>
+    void _readFloating(uint32_t id, std::vector<T>& output) const {
+        using Output = typename Scalar<T>::type;
+        const BlockEntry* block = _find(id);
+        if (block == nullptr) {
+            return;
+        }
+        if (_floatSize == sizeof(Output)) {
+            _read(id, output);
+            return;
+        }
+        const size_t components = sizeof(T) / sizeof(Output);
+        if (block->elementSize != components * _floatSize) {
+            _fail("unexpected element size in block " + std::to_string(id));
+        }
+        output.resize(block->count);
+        auto* scalars = reinterpret_cast<Output*>(output.data());
+        const char* source = _data + block->offset;
+        if (_floatSize == sizeof(float)) {
+            _convert<float>(source, scalars, block->count * components);
+        } else {
+            _convert<double>(source, scalars, block->count * components);
+        }
+    }
+
+    template <typename Input, typename Output>
+    static void _convert(const char* source, Output* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            Input value;
+            std::memcpy(&value, source + i * sizeof(Input), sizeof(Input));
+            output[i] = static_cast<Output>(value);
+        }
+    }
+
+    void _readAnnotations(std::vector<Property::Annotation>& annotations) const {
+        std::vector<AnnotationRecord> records;
+        if (_formatVersion == 1) {
+            std::vector<AnnotationRecordV1> recordsV1;
+            _read(ANNOTATIONS, recordsV1);
+            for (const auto& record : recordsV1) {
+                records.push_back({record.type,
+                                   record.sectionId,
+                                   record.lineNumber,
+                                   record.nPoints,
+                                   record.detailsSize,
+                                   0,
+                                   0});
+            }
+        } else {
+            _read(ANNOTATIONS, records);
+        }
+        if (records.empty()) {
+            return;
+        }
+
+        Property::PointLevel points;
+        _readFloating(ANNOTATION_POINTS, points._points);
+        _readFloating(ANNOTATION_DIAMETERS, points._diameters);
+        _readFloating(ANNOTATION_PERIMETERS, points._perimeters);
+        _checkPointLevel(points, "annotation points");
+        std::vector<char> details;
+        _read(ANNOTATION_DETAILS, details);
+
+        size_t pointOffset = 0;
+        size_t detailsOffset = 0;
+        annotations.reserve(records.size());
+        for (const auto& record : records) {
+            if (pointOffset + record.nPoints > points._points.size() ||
+                detailsOffset + record.detailsSize > details.size()) {
+                _fail("truncated annotations");
+            }
+            if (record.pointRangeStart > record.pointRangeEnd) {
+                _fail("invalid annotation point range");
+            }
+            const SectionRange range(pointOffset, pointOffset + record.nPoints);
+            annotations.emplace_back(static_cast<AnnotationType>(record.type),
+                                     record.sectionId,
+                                     Property::PointLevel(points, range),
+                                     std::string(details.data() + detailsOffset,
+                                                 record.detailsSize),
+                                     record.lineNumber);
+            annotations.back()._pointRange = {record.pointRangeStart, record.pointRangeEnd};
+            pointOffset += record.nPoints;
+            detailsOffset += record.detailsSize;
+        }
+    }
+
+    // Guard the readers of the properties against out of range accesses
+    void _checkSections(const Property::Properties& properties) const {
+        const auto& sections = properties._sectionLevel._sections;
+        if (properties._sectionLevel._sectionTypes.size() != sections.size()) {
+            _fail("section types and sections differ in size");
+        }
+        _checkPointLevel(properties._pointLevel, "points");
+        _checkPointLevel(properties._somaLevel, "soma points");
+        _checkOffsets(sections, properties._pointLevel._points.size(), "section");
+        _checkNeurites(sections);
+
+        const auto& mitoPoints = properties._mitochondriaPointLevel;
+        const auto nMitoPoints = mitoPoints._sectionIds.size();
+        if (mitoPoints._relativePathLengths.size() != nMitoPoints ||
+            mitoPoints._diameters.size() != nMitoPoints) {
+            _fail("mitochondrial point arrays differ in size");
+        }
+        for (const auto sectionId : mitoPoints._sectionIds) {
+            if (sectionId >= sections.size()) {
+                _fail("mitochondrial point on missing section " + std::to_string(sectionId));
+            }
+        }
+        _checkOffsets(properties._mitochondriaSectionLevel._sections,
+                      nMitoPoints,
+                      "mitochondrial section");
+
+        const auto& reticulum = properties._endoplasmicReticulumLevel;
+        const auto nReticulum = reticulum._sectionIndices.size();
+        if (reticulum._volumes.size() != nReticulum ||
+            reticulum._surfaceAreas.size() != nReticulum ||
+            reticulum._filamentCounts.size() != nReticulum) {
+            _fail("endoplasmic reticulum arrays differ in size");
+        }
+        for (const auto sectionIndex : reticulum._sectionIndices) {
+            if (sectionIndex >= sections.size()) {
+                _fail("endoplasmic reticulum on missing section " +
+                      std::to_string(sectionIndex));
+            }
+        }
+    }
+
+    // Diameters, and perimeters when there are any, go with each point
+    void _checkPointLevel(const Property::PointLevel& level, const std::string& name) const {
+        const auto nPoints = level._points.size();
+        if (level._diameters.size() != nPoints ||
+            (!level._perimeters.empty() && level._perimeters.size() != nPoints)) {
+            _fail(name + ", diameters and perimeters differ in size");
+        }
+    }
+
+    // Sections start at increasing offsets within the points, and come after their parent: the
+    // sections of a sanitized file are ordered, which rules out cycles
+    void _checkOffsets(const std::vector<Property::Section::Type>& sections,
+                       size_t nPoints,
+                       const std::string& name) const {
+        for (size_t i = 0; i < sections.size(); ++i) {
+            const auto offset = static_cast<size_t>(sections[i][0]);
+            if (sections[i][0] < 0 || offset > nPoints ||
+                (i > 0 && sections[i][0] < sections[i - 1][0]) || sections[i][1] < -1 ||
+                sections[i][1] >= static_cast<int>(i)) {
+                _fail("invalid " + name + " " + std::to_string(i));
+            }
+        }
+    }
+
+    // The sections of each neurite follow each other, as in depth first order
+    void _checkNeurites(const std::vector<Property::Section::Type>& sections) const {
+        std::vector<size_t> roots(sections.size());
+        for (size_t i = 0; i < sections.size(); ++i) {
+            const int parent = sections[i][1];
+            roots[i] = parent == -1 ? i : roots[static_cast<size_t>(parent)];
+            if (parent != -1 && roots[i] != roots[i - 1]) {
+                _fail("section " + std::to_string(i) + " is apart from its neurite");
+            }
+        }
+    }
+
+    const char* _data;
+    size_t _size;
+    const std::string& _uri;
+    size_t _floatSize = sizeof(floatType);
+    uint32_t _formatVersion = kFormatVersion;
+    std::vector<BlockEntry> _blocks;
+};
+
+class Writer
+{
+  public:
+    template <typename T>
+    void add(uint32_t id, const std::vector<T>& values) {
+        if (!values.empty()) {
+            _blocks.push_back({id, sizeof(T), values.data(), values.size()});
+        }
+    }
+
+    std::vector<char> write(const Property::Properties& properties) const {
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.formatVersion = kFormatVersion;
+        header.floatSize = sizeof(floatType);
+        header.cellFamily = static_cast<uint32_t>(properties._cellLevel._cellFamily);
+        header.somaType = static_cast<uint32_t>(properties._cellLevel._somaType);
+        header.nBlocks = static_cast<uint32_t>(_blocks.size());
+
+        std::vector<BlockEntry> table;
+        size_t offset = aligned(kHeaderSize + _blocks.size() * sizeof(BlockEntry));
+        for (const auto& block : _blocks) {
+            table.push_back({block.id, block.elementSize, offset, block.count});
+            offset = aligned(offset + block.elementSize * block.count);
+        }
+
+        std::vector<char> buffer(offset, 0);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        std::memcpy(buffer.data() + kHeaderSize, table.data(), table.size() * sizeof(BlockEntry));
+        for (size_t i = 0; i < _blocks.size(); ++i) {
+            std::memcpy(buffer.data() + table[i].offset,
+                        _blocks[i].data,
+                        _blocks[i].elementSize * _blocks[i].count);
+        }
+        return buffer;
+    }
+
+  private:
+    struct Block {
+        uint32_t id;
+        uint32_t elementSize;
+        const void* data;
+        size_t count;
+    };
+    std::vector<Block> _blocks;
+};
+
+}  // anonymous namespace
+
+Property::Properties load(const std::string& uri) {
+    const MappedFile file(uri);
+    detail::countBytesRead(file.size());
+    return load(file.data(), file.size(), uri);
+}
+
+Property::Properties load(const char* data, size_t size, const std::string& uri) {
+    const detail::PhaseTimer timer(Stats::PARSE);
+    return Reader(data, size, uri).read();
+}
+
+template <typename T>
+Property::Properties load(const std::string& uri, Property::GeometryT<T>& precise) {
+    const MappedFile file(uri);
+    detail::countBytesRead(file.size());
+    const detail::PhaseTimer timer(Stats::PARSE);
+    Reader reader(file.data(), file.size(), uri);
+    Property::Properties properties = reader.read();
+    reader.readPoints(precise);
+    return properties;
+}
+
+template Property::Properties load(const std::string&, Property::GeometryT<float>&);
+template Property::Properties load(const std::string&, Property::GeometryT<double>&);
+
+std::vector<char> serialize(const Property::Properties& properties) {
+    if (!isLittleEndian()) {
+        throw WriterError("The binary format is only supported on little-endian platforms");
+    }
+
+    Writer writer;
+    writer.add(POINTS, properties._pointLevel._points);
+    writer.add(DIAMETERS, properties._pointLevel._diameters);
+    writer.add(PERIMETERS, properties._pointLevel._perimeters);
+    writer.add(SECTIONS, properties._sectionLevel._sections);
+    writer.add(SECTION_TYPES, properties._sectionLevel._sectionTypes);
+
+    writer.add(SOMA_POINTS, properties._somaLevel._points);
+    writer.add(SOMA_DIAMETERS, properties._somaLevel._diameters);
+    writer.add(SOMA_PERIMETERS, properties._somaLevel._perimeters);
+
+    const auto& mitoPoints = properties._mitochondriaPointLevel;
+    writer.add(MITO_SECTION_IDS, mitoPoints._sectionIds);
+    writer.add(MITO_PATH_LENGTHS, mitoPoints._relativePathLengths);
+    writer.add(MITO_DIAMETERS, mitoPoints._diameters);
+    writer.add(MITO_SECTIONS, properties._mitochondriaSectionLevel._sections);
+
+    const auto& reticulum = properties._endoplasmicReticulumLevel;
+    writer.add(ER_SECTION_INDICES, reticulum._sectionIndices);
+    writer.add(ER_VOLUMES, reticulum._volumes);
+    writer.add(ER_SURFACE_AREAS, reticulum._surfaceAreas);
+    writer.add(ER_FILAMENT_COUNTS, reticulum._filamentCounts);
+
+    std::vector<AnnotationRecord> records;
+    Property::PointLevel annotationPoints;
+    std::vector<char> details;
+    for (const auto& annotation : properties._annotations) {
+        records.push_back({static_cast<uint32_t>(annotation._type),
+                           annotation._sectionId,
+                           annotation._lineNumber,
+                           static_cast<uint32_t>(annotation._points._points.size()),
+                           static_cast<uint32_t>(annotation._details.size()),
+                           static_cast<uint32_t>(annotation._pointRange.first),
+                           static_cast<uint32_t>(annotation._pointRange.second)});
+        const auto& points = annotation._points;
+        annotationPoints._points.insert(annotationPoints._points.end(),
+                                        points._points.begin(),
+                                        points._points.end());
+        annotationPoints._diameters.insert(annotationPoints._diameters.end(),
+                                           points._diameters.begin(),
+                                           points._diameters.end());
+        annotationPoints._perimeters.insert(annotationPoints._perimeters.end(),
+                                            points._perimeters.begin(),
+                                            points._perimeters.end());
+        details.insert(details.end(), annotation._details.begin(), annotation._details.end());
+    }
+    writer.add(ANNOTATIONS, records);
+    writer.add(ANNOTATION_POINTS, annotationPoints._points);
+    writer.add(ANNOTATION_DIAMETERS, annotationPoints._diameters);
+    writer.add(ANNOTATION_PERIMETERS, annotationPoints._perimeters);
+    writer.add(ANNOTATION_DETAILS, details);
+
+    return writer.write(properties);
+}
+
+}  // namespace binary
+}  // namespace readers
+}  // namespace morphio
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+/**
+   The MorphIO binary format (.mbin) is a little-endian dump of Property::Properties:
+
+   - a 64 bytes header:
+       char[8]  magic "MORPHIOB"
+       uint32   format version (2, version 1 annotation records lack the point range)
+       uint32   size in bytes of the floating point values (4 or 8)
+       uint32   cell family
+       uint32   soma type
+       uint32   number of blocks
+       (zero padding)
+   - the block table, one entry per block:
+       uint32   block id (see BlockId)
+       uint32   size in bytes of one element
+       uint64   offset of the block from the start of the file
+       uint64   number of elements
+   - the blocks, each one starting on a 64 bytes boundary
+
+   The data is stored already sanitized, so that loading it is a matter of copying each block
+   into its vector. Unknown block ids are skipped so that blocks can be added without breaking
+   older readers.
+**/
+namespace morphio {
+namespace readers {
+namespace binary {
+
+/** Load a file written by serialize(), the file is memory mapped **/
+Property::Properties load(const std::string& uri);
+
+/** Load a serialized morphology from memory; uri is only used in error messages **/
+Property::Properties load(const char* data, size_t size, const std::string& uri);
+
+/**
+   Also read the points, diameters and perimeters in precision T into precise, see load_as.
+   Files store the precision they were written with: values are converted from it
+**/
+template <typename T>
+Property::Properties load(const std::string& uri, Property::GeometryT<T>& precise);
+
+extern template Property::Properties load(const std::string&, Property::GeometryT<float>&);
+extern template Property::Properties load(const std::string&, Property::GeometryT<double>&);
+
+/** Serialize the properties in the MorphIO binary format **/
+std::vector<char> serialize(const Property::Properties& properties);
+
+}  // namespace binary
+}  // namespace readers
+}  // namespace morphio
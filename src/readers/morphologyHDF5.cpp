@@ -24,6 +24,8 @@
 
 #include <highfive/H5Utility.hpp>  // HighFive::SilenceHDF5
 
+#include "../stats.h"
+
 namespace {
 // v1 & v2
 const std::string _d_points("points");
@@ -55,39 +57,87 @@ constexpr size_t _structureV2Columns = 2;
 const std::string _g_root("neuron1");
 const std::string _d_type("sectiontype");
 const std::string _a_apical("apical");
+
+/** Size of the data read from a dataset, for the load statistics **/
+template <typename T>
+size_t dataBytes(const std::vector<T>& data) {
+    return data.size() * sizeof(T);
+}
+
+template <typename T>
+size_t dataBytes(const std::vector<std::vector<T>>& data) {
+    size_t bytes = 0;
+    for (const auto& row : data) {
+        bytes += row.size() * sizeof(T);
+    }
+    return bytes;
+}
 }  // namespace
 
 namespace morphio {
 namespace readers {
 namespace h5 {
 
-Property::Properties load(const std::string& uri) {
+namespace {
+template <typename Load>
+Property::Properties loadFile(const std::string& uri, Load load) {
     try {
         HighFive::SilenceHDF5 silence;
         auto file = HighFive::File(uri, HighFive::File::ReadOnly);
-        return MorphologyHDF5(file.getGroup("/")).load();
+        MorphologyHDF5 reader(file.getGroup("/"));
+        return load(reader);
 
     } catch (const HighFive::FileException& exc) {
         throw morphio::RawDataError("Could not open morphology file " + uri + ": " + exc.what());
     }
 }
+}  // namespace
+
+Property::Properties load(const std::string& uri) {
+    return loadFile(uri, [](MorphologyHDF5& reader) { return reader.load(); });
+}
 
 Property::Properties load(const HighFive::Group& group) {
     return MorphologyHDF5(group).load();
 }
 
+template <typename T>
+Property::Properties load(const std::string& uri, Property::GeometryT<T>& precise) {
+    return loadFile(uri, [&precise](MorphologyHDF5& reader) { return reader.load(precise); });
+}
+
 Property::Properties MorphologyHDF5::load() {
+    _load();
+    return _properties;
+}
+
+template <typename T>
+Property::Properties MorphologyHDF5::load(Property::GeometryT<T>& precise) {
+    const int firstSectionOffset = _load();
+    // The datasets are read again, HDF5 converting their values to T
+    const detail::PhaseTimer timer(Stats::READ);
+    _readPoints(firstSectionOffset, precise._pointLevel, precise._somaLevel);
+    _readPerimeters(firstSectionOffset, precise._pointLevel._perimeters);
+    return _properties;
+}
+
+int MorphologyHDF5::_load() {
     _stage = "repaired";
 
-    _checkVersion(_uri);
-    _selectRepairStage();
+    {
+        const detail::PhaseTimer timer(Stats::PROBE);
+        _checkVersion(_uri);
+        _selectRepairStage();
+    }
+
+    const detail::PhaseTimer timer(Stats::READ);
     int firstSectionOffset = _readSections();
-    _readPoints(firstSectionOffset);
-    _readPerimeters(firstSectionOffset);
+    _readPoints(firstSectionOffset, _properties._pointLevel, _properties._somaLevel);
+    _readPerimeters(firstSectionOffset, _properties._pointLevel._perimeters);
     _readMitochondria();
     _readEndoplasmicReticulum();
 
-    return _properties;
+    return firstSectionOffset;
 }
 
 MorphologyHDF5::MorphologyHDF5(const HighFive::Group& group)
@@ -209,16 +259,18 @@ static inline bool v2HasNeurites(int firstSectionOffset) {
 }
 
 
-void MorphologyHDF5::_readPoints(int firstSectionOffset) {
-    auto& points = _properties.get<Property::Point>();
-    auto& diameters = _properties.get<Property::Diameter>();
+template <typename T>
+void MorphologyHDF5::_readPoints(int firstSectionOffset,
+                                 Property::PointLevelT<T>& pointLevel,
+                                 Property::PointLevelT<T>& somaLevel) {
+    auto& points = pointLevel._points;
+    auto& diameters = pointLevel._diameters;
 
-    auto& somaPoints = _properties._somaLevel._points;
-    auto& somaDiameters = _properties._somaLevel._diameters;
+    auto& somaPoints = somaLevel._points;
+    auto& somaDiameters = somaLevel._diameters;
 
     auto loadPoints =
-        [&](const std::vector<std::array<morphio::floatType, _pointColumns>>& hd5fData,
-            bool hasNeurites) {
+        [&](const std::vector<std::array<T, _pointColumns>>& hd5fData, bool hasNeurites) {
             const std::size_t section_offset = hasNeurites ? std::size_t(firstSectionOffset)
                                                            : hd5fData.size();
 
@@ -261,16 +313,18 @@ void MorphologyHDF5::_readPoints(int firstSectionOffset) {
             throw(MorphioError("'Error reading morphologies: " + _uri +
                                " bad number of dimensions in 'points' dataspace"));
         }
-        std::vector<std::array<morphio::floatType, _pointColumns>> vec(dims[0]);
+        std::vector<std::array<T, _pointColumns>> vec(dims[0]);
         if (vec.size() > 0) {
             dataset.read(vec.front().data());
         }
+        detail::countBytesRead(dataBytes(vec));
         loadPoints(vec, v2HasNeurites(firstSectionOffset));
     } else {
-        std::vector<std::array<morphio::floatType, _pointColumns>> vec(_pointsDims[0]);
+        std::vector<std::array<T, _pointColumns>> vec(_pointsDims[0]);
         if (vec.size() > 0) {
             _points->read(vec.front().data());
         }
+        detail::countBytesRead(dataBytes(vec));
         loadPoints(vec, std::size_t(firstSectionOffset) < _pointsDims[0]);
     }
 }
@@ -301,6 +355,7 @@ int MorphologyHDF5::_readV1Sections() {
     if (vec.size() > 0) {
         _sections->read(vec.front().data());
     }
+    detail::countBytesRead(dataBytes(vec));
 
     if (vec.size() < 2)  // Neuron without any neurites
         return -1;
@@ -376,6 +431,7 @@ int MorphologyHDF5::_readV2Sections() {
         dataset.read(vec.front().data());
     }
     dataset_types.read(types);
+    detail::countBytesRead(dataBytes(vec) + dataBytes(types));
 
     int firstSectionOffset = vec[1][0];
     sections.reserve(sections.size() + vec.size() - 1);
@@ -398,7 +454,8 @@ int MorphologyHDF5::_readV2Sections() {
     return firstSectionOffset;
 }
 
-void MorphologyHDF5::_readPerimeters(int firstSectionOffset) {
+template <typename T>
+void MorphologyHDF5::_readPerimeters(int firstSectionOffset, std::vector<T>& perimeters) {
     if (_properties.version() != MORPHOLOGY_VERSION_H5_1_1 || !v2HasNeurites(firstSectionOffset))
         return;
 
@@ -412,11 +469,11 @@ void MorphologyHDF5::_readPerimeters(int firstSectionOffset) {
                                " bad number of dimensions in 'perimeters' dataspace"));
         }
 
-        std::vector<morphio::floatType> perimeters;
-        perimeters.resize(dims[0]);
-        dataset.read(perimeters);
-        _properties.get<Property::Perimeter>().assign(perimeters.begin() + firstSectionOffset,
-                                                      perimeters.end());
+        std::vector<T> values;
+        values.resize(dims[0]);
+        dataset.read(values);
+        detail::countBytesRead(dataBytes(values));
+        perimeters.assign(values.begin() + firstSectionOffset, values.end());
     } catch (...) {
         if (_properties._cellLevel._cellFamily == GLIA)
             throw MorphioError("No empty perimeters allowed for glia morphology");
@@ -444,6 +501,7 @@ void MorphologyHDF5::_read(const std::string& groupName,
 
         data.resize(dims[0]);
         dataset.read(data);
+        detail::countBytesRead(dataBytes(data));
     } catch (...) {
         if (_properties._cellLevel._cellFamily == GLIA)
             throw MorphioError("No empty perimeters allowed for glia morphology");
@@ -519,6 +577,9 @@ void MorphologyHDF5::_readMitochondria() {
         mitoSection.emplace_back(Property::MitoSection::Type{s[0], s[1]});
 }
 
+template Property::Properties load(const std::string&, Property::GeometryT<float>&);
+template Property::Properties load(const std::string&, Property::GeometryT<double>&);
+
 }  // namespace h5
 }  // namespace readers
 }  // namespace morphio
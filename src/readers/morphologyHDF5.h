@@ -16,25 +16,42 @@ namespace h5 {
 Property::Properties load(const std::string& uri);
 Property::Properties load(const HighFive::Group& group);
 
+/**
+   Also read the points, diameters and perimeters in precision T into precise, laid out as the
+   ones of the returned properties, see load_as
+**/
+template <typename T>
+Property::Properties load(const std::string& uri, Property::GeometryT<T>& precise);
+
+extern template Property::Properties load(const std::string&, Property::GeometryT<float>&);
+extern template Property::Properties load(const std::string&, Property::GeometryT<double>&);
+
 class MorphologyHDF5
 {
   public:
     MorphologyHDF5(const HighFive::Group& group);
     virtual ~MorphologyHDF5() = default;
     Property::Properties load();
+    template <typename T>
+    Property::Properties load(Property::GeometryT<T>& precise);
 
   private:
+    int _load();
     void _checkVersion(const std::string& source);
     void _selectRepairStage();
     void _resolveV1();
     bool _readV11Metadata();
     bool _readV2Metadata();
     HighFive::DataSet _getStructureDataSet(size_t nSections);
-    void _readPoints(int);
+    template <typename T>
+    void _readPoints(int firstSectionOffset,
+                     Property::PointLevelT<T>& pointLevel,
+                     Property::PointLevelT<T>& somaLevel);
     int _readSections();
     int _readV1Sections();
     int _readV2Sections();
-    void _readPerimeters(int);
+    template <typename T>
+    void _readPerimeters(int firstSectionOffset, std::vector<T>& perimeters);
     void _readMitochondria();
     void _readEndoplasmicReticulum();
 
@@ -1,4 +1,5 @@
 #include "morphologySWC.h"
+#include "../modifiers.h"
 
 #include <cstdint>  // uint32_t
 #include <fstream>
@@ -13,12 +14,27 @@
 #include <morphio/mut/soma.h>
 #include <morphio/properties.h>
 
+#include "../precise_points.h"
+#include "../stats.h"
+
 namespace {
 bool _ignoreLine(const std::string& line) {
     std::size_t pos = line.find_first_not_of("\n\r\t ");
     return pos == std::string::npos || line[pos] == '#';
 }
 
+// The point and radius of a sample line in another precision than Sample, see load_as
+bool _parsePoint(const char* line, morphio::PointT<float>& point, float& radius) {
+    return sscanf(line, "%*20u%*20d%20f%20f%20f%20f", &point[0], &point[1], &point[2], &radius) ==
+           4;
+}
+
+bool _parsePoint(const char* line, morphio::PointT<double>& point, double& radius) {
+    return sscanf(
+               line, "%*20u%*20d%20lg%20lg%20lg%20lg", &point[0], &point[1], &point[2], &radius) ==
+           4;
+}
+
 }  // unnamed namespace
 
 namespace morphio {
@@ -30,14 +46,19 @@ const int SWC_UNDEFINED_PARENT = -1;
 /**
    Parsing SWC according to this specification:
    http://www.neuronland.org/NLMorphologyConverter/MorphologyFormats/SWC/Spec.html
+
+   With precise, the points are also parsed in precision T, see load_as
 **/
+template <typename T>
 class SWCBuilder
 {
   public:
-    explicit SWCBuilder(const std::string& _uri)
+    SWCBuilder(const std::string& _uri, Property::GeometryT<T>* _precise)
         : uri(_uri)
         , err(_uri)
-        , debugInfo(_uri) {
+        , debugInfo(_uri)
+        , precise(_precise) {
+        const detail::PhaseTimer timer(Stats::PARSE);
         _readSamples();
 
         for (const auto& sample_pair : samples) {
@@ -57,6 +78,7 @@ class SWCBuilder
         std::string line;
         while (!std::getline(file, line).fail()) {
             ++lineNumber;
+            detail::countBytesRead(line.size() + (file.eof() ? 0 : 1));
 
             if (line.empty() || _ignoreLine(line))
                 continue;
@@ -74,6 +96,11 @@ class SWCBuilder
 
             samples[sample.id] = sample;
             children[sample.parentId].push_back(sample.id);
+            if (precise != nullptr) {
+                PreciseSample& preciseSample = preciseSamples[sample.id];
+                _parsePoint(line.data(), preciseSample.point, preciseSample.diameter);
+                preciseSample.diameter *= 2;
+            }
 
             if (sample.type == SECTION_SOMA) {
                 lastSomaPoint = static_cast<int>(sample.id);
@@ -123,7 +150,7 @@ class SWCBuilder
 
     void warnIfDisconnectedNeurite(const Sample& sample) {
         if (sample.parentId == SWC_UNDEFINED_PARENT && sample.type != SECTION_SOMA)
-            printError(Warning::DISCONNECTED_NEURITE, err.WARNING_DISCONNECTED_NEURITE(sample));
+            printError(DisconnectedNeuriteWarning(err, sample));
     }
 
     void checkSoma() {
@@ -171,13 +198,19 @@ class SWCBuilder
                 sample.type != SECTION_SOMA);
     }
 
-    template <typename T>
-    void appendSample(const std::shared_ptr<T>& somaOrSection, const Sample& sample) {
+    template <typename SomaOrSection>
+    void appendSample(const std::shared_ptr<SomaOrSection>& somaOrSection, const Sample& sample) {
         debugInfo.setLineNumber(sample.id, sample.lineNumber);
         somaOrSection->points().push_back(sample.point);
         somaOrSection->diameters().push_back(sample.diameter);
     }
 
+    void appendPreciseSample(Property::PointLevelT<T>& level, uint32_t sampleId) {
+        const PreciseSample& sample = preciseSamples.at(sampleId);
+        level._points.push_back(sample.point);
+        level._diameters.push_back(sample.diameter);
+    }
+
     void _pushChildren(std::vector<unsigned int>& vec, int32_t id) {
         for (unsigned int childId : children[id]) {
             vec.push_back(childId);
@@ -214,8 +247,8 @@ class SWCBuilder
         }
     }
 
-    SomaType somaType() {
-        switch (morph.soma()->points().size()) {
+    SomaType somaType(size_t nSomaPoints) {
+        switch (nSomaPoints) {
         case 0: {
             return SOMA_UNDEFINED;
         }
@@ -262,38 +295,55 @@ class SWCBuilder
         bool originalIsIgnored = err.isIgnored(morphio::Warning::APPENDING_EMPTY_SECTION);
         set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, true);
 
-        std::vector<unsigned int> depthFirstSamples;
-        _pushChildren(depthFirstSamples, -1);
-        for (const auto id : depthFirstSamples) {
-            const Sample& sample = samples[id];
-
-            // Bifurcation right at the start
-            if (isRootPoint(sample) && isSectionEnd(sample)) {
-                continue;
+        {
+            const detail::PhaseTimer timer(Stats::PARSE);
+            std::vector<unsigned int> depthFirstSamples;
+            _pushChildren(depthFirstSamples, -1);
+            for (const auto id : depthFirstSamples) {
+                const Sample& sample = samples[id];
+
+                // Bifurcation right at the start
+                if (isRootPoint(sample) && isSectionEnd(sample)) {
+                    continue;
+                }
+
+                if (isSectionStart(sample)) {
+                    _processSectionStart(sample);
+                } else if (sample.type != SECTION_SOMA) {
+                    swcIdToSectionId[sample.id] =
+                        swcIdToSectionId[static_cast<unsigned int>(sample.parentId)];
+                }
+
+                if (sample.type == SECTION_SOMA) {
+                    appendSample(morph.soma(), sample);
+                    if (precise != nullptr)
+                        appendPreciseSample(precisePoints.soma(), sample.id);
+                } else {
+                    const uint32_t sectionId = swcIdToSectionId.at(sample.id);
+                    appendSample(morph.section(sectionId), sample);
+                    if (precise != nullptr)
+                        appendPreciseSample(precisePoints.section(sectionId), sample.id);
+                }
             }
 
-            if (isSectionStart(sample)) {
-                _processSectionStart(sample);
-            } else if (sample.type != SECTION_SOMA) {
-                swcIdToSectionId[sample.id] =
-                    swcIdToSectionId[static_cast<unsigned int>(sample.parentId)];
-            }
-
-            if (sample.type == SECTION_SOMA) {
-                appendSample(morph.soma(), sample);
-            } else {
-                appendSample(morph.section(swcIdToSectionId.at(sample.id)), sample);
-            }
+            if (morph.soma()->points().size() == 3 && !neurite_wrong_root.empty())
+                printError(morphio::WRONG_ROOT_POINT,
+                           err.WARNING_WRONG_ROOT_POINT(neurite_wrong_root));
         }
 
-        if (morph.soma()->points().size() == 3 && !neurite_wrong_root.empty())
-            printError(morphio::WRONG_ROOT_POINT, err.WARNING_WRONG_ROOT_POINT(neurite_wrong_root));
-
-        morph.sanitize();
-        morph.applyModifiers(options);
-
-        Property::Properties properties = morph.buildReadOnly();
-        properties._cellLevel._somaType = somaType();
+        Property::Properties properties;
+        if (precise != nullptr) {
+            precisePoints.sanitize(morph, DebugInfo());
+            precisePoints.build(morph, *precise);
+            properties = std::move(morph).buildReadOnly();
+            precise->_sectionLevel = properties._sectionLevel;
+            modifiers::apply(*precise, options);
+        } else {
+            morph.sanitize();
+            properties = std::move(morph).buildReadOnly();
+        }
+        modifiers::apply(properties, options);
+        properties._cellLevel._somaType = somaType(properties._somaLevel._points.size());
 
         set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, originalIsIgnored);
 
@@ -328,12 +378,19 @@ class SWCBuilder
                          ->appendSection(properties, sample.type)
                          ->id();
             }
+            if (precise != nullptr && !properties._points.empty())
+                appendPreciseSample(precisePoints.section(id), parentId);
         }
 
         swcIdToSectionId[sample.id] = id;
     }
 
   private:
+    struct PreciseSample {
+        PointT<T> point;
+        T diameter;
+    };
+
     // Dictionary: SWC Id of the last point of a section to morphio::mut::Section ID
     std::map<uint32_t, uint32_t> swcIdToSectionId;
 
@@ -348,15 +405,38 @@ class SWCBuilder
     std::string uri;
     ErrorMessages err;
     DebugInfo debugInfo;
+
+    Property::GeometryT<T>* precise;
+    std::map<uint32_t, PreciseSample> preciseSamples;
+    detail::PrecisePoints<T> precisePoints;
 };
 
-Property::Properties load(const std::string& uri, unsigned int options) {
-    auto properties = SWCBuilder(uri)._buildProperties(options);
+template <typename T>
+Property::Properties _load(const std::string& uri,
+                           unsigned int options,
+                           Property::GeometryT<T>* precise) {
+    auto properties = SWCBuilder<T>(uri, precise)._buildProperties(options);
     properties._cellLevel._cellFamily = NEURON;
     properties._cellLevel._version = MORPHOLOGY_VERSION_SWC_1;
     return properties;
 }
 
+Property::Properties load(const std::string& uri, unsigned int options) {
+    return _load<floatType>(uri, options, nullptr);
+}
+
+template <typename T>
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          Property::GeometryT<T>& precise) {
+    return _load(uri, options, &precise);
+}
+
+template Property::Properties load(const std::string&, unsigned int, Property::GeometryT<float>&);
+template Property::Properties load(const std::string&,
+                                   unsigned int,
+                                   Property::GeometryT<double>&);
+
 }  // namespace swc
 }  // namespace readers
 }  // namespace morphio
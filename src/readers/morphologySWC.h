@@ -7,6 +7,22 @@ namespace morphio {
 namespace readers {
 namespace swc {
 Property::Properties load(const std::string& uri, unsigned int options);
+
+/**
+   Also parse the points, diameters and perimeters in precision T into precise, laid out as the
+   ones of the returned properties, see load_as
+**/
+template <typename T>
+Property::Properties load(const std::string& uri,
+                          unsigned int options,
+                          Property::GeometryT<T>& precise);
+
+extern template Property::Properties load(const std::string&,
+                                          unsigned int,
+                                          Property::GeometryT<float>&);
+extern template Property::Properties load(const std::string&,
+                                          unsigned int,
+                                          Property::GeometryT<double>&);
 }  // namespace swc
 
 }  // namespace readers
@@ -1,5 +1,11 @@
 #include "vasculatureHDF5.h"
 
+#include <algorithm>  // std::min
+#include <bitset>     // std::bitset
+#include <cstdint>    // int64_t
+
+#include <morphio/vector_types.h>
+
 #include <highfive/H5Utility.hpp>  // for HighFive::SilenceHDF5
 
 #include "utilsHDF5.h"
@@ -8,22 +14,211 @@ namespace morphio {
 namespace readers {
 namespace h5 {
 
+namespace {
+
+// Rows read per HDF5 call: 4 MB of points
+constexpr size_t kBlockRows = 1 << 18;
+
+// Sections whose points are held at once when filtering a region
+constexpr size_t kSectionBlockRows = 1 << 14;
+
+/**
+   Read the rows [first, last) of a dataset with `columns` columns, kBlockRows at a time,
+   calling consume(block, nRows) on each block of rows stored one after the other
+**/
+template <typename T, typename Consumer>
+void readRows(const HighFive::DataSet& dataset,
+              size_t columns,
+              size_t first,
+              size_t last,
+              Consumer consume) {
+    if (first >= last) {
+        return;
+    }
+    std::vector<T> block(std::min(last - first, kBlockRows) * columns);
+    for (size_t begin = first; begin < last; begin += kBlockRows) {
+        const size_t count = std::min(kBlockRows, last - begin);
+        dataset.select({begin, 0}, {count, columns}).read(block.data());
+        consume(block, count);
+    }
+}
+
+/** Whether the box of a segment of the points [begin, end), radii included, meets the region **/
+bool intersects(const BoundingBox& region,
+                const Points& points,
+                const std::vector<morphio::floatType>& diameters,
+                size_t begin,
+                size_t end) {
+    auto box = [&points, &diameters](size_t i) {
+        const morphio::floatType radius = diameters[i] / 2;
+        const Point extent{radius, radius, radius};
+        return BoundingBox{points[i] - extent, points[i] + extent};
+    };
+    if (end - begin == 1) {
+        return region.intersects(box(begin));
+    }
+    for (size_t i = begin; i + 1 < end; ++i) {
+        BoundingBox segment = box(i);
+        segment.expand(box(i + 1));
+        if (region.intersects(segment)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+   A set of section IDs, renumbered by their rank in the set: a bitset with the number of IDs
+   before each of its words, that is 1.5 bit per section of the file
+**/
+class RankedIds
+{
+  public:
+    explicit RankedIds(size_t nIds)
+        : _words((nIds + 63) / 64, 0)
+        , _ranks(_words.size(), 0) {}
+
+    /** Add the id; ids must be inserted in increasing order **/
+    void insert(size_t id) {
+        const size_t word = id / 64;
+        for (; _rankedWords <= word; ++_rankedWords) {
+            _ranks[_rankedWords] = _count;
+        }
+        _words[word] |= uint64_t{1} << (id % 64);
+        ++_count;
+    }
+
+    /** If id is in the set, replace it with its rank and return true **/
+    bool renumber(unsigned int& id) const {
+        const uint64_t word = _words[id / 64];
+        const uint64_t bit = uint64_t{1} << (id % 64);
+        if ((word & bit) == 0) {
+            return false;
+        }
+        id = _ranks[id / 64] + static_cast<unsigned int>(std::bitset<64>(word & (bit - 1)).count());
+        return true;
+    }
+
+  private:
+    std::vector<uint64_t> _words;
+    std::vector<unsigned int> _ranks;
+    size_t _rankedWords = 0;
+    unsigned int _count = 0;
+};
+
+}  // anonymous namespace
+
+template <typename Renumber>
+void VasculatureHDF5::_readConnectivity(Renumber renumber) {
+    auto& con = _properties._connectivity;
+    const size_t nSections = _sectionsDims[0];
+
+    // There is no index by section: the connections of a subset are found by going through all
+    // of them
+    auto consume = [&](const std::vector<unsigned int>& block, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            unsigned int from = block[2 * i];
+            unsigned int to = block[2 * i + 1];
+            if (from >= nSections || to >= nSections) {
+                throw morphio::RawDataError(
+                    "Connection (" + std::to_string(from) + ", " + std::to_string(to) +
+                    ") refers to a section ID out of bounds (number of sections = " +
+                    std::to_string(nSections) + ")");
+            }
+            if (renumber(from) && renumber(to)) {
+                con.push_back({from, to});
+            }
+        }
+    };
+    readRows<unsigned int>(*_connectivity, 2, 0, _conDims[0], consume);
+}
+
 vasculature::property::Properties VasculatureHDF5::load() {
+    _open();
+    _readDatasets();
+    const auto points = _readSections(_properties, 0, _sectionsDims[0]);
+    _readPoints(_properties, points.first, points.second);
+    _properties._connectivity.reserve(_conDims[0]);
+    _readConnectivity([](unsigned int&) { return true; });
+
+    return std::move(_properties);
+}
+
+vasculature::property::Properties VasculatureHDF5::load(uint32_t firstSection,
+                                                        uint32_t lastSection) {
+    _open();
+    _readDatasets();
+    if (firstSection > lastSection || lastSection > _sectionsDims[0]) {
+        throw morphio::RawDataError("Opening vasculature file '" + _uri +
+                                    "': section range [" + std::to_string(firstSection) + ", " +
+                                    std::to_string(lastSection) +
+                                    ") out of bounds (number of sections = " +
+                                    std::to_string(_sectionsDims[0]) + ")");
+    }
+    const auto points = _readSections(_properties, firstSection, lastSection);
+    _readPoints(_properties, points.first, points.second);
+    _readConnectivity([firstSection, lastSection](unsigned int& id) {
+        if (id < firstSection || id >= lastSection) {
+            return false;
+        }
+        id -= firstSection;
+        return true;
+    });
+
+    return std::move(_properties);
+}
+
+vasculature::property::Properties VasculatureHDF5::load(const BoundingBox& region) {
+    _open();
+    _readDatasets();
+    auto& points = _properties.get<vasculature::property::Point>();
+    auto& diameters = _properties.get<vasculature::property::Diameter>();
+    auto& sections = _properties.get<vasculature::property::VascSection>();
+    auto& types = _properties.get<vasculature::property::SectionType>();
+
+    const size_t nSections = _sectionsDims[0];
+    RankedIds kept(nSections);
+    for (size_t first = 0; first < nSections; first += kSectionBlockRows) {
+        const size_t last = std::min(first + kSectionBlockRows, nSections);
+        vasculature::property::Properties block;
+        const auto blockPoints = _readSections(block, first, last);
+        _readPoints(block, blockPoints.first, blockPoints.second);
+
+        const auto& offsets = block.get<vasculature::property::VascSection>();
+        const auto& blockPositions = block.get<vasculature::property::Point>();
+        const auto& blockDiameters = block.get<vasculature::property::Diameter>();
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            const size_t begin = offsets[i];
+            const size_t end = i + 1 < offsets.size() ? offsets[i + 1] : blockPositions.size();
+            if (!intersects(region, blockPositions, blockDiameters, begin, end)) {
+                continue;
+            }
+            kept.insert(first + i);
+            sections.push_back(
+                static_cast<vasculature::property::VascSection::Type>(points.size()));
+            types.push_back(block.get<vasculature::property::SectionType>()[i]);
+            points.insert(points.end(),
+                          blockPositions.begin() + static_cast<std::ptrdiff_t>(begin),
+                          blockPositions.begin() + static_cast<std::ptrdiff_t>(end));
+            diameters.insert(diameters.end(),
+                             blockDiameters.begin() + static_cast<std::ptrdiff_t>(begin),
+                             blockDiameters.begin() + static_cast<std::ptrdiff_t>(end));
+        }
+    }
+
+    _readConnectivity([&kept](unsigned int& id) { return kept.renumber(id); });
+
+    return std::move(_properties);
+}
+
+void VasculatureHDF5::_open() {
     try {
         HighFive::SilenceHDF5 silence;
         _file.reset(new HighFive::File(_uri, HighFive::File::ReadOnly));
     } catch (const HighFive::FileException& exc) {
-        throw morphio::RawDataError(_write ? "Could not create vasculature file "
-                                           : "Could not open vasculature file " + _uri + ": " +
-                                                 exc.what());
+        throw morphio::RawDataError("Could not open vasculature file " + _uri + ": " +
+                                    exc.what());
     }
-    _readDatasets();
-    _readSections();
-    _readPoints();
-    _readSectionTypes();
-    _readConnectivity();
-
-    return _properties;
 }
 
 void VasculatureHDF5::_readDatasets() {
@@ -51,55 +246,77 @@ void VasculatureHDF5::_readDatasets() {
     }
 }
 
-void VasculatureHDF5::_readPoints() {
-    auto& points = _properties.get<vasculature::property::Point>();
-    auto& diameters = _properties.get<vasculature::property::Diameter>();
-
-    std::vector<std::vector<morphio::floatType>> vec;
-    vec.resize(_pointsDims[0]);
-    _points->read(vec);
-    for (const auto& p : vec) {
-        points.push_back({p[0], p[1], p[2]});
-        diameters.push_back(p[3]);
-    }
-}
-
-void VasculatureHDF5::_readSections() {
-    auto& sections = _properties.get<vasculature::property::VascSection>();
-    auto selection = _sections->select({0, 0}, {_sectionsDims[0], 1});
+std::pair<size_t, size_t> VasculatureHDF5::_readSections(
+    vasculature::property::Properties& properties, size_t firstSection, size_t lastSection) const {
+    auto& sections = properties.get<vasculature::property::VascSection>();
+    auto& types = properties.get<vasculature::property::SectionType>();
+    const size_t nPoints = _pointsDims[0];
 
-    std::vector<unsigned int> vec;
-    vec.resize(_sectionsDims[0]);
-    selection.read(vec);
+    // One more row for the offset where the last section ends
+    const size_t lastRow = std::min(lastSection + 1, _sectionsDims[0]);
+    std::vector<int64_t> offsets;
+    offsets.reserve(lastRow - firstSection);
+    types.reserve(lastSection - firstSection);
 
-    for (auto p : vec) {
-        sections.push_back(p);
+    // Offsets and types are read together and split in memory, see MorphologyHDF5
+    readRows<int64_t>(
+        *_sections, 2, firstSection, lastRow, [&](const std::vector<int64_t>& block, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                offsets.push_back(block[2 * i]);
+                const int64_t type = block[2 * i + 1];
+                if (types.size() < lastSection - firstSection) {
+                    if (type > SECTION_CUSTOM || type < 0) {
+                        throw morphio::RawDataError(_err.ERROR_UNSUPPORTED_VASCULATURE_SECTION_TYPE(
+                            0, static_cast<VascularSectionType>(type)));
+                    }
+                    types.push_back(static_cast<VascularSectionType>(type));
+                }
+            }
+        });
+    if (offsets.size() == lastSection - firstSection) {
+        offsets.push_back(static_cast<int64_t>(nPoints));
     }
-}
 
-void VasculatureHDF5::_readSectionTypes() {
-    std::vector<VascularSectionType>& types = _properties.get<vasculature::property::SectionType>();
-
-    auto selection = _sections->select({0, 1}, {_sectionsDims[0], 1});
-    types.resize(_sectionsDims[0]);
-    selection.read(types);
-    for (int type : types) {
-        if (type > SECTION_CUSTOM || type < 0) {
-            throw morphio::RawDataError(_err.ERROR_UNSUPPORTED_VASCULATURE_SECTION_TYPE(
-                0, static_cast<VascularSectionType>(type)));
+    // The points before the first section, if any, go with it when loading from the start
+    const int64_t firstPoint = firstSection == 0 ? 0 : offsets.front();
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        if (offsets[i] < 0 || offsets[i] > offsets[i + 1] ||
+            offsets[i + 1] > static_cast<int64_t>(nPoints)) {
+            throw morphio::RawDataError("Opening vasculature file '" + _uri + "': section " +
+                                        std::to_string(firstSection + i) +
+                                        " has out of order or out of bounds point offsets");
         }
     }
+    sections.reserve(lastSection - firstSection);
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        sections.push_back(static_cast<vasculature::property::VascSection::Type>(offsets[i] -
+                                                                                  firstPoint));
+    }
+    return {static_cast<size_t>(firstPoint), static_cast<size_t>(offsets.back())};
 }
 
-void VasculatureHDF5::_readConnectivity() {
-    std::vector<std::vector<unsigned int>> vec;
-    vec.resize(_conDims[0]);
-    _connectivity->read(vec);
-    auto& con = _properties._connectivity;
-    for (auto& v : vec) {
-        con.push_back({v[0], v[1]});
-    }
+void VasculatureHDF5::_readPoints(vasculature::property::Properties& properties,
+                                  size_t firstPoint,
+                                  size_t lastPoint) const {
+    auto& points = properties.get<vasculature::property::Point>();
+    auto& diameters = properties.get<vasculature::property::Diameter>();
+    points.reserve(lastPoint - firstPoint);
+    diameters.reserve(lastPoint - firstPoint);
+
+    readRows<morphio::floatType>(
+        *_points,
+        4,
+        firstPoint,
+        lastPoint,
+        [&points, &diameters](const std::vector<morphio::floatType>& block, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const morphio::floatType* row = &block[4 * i];
+                points.push_back({row[0], row[1], row[2]});
+                diameters.push_back(row[3]);
+            }
+        });
 }
+
 }  // namespace h5
 }  // namespace readers
 }  // namespace morphio
@@ -15,6 +15,12 @@ namespace morphio {
 namespace readers {
 namespace h5 {
 
+/**
+   Reader of the /points, /structure and /connectivity datasets of a vasculature file.
+
+   Each dataset is read once, in blocks of contiguous rows whose columns are split straight into
+   the properties, so that the temporary memory is bounded by the block size.
+**/
 class VasculatureHDF5
 {
   public:
@@ -24,14 +30,45 @@ class VasculatureHDF5
 
     virtual ~VasculatureHDF5() = default;
 
+    /** Load the whole vasculature **/
     vasculature::property::Properties load();
 
+    /**
+       Load the sections [firstSection, lastSection) only, renumbered from 0
+
+       Only their rows of /structure and /points are read, through hyperslabs. The connections
+       between two sections of the range are kept, the others dropped.
+
+       @throw RawDataError if the range is not within the sections of the file
+    **/
+    vasculature::property::Properties load(uint32_t firstSection, uint32_t lastSection);
+
+    /**
+       Load the sections intersecting the region, renumbered from 0 in file order, and the
+       connections between them
+
+       A section intersects the region if the bounding box of one of its segments, radii
+       included, does. The sections and their points are streamed block by block: memory is
+       proportional to the region rather than to the file.
+    **/
+    vasculature::property::Properties load(const BoundingBox& region);
+
   private:
+    void _open();
     void _readDatasets();
-    void _readPoints();
-    void _readSections();
-    void _readSectionTypes();
-    void _readConnectivity();
+    /** Return the [begin, end) range of the points of the sections **/
+    std::pair<size_t, size_t> _readSections(vasculature::property::Properties& properties,
+                                            size_t firstSection,
+                                            size_t lastSection) const;
+    void _readPoints(vasculature::property::Properties& properties,
+                     size_t firstPoint,
+                     size_t lastPoint) const;
+    /**
+       Keep the connections for which renumber(from) and renumber(to) both return true, after
+       they renumbered their argument
+    **/
+    template <typename Renumber>
+    void _readConnectivity(Renumber renumber);
 
     std::unique_ptr<HighFive::File> _file;
 
@@ -45,7 +82,6 @@ class VasculatureHDF5
     std::vector<size_t> _conDims;
 
     vasculature::property::Properties _properties;
-    bool _write;
     ErrorMessages _err;
     std::string _uri;
 };
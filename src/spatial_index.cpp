@@ -0,0 +1,349 @@
+#include <algorithm>  // std::nth_element, std::sort
+#include <cmath>      // std::sqrt
+#include <limits>     // std::numeric_limits
+#include <utility>    // std::swap
+
+#include <morphio/morphology.h>
+#include <morphio/spatial_index.h>
+#include <morphio/vasc/vasculature.h>
+
+#include "parallel.h"
+
+namespace morphio {
+namespace {
+
+// Maximum number of segments in a leaf
+constexpr uint32_t kLeafSize = 4;
+
+floatType dot(const Point& left, const Point& right) {
+    return left[0] * right[0] + left[1] * right[1] + left[2] * right[2];
+}
+
+floatType squaredDistanceToBox(const Point& point, const BoundingBox& box) {
+    floatType result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        floatType delta = 0;
+        if (point[i] < box.min[i]) {
+            delta = box.min[i] - point[i];
+        } else if (point[i] > box.max[i]) {
+            delta = point[i] - box.max[i];
+        }
+        result += delta * delta;
+    }
+    return result;
+}
+
+// Squared distance from the point to the [start, end] line segment
+floatType squaredDistanceToSegment(const Point& point, const Point& start, const Point& end) {
+    const Point axis = end - start;
+    const floatType length2 = dot(axis, axis);
+    floatType t = 0;
+    if (length2 > 0) {
+        t = std::min(std::max(dot(point - start, axis) / length2, floatType{0}), floatType{1});
+    }
+    const Point delta = point - (start + axis * t);
+    return dot(delta, delta);
+}
+
+// Slab test between the [start, end] line segment and the box
+bool segmentIntersectsBox(const Point& start, const Point& end, const BoundingBox& box) {
+    floatType tMin = 0;
+    floatType tMax = 1;
+    for (size_t i = 0; i < 3; ++i) {
+        const floatType direction = end[i] - start[i];
+        if (direction == 0) {
+            if (start[i] < box.min[i] || start[i] > box.max[i]) {
+                return false;
+            }
+            continue;
+        }
+        floatType t1 = (box.min[i] - start[i]) / direction;
+        floatType t2 = (box.max[i] - start[i]) / direction;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BoundingBox inflate(const BoundingBox& box, floatType radius) {
+    const Point offset{radius, radius, radius};
+    return {box.min - offset, box.max + offset};
+}
+
+}  // namespace
+
+bool SegmentId::operator==(const SegmentId& other) const noexcept {
+    return section == other.section && segment == other.segment;
+}
+
+bool SegmentId::operator!=(const SegmentId& other) const noexcept {
+    return !(*this == other);
+}
+
+bool SegmentId::operator<(const SegmentId& other) const noexcept {
+    return section < other.section || (section == other.section && segment < other.segment);
+}
+
+SpatialIndex::SpatialIndex(const Morphology& morphology) {
+    _build(morphology.points(), morphology.diameters(), morphology.sectionOffsets());
+}
+
+SpatialIndex::SpatialIndex(const vasculature::Vasculature& vasculature) {
+    _build(vasculature.points(), vasculature.diameters(), vasculature.sectionOffsets());
+}
+
+void SpatialIndex::_build(const Points& points,
+                          const std::vector<floatType>& diameters,
+                          const std::vector<uint32_t>& offsets) {
+    _segments.reserve(points.size());
+    for (uint32_t section = 0; section + 1 < offsets.size(); ++section) {
+        const uint32_t start = offsets[section];
+        const uint32_t end = offsets[section + 1];
+        for (uint32_t i = start; i + 1 < end; ++i) {
+            const floatType radius = std::max(diameters[i], diameters[i + 1]) / 2;
+            _segments.push_back({points[i], points[i + 1], radius, {section, i - start}});
+        }
+    }
+
+    if (_segments.empty()) {
+        return;
+    }
+    if (_segments.size() > std::numeric_limits<uint32_t>::max()) {
+        throw MorphioError("Too many segments to build a SpatialIndex");
+    }
+
+    // A tree with leaves of kLeafSize segments has less than 2 * n / kLeafSize + 1 nodes
+    // but median splits can leave half empty leaves
+    _nodes.reserve(2 * _segments.size() / (kLeafSize / 2) + 1);
+    _buildNode(0, static_cast<uint32_t>(_segments.size()));
+    _segments.shrink_to_fit();
+}
+
+uint32_t SpatialIndex::_buildNode(uint32_t begin, uint32_t end) {
+    BoundingBox box{_segments[begin].start, _segments[begin].start};
+    BoundingBox centroids = box;
+    for (uint32_t i = begin; i < end; ++i) {
+        const Segment& segment = _segments[i];
+        const Point offset{segment.radius, segment.radius, segment.radius};
+        box.expand(segment.start - offset);
+        box.expand(segment.start + offset);
+        box.expand(segment.end - offset);
+        box.expand(segment.end + offset);
+        centroids.expand((segment.start + segment.end) / 2);
+    }
+
+    const auto index = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back({box, begin, end - begin});
+    if (end - begin <= kLeafSize) {
+        return index;
+    }
+
+    size_t axis = 0;
+    for (size_t i = 1; i < 3; ++i) {
+        if (centroids.max[i] - centroids.min[i] > centroids.max[axis] - centroids.min[axis]) {
+            axis = i;
+        }
+    }
+
+    const uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(_segments.begin() + begin,
+                     _segments.begin() + middle,
+                     _segments.begin() + end,
+                     [axis](const Segment& left, const Segment& right) {
+                         return left.start[axis] + left.end[axis] <
+                                right.start[axis] + right.end[axis];
+                     });
+
+    _buildNode(begin, middle);
+    const uint32_t right = _buildNode(middle, end);
+    _nodes[index].first = right;
+    _nodes[index].count = 0;
+    return index;
+}
+
+size_t SpatialIndex::size() const noexcept {
+    return _segments.size();
+}
+
+BoundingBox SpatialIndex::bounds() const {
+    if (_nodes.empty()) {
+        throw MorphioError("The SpatialIndex is empty");
+    }
+    return _nodes.front().box;
+}
+
+template <typename Accept>
+void SpatialIndex::_collect(const BoundingBox& region,
+                            Accept accept,
+                            std::vector<SegmentId>& result) const {
+    if (_nodes.empty()) {
+        return;
+    }
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        const auto index = stack.back();
+        stack.pop_back();
+        if (!node.box.intersects(region)) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            if (accept(_segments[i])) {
+                result.push_back(_segments[i].id);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+std::vector<SegmentId> SpatialIndex::intersects(const BoundingBox& box) const {
+    std::vector<SegmentId> result;
+    _collect(box,
+             [&box](const Segment& segment) {
+                 const floatType radius2 = segment.radius * segment.radius;
+                 if (!segmentIntersectsBox(segment.start,
+                                           segment.end,
+                                           inflate(box, segment.radius))) {
+                     return false;
+                 }
+                 if (segmentIntersectsBox(segment.start, segment.end, box) ||
+                     squaredDistanceToBox(segment.start, box) <= radius2 ||
+                     squaredDistanceToBox(segment.end, box) <= radius2) {
+                     return true;
+                 }
+                 // The axis goes through the inflated box corners or edges only: the squared
+                 // distance to the box is convex along the axis, find its minimum
+                 const Point axis = segment.end - segment.start;
+                 const floatType five = 5;
+                 const floatType ratio = (std::sqrt(five) - 1) / 2;
+                 floatType low = 0;
+                 floatType high = 1;
+                 for (int i = 0; i < 40; ++i) {
+                     const floatType t1 = high - ratio * (high - low);
+                     const floatType t2 = low + ratio * (high - low);
+                     if (squaredDistanceToBox(segment.start + axis * t1, box) <
+                         squaredDistanceToBox(segment.start + axis * t2, box)) {
+                         high = t2;
+                     } else {
+                         low = t1;
+                     }
+                 }
+                 return squaredDistanceToBox(segment.start + axis * ((low + high) / 2), box) <=
+                        radius2;
+             },
+             result);
+    return result;
+}
+
+std::vector<SegmentId> SpatialIndex::intersects(const Point& center, floatType radius) const {
+    std::vector<SegmentId> result;
+    _collect(inflate({center, center}, radius),
+             [&center, radius](const Segment& segment) {
+                 const floatType reach = radius + segment.radius;
+                 return squaredDistanceToSegment(center, segment.start, segment.end) <=
+                        reach * reach;
+             },
+             result);
+    return result;
+}
+
+NearestSegment SpatialIndex::nearest(const Point& point) const {
+    if (_nodes.empty()) {
+        throw MorphioError("The SpatialIndex is empty");
+    }
+
+    floatType best = std::numeric_limits<floatType>::max();
+    SegmentId bestId{0, 0};
+    // pairs of (squared distance to the node box, node index); node boxes contain their
+    // capsules so a node further than the best segment found so far can be skipped
+    std::vector<std::pair<floatType, uint32_t>> stack{
+        {squaredDistanceToBox(point, _nodes[0].box), 0}};
+    while (!stack.empty()) {
+        const auto candidate = stack.back();
+        stack.pop_back();
+        if (candidate.first > best * best) {
+            continue;
+        }
+        const Node& node = _nodes[candidate.second];
+        if (node.count == 0) {
+            const uint32_t left = candidate.second + 1;
+            const floatType leftDistance = squaredDistanceToBox(point, _nodes[left].box);
+            const floatType rightDistance = squaredDistanceToBox(point, _nodes[node.first].box);
+            // visit the closest child first
+            if (leftDistance < rightDistance) {
+                stack.emplace_back(rightDistance, node.first);
+                stack.emplace_back(leftDistance, left);
+            } else {
+                stack.emplace_back(leftDistance, left);
+                stack.emplace_back(rightDistance, node.first);
+            }
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const Segment& segment = _segments[i];
+            const floatType distance = std::max(
+                std::sqrt(squaredDistanceToSegment(point, segment.start, segment.end)) -
+                    segment.radius,
+                floatType{0});
+            if (distance < best || (distance == best && segment.id < bestId)) {
+                best = distance;
+                bestId = segment.id;
+            }
+        }
+    }
+    return {bestId, best};
+}
+
+std::vector<std::vector<SegmentId>> SpatialIndex::intersects(const std::vector<BoundingBox>& boxes,
+                                                             unsigned int nThreads) const {
+    std::vector<std::vector<SegmentId>> result(boxes.size());
+    detail::parallelFor(boxes.size(), nThreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = intersects(boxes[i]);
+        }
+    });
+    return result;
+}
+
+std::vector<std::vector<SegmentId>> SpatialIndex::intersects(const Points& centers,
+                                                             const std::vector<floatType>& radii,
+                                                             unsigned int nThreads) const {
+    if (centers.size() != radii.size()) {
+        throw MorphioError("SpatialIndex: got " + std::to_string(centers.size()) +
+                           " centers but " + std::to_string(radii.size()) + " radii");
+    }
+    std::vector<std::vector<SegmentId>> result(centers.size());
+    detail::parallelFor(centers.size(), nThreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = intersects(centers[i], radii[i]);
+        }
+    });
+    return result;
+}
+
+std::vector<NearestSegment> SpatialIndex::nearest(const Points& points,
+                                                  unsigned int nThreads) const {
+    if (_nodes.empty() && !points.empty()) {
+        throw MorphioError("The SpatialIndex is empty");
+    }
+    std::vector<NearestSegment> result(points.size());
+    detail::parallelFor(points.size(), nThreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = nearest(points[i]);
+        }
+    });
+    return result;
+}
+
+}  // namespace morphio
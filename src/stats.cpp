@@ -0,0 +1,77 @@
+#include <morphio/stats.h>
+
+#include "stats.h"
+
+namespace morphio {
+
+#ifdef MORPHIO_ENABLE_STATS
+namespace detail {
+Stats*& currentStats() noexcept {
+    static thread_local Stats* stats = nullptr;
+    return stats;
+}
+}  // namespace detail
+
+bool statsEnabled() noexcept {
+    return true;
+}
+
+StatsCollector::StatsCollector(Stats& stats) noexcept
+    : _previous(detail::currentStats()) {
+    detail::currentStats() = &stats;
+}
+
+StatsCollector::~StatsCollector() {
+    detail::currentStats() = _previous;
+}
+
+#else
+
+bool statsEnabled() noexcept {
+    return false;
+}
+
+StatsCollector::StatsCollector(Stats&) noexcept
+    : _previous(nullptr) {}
+
+StatsCollector::~StatsCollector() = default;
+
+#endif
+
+const char* Stats::phaseName(Phase phase) {
+    switch (phase) {
+    case LOAD:
+        return "load";
+    case READ:
+        return "read";
+    case PROBE:
+        return "probe";
+    case PARSE:
+        return "parse";
+    case SANITIZE:
+        return "sanitize";
+    case MODIFIERS:
+        return "modifiers";
+    case BUILD_READ_ONLY:
+        return "build_read_only";
+    case BUILD_CHILDREN:
+        return "build_children";
+    case PHASE_COUNT:
+        break;
+    }
+    return "unknown";
+}
+
+Stats& Stats::operator+=(const Stats& other) noexcept {
+    loads += other.loads;
+    bytesRead += other.bytesRead;
+    allocatedBytes += other.allocatedBytes;
+    warnings += other.warnings;
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        seconds[i] += other.seconds[i];
+        calls[i] += other.calls[i];
+    }
+    return *this;
+}
+
+}  // namespace morphio
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>   // std::chrono
+#include <cstdint>  // uint64_t
+
+#include <morphio/stats.h>
+
+namespace morphio {
+namespace detail {
+
+#ifdef MORPHIO_ENABLE_STATS
+
+/** The Stats of the calling thread's innermost StatsCollector, nullptr if there is none **/
+Stats*& currentStats() noexcept;
+
+/** Add the wall time of its scope to a phase of the current Stats **/
+class PhaseTimer
+{
+  public:
+    explicit PhaseTimer(Stats::Phase phase) noexcept
+        : _stats(currentStats())
+        , _phase(phase) {
+        if (_stats) {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PhaseTimer() {
+        if (_stats) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() -
+                                                          _start;
+            _stats->seconds[_phase] += elapsed.count();
+            ++_stats->calls[_phase];
+        }
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+  private:
+    Stats* _stats;
+    Stats::Phase _phase;
+    std::chrono::steady_clock::time_point _start;
+};
+
+inline void countBytesRead(uint64_t bytes) noexcept {
+    if (Stats* stats = currentStats()) {
+        stats->bytesRead += bytes;
+    }
+}
+
+inline void countLoad(uint64_t allocatedBytes) noexcept {
+    if (Stats* stats = currentStats()) {
+        ++stats->loads;
+        stats->allocatedBytes += allocatedBytes;
+    }
+}
+
+inline void countWarning() noexcept {
+    if (Stats* stats = currentStats()) {
+        ++stats->warnings;
+    }
+}
+
+inline bool collectingStats() noexcept {
+    return currentStats() != nullptr;
+}
+
+#else
+
+class PhaseTimer
+{
+  public:
+    explicit PhaseTimer(Stats::Phase) noexcept {}
+};
+
+inline void countBytesRead(uint64_t) noexcept {}
+inline void countLoad(uint64_t) noexcept {}
+inline void countWarning() noexcept {}
+inline bool collectingStats() noexcept {
+    return false;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace morphio
@@ -0,0 +1,234 @@
+#include <morphio/synthetic.h>
+
+#include <algorithm>  // std::max, std::min, std::sort
+#include <cmath>      // std::sqrt
+#include <queue>      // std::queue
+#include <random>     // std::mt19937
+
+#include <morphio/exceptions.h>
+#include <morphio/mut/section.h>
+
+namespace morphio {
+namespace synthetic {
+
+namespace {
+
+Point unit(const Point& vector) {
+    const floatType norm = std::sqrt(vector[0] * vector[0] + vector[1] * vector[1] +
+                                     vector[2] * vector[2]);
+    return {vector[0] / norm, vector[1] / norm, vector[2] / norm};
+}
+
+/** Random draws shared by the generators **/
+class Random
+{
+  public:
+    explicit Random(uint32_t seed)
+        : _generator(seed) {}
+
+    floatType normal() {
+        return _normal(_generator);
+    }
+
+    /** Uniform in [0, 1) **/
+    floatType uniform() {
+        return _uniform(_generator);
+    }
+
+    /** Uniform in [0, n) **/
+    uint32_t index(uint32_t n) {
+        return std::uniform_int_distribution<uint32_t>(0, n - 1)(_generator);
+    }
+
+    /** A direction close to the given one, deviation being the spread of the angle **/
+    Point deviate(const Point& direction, floatType deviation) {
+        return unit({direction[0] + normal() * deviation,
+                     direction[1] + normal() * deviation,
+                     direction[2] + normal() * deviation});
+    }
+
+  private:
+    std::mt19937 _generator;
+    std::normal_distribution<floatType> _normal;
+    std::uniform_real_distribution<floatType> _uniform;
+};
+
+struct Growing {
+    std::shared_ptr<mut::Section> section;
+    uint32_t depth;
+    Point direction;
+};
+
+void addMitochondria(mut::Morphology& morphology,
+                     const NeuronParameters& parameters,
+                     Random& random) {
+    std::vector<std::shared_ptr<mut::Section>> sections;
+    for (const auto& section : morphology.sections()) {
+        sections.push_back(section.second);
+    }
+
+    auto points = [&random](uint32_t sectionId) {
+        std::vector<floatType> lengths{random.uniform(), random.uniform(), random.uniform()};
+        std::sort(lengths.begin(), lengths.end());
+        return Property::MitochondriaPointLevel(std::vector<uint32_t>(3, sectionId),
+                                                lengths,
+                                                std::vector<floatType>(3, floatType{3} / 10));
+    };
+
+    for (uint32_t i = 0; i < parameters.mitochondria; ++i) {
+        const auto& section = sections[random.index(static_cast<uint32_t>(sections.size()))];
+        const auto root = morphology.mitochondria().appendRootSection(points(section->id()));
+        const auto children = section->children();
+        if (!children.empty()) {
+            root->appendSection(points(children.front()->id()));
+        }
+    }
+}
+
+void addReticulum(mut::Morphology& morphology, const NeuronParameters& parameters, Random& random) {
+    auto& reticulum = morphology.endoplasmicReticulum();
+    for (const auto& section : morphology.sections()) {
+        if (random.uniform() < parameters.reticulumRate) {
+            reticulum.sectionIndices().push_back(section.first);
+            reticulum.volumes().push_back(1 + random.uniform());
+            reticulum.surfaceAreas().push_back(10 + 10 * random.uniform());
+            reticulum.filamentCounts().push_back(1 + random.index(5));
+        }
+    }
+}
+
+}  // anonymous namespace
+
+mut::Morphology neuron(const NeuronParameters& parameters) {
+    if (parameters.neurites == 0 || parameters.fanOut == 0 || parameters.pointsPerSection == 0) {
+        throw SectionBuilderError(
+            "Synthetic neurons need at least one neurite, one child per branching section and "
+            "one point per section");
+    }
+    Random random(parameters.seed);
+    const SectionType neuriteTypes[] = {SECTION_AXON, SECTION_DENDRITE, SECTION_APICAL_DENDRITE};
+    const floatType somaRadius = 5;
+
+    mut::Morphology morphology;
+    morphology.soma()->points() = {{0, 0, 0}};
+    morphology.soma()->diameters() = {2 * somaRadius};
+
+    // Random walk of pointsPerSection points from start, updating direction as it turns
+    auto walk = [&](const Point& start, Point& direction, floatType diameter) {
+        Property::PointLevel level;
+        level._points.reserve(parameters.pointsPerSection);
+        Point point = start;
+        for (uint32_t i = 0; i < parameters.pointsPerSection; ++i) {
+            if (i > 0) {
+                direction = random.deviate(direction, floatType{1} / 4);
+                point = point + direction * parameters.segmentLength;
+            }
+            level._points.push_back(point);
+        }
+        level._diameters.assign(parameters.pointsPerSection, diameter);
+        return level;
+    };
+
+    uint32_t nSections = 0;
+    auto full = [&]() {
+        return parameters.maxSections != 0 && nSections >= parameters.maxSections;
+    };
+
+    std::queue<Growing> growing;
+    for (uint32_t i = 0; i < parameters.neurites && !full(); ++i, ++nSections) {
+        Point direction = random.deviate({0, 0, 0}, 1);
+        const auto level = walk(direction * somaRadius, direction, parameters.rootDiameter);
+        growing.push({morphology.appendRootSection(level, neuriteTypes[i % 3]), 0, direction});
+    }
+
+    while (!growing.empty() && !full()) {
+        const Growing parent = growing.front();
+        growing.pop();
+        if (parent.depth >= parameters.maxDepth) {
+            continue;
+        }
+        const uint32_t nChildren = random.uniform() < parameters.unifurcationRate
+                                       ? 1
+                                       : parameters.fanOut;
+        const floatType diameter = std::max(parent.section->diameters().back() * parameters.taper,
+                                            parameters.minDiameter);
+        for (uint32_t i = 0; i < nChildren && !full(); ++i, ++nSections) {
+            Point direction = random.deviate(parent.direction, floatType{1} / 2);
+            const auto level = walk(parent.section->points().back(), direction, diameter);
+            const auto child = parent.section->appendSection(level);
+            const bool leaf = i > 0 && random.uniform() < parameters.leafRate;
+            if (!leaf) {
+                growing.push({child, parent.depth + 1, direction});
+            }
+        }
+    }
+
+    if (parameters.mitochondria > 0) {
+        addMitochondria(morphology, parameters, random);
+    }
+    if (parameters.reticulumRate > 0) {
+        addReticulum(morphology, parameters, random);
+    }
+    return morphology;
+}
+
+vasculature::mut::Vasculature vasculature(const VasculatureParameters& parameters) {
+    if (parameters.pointsPerSection == 0 || parameters.window == 0) {
+        throw SectionBuilderError(
+            "Synthetic vasculatures need at least one point per section and a window of one "
+            "section");
+    }
+    Random random(parameters.seed);
+    const uint32_t nSections = parameters.sections;
+    const uint32_t nPoints = parameters.pointsPerSection;
+
+    Points points;
+    std::vector<floatType> diameters;
+    std::vector<uint32_t> offsets;
+    std::vector<VascularSectionType> types;
+    std::vector<vasculature::property::Connection::Type> connectivity;
+    points.reserve(size_t{nSections} * nPoints);
+    diameters.reserve(size_t{nSections} * nPoints);
+    offsets.reserve(nSections);
+    types.reserve(nSections);
+    connectivity.reserve(nSections);
+
+    auto earlier = [&](uint32_t section) {
+        return section - 1 - random.index(std::min(section, parameters.window));
+    };
+
+    for (uint32_t i = 0; i < nSections; ++i) {
+        Point point{0, 0, 0};
+        if (i > 0) {
+            const uint32_t parent = earlier(i);
+            connectivity.push_back({parent, i});
+            point = points[offsets[parent] + nPoints - 1];
+            if (i > 1 && random.uniform() < parameters.loopRate) {
+                const uint32_t other = earlier(i);
+                if (other != parent) {
+                    connectivity.push_back({other, i});
+                }
+            }
+        }
+        offsets.push_back(static_cast<uint32_t>(points.size()));
+        types.push_back(static_cast<VascularSectionType>(
+            static_cast<uint32_t>(SECTION_VEIN) +
+            random.index(static_cast<uint32_t>(SECTION_TRANSITIONAL - SECTION_VEIN + 1))));
+        for (uint32_t j = 0; j < nPoints; ++j) {
+            points.push_back(point);
+            diameters.push_back(2 + random.normal() / 4);
+            point = point + Point{parameters.stepDeviation * random.normal(),
+                                  parameters.stepDeviation * random.normal(),
+                                  parameters.stepDeviation * random.normal()};
+        }
+    }
+
+    vasculature::mut::Vasculature result;
+    if (nSections > 0) {
+        result.appendSections(points, diameters, offsets, types, connectivity);
+    }
+    return result;
+}
+
+}  // namespace synthetic
+}  // namespace morphio
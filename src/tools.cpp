@@ -0,0 +1,135 @@
+#include <cmath>     // std::fabs
+#include <iostream>  // std::cerr
+#include <string>    // std::string
+
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/section.h>
+#include <morphio/soma.h>
+#include <morphio/tools.h>
+
+namespace morphio {
+namespace {
+
+/** Diff messages are a log, not warnings: they skip the warning sinks and their limits **/
+void report(LogLevel verbose, const std::string& message) {
+    if (verbose > LogLevel::ERROR) {
+        std::cerr << message << '\n';
+    }
+}
+
+bool differ(floatType left, floatType right) noexcept {
+    return std::fabs(left - right) > epsilon;
+}
+
+bool differ(const Point& left, const Point& right) noexcept {
+    return distance(left, right) > epsilon;
+}
+
+/** Whether the values, or the points, are further apart than epsilon **/
+template <typename Left, typename Right>
+bool differ(const Left& left, const Right& right, const std::string& name, LogLevel verbose) {
+    if (left.size() != right.size()) {
+        report(verbose,
+               name + " size differs: " + std::to_string(left.size()) + " vs " +
+                   std::to_string(right.size()));
+        return true;
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+        if (differ(left[i], right[i])) {
+            report(verbose,
+                   name + " differ at index " + std::to_string(i) + ": " +
+                       std::to_string(left[i]) + " <--> " + std::to_string(right[i]));
+            return true;
+        }
+    }
+    return false;
+}
+
+/** The section attributes, without the children **/
+template <typename Section>
+bool differ(const Section& left, const Section& right, LogLevel verbose) {
+    const std::string name = "Section " + std::to_string(left.id());
+    if (left.type() != right.type()) {
+        report(verbose, name + " type differs");
+        return true;
+    }
+    return differ(left.points(), right.points(), name + " points", verbose) ||
+           differ(left.diameters(), right.diameters(), name + " diameters", verbose) ||
+           differ(left.perimeters(), right.perimeters(), name + " perimeters", verbose);
+}
+
+}  // namespace
+
+bool diff(const Morphology& left, const Morphology& right, LogLevel verbose) {
+    // The structure hashes are cheap to compute, and their mismatch a sure difference
+    Property::HashOptions structure;
+    structure.points = false;
+    if (left.contentHash(structure) != right.contentHash(structure)) {
+        report(verbose, "Morphology structures differ");
+        return true;
+    }
+
+    if (differ(left.soma().points(), right.soma().points(), "Soma points", verbose) ||
+        differ(left.soma().diameters(), right.soma().diameters(), "Soma diameters", verbose)) {
+        return true;
+    }
+
+    // Same structure: sections have the same ids, parents and numbers of points
+    const auto leftSections = left.sections();
+    const auto rightSections = right.sections();
+    for (size_t i = 0; i < leftSections.size(); ++i) {
+        if (differ(leftSections[i], rightSections[i], verbose)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool diff(const Section& left, const Section& right, LogLevel verbose) {
+    if (differ(left, right, verbose)) {
+        return true;
+    }
+
+    const auto leftChildren = left.children();
+    const auto rightChildren = right.children();
+    if (leftChildren.size() != rightChildren.size()) {
+        report(verbose, "Section " + std::to_string(left.id()) + " children count differs");
+        return true;
+    }
+    for (size_t i = 0; i < leftChildren.size(); ++i) {
+        if (diff(leftChildren[i], rightChildren[i], verbose)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace mut {
+
+bool diff(const Morphology& left, const Morphology& right, LogLevel verbose) {
+    return morphio::diff(morphio::Morphology(left), morphio::Morphology(right), verbose);
+}
+
+bool diff(const Section& left, const Section& right, LogLevel verbose) {
+    if (differ(left, right, verbose)) {
+        return true;
+    }
+
+    const auto& leftChildren = left.children();
+    const auto& rightChildren = right.children();
+    if (leftChildren.size() != rightChildren.size()) {
+        report(verbose, "Section " + std::to_string(left.id()) + " children count differs");
+        return true;
+    }
+    for (size_t i = 0; i < leftChildren.size(); ++i) {
+        if (diff(*leftChildren[i], *rightChildren[i], verbose)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace mut
+}  // namespace morphio
@@ -0,0 +1,238 @@
+#include <morphio/vasc/metrics.h>
+
+#include <algorithm>  // std::min, std::max
+#include <cmath>      // std::sqrt
+#include <limits>     // std::numeric_limits
+#include <numeric>    // std::iota
+#include <string>     // std::to_string
+
+#include <morphio/exceptions.h>
+
+#include "../parallel.h"
+
+namespace morphio {
+namespace vasculature {
+namespace metrics {
+
+namespace {
+
+/** The first point of every section, followed by the number of points **/
+std::vector<uint32_t> pointOffsets(const property::Properties& properties) {
+    const auto& sections = properties._sectionLevel._sections;
+    std::vector<uint32_t> offsets(sections.begin(), sections.end());
+    offsets.push_back(static_cast<uint32_t>(properties._pointLevel._points.size()));
+    return offsets;
+}
+
+struct SegmentLength {
+    floatType operator()(const Point& start, const Point& end, floatType, floatType) const {
+        return distance(start, end);
+    }
+};
+
+struct SegmentVolume {
+    floatType operator()(const Point& start, const Point& end, floatType r0, floatType r1) const {
+        return PI * distance(start, end) * (r0 * r0 + r0 * r1 + r1 * r1) / 3;
+    }
+};
+
+struct SegmentLateralArea {
+    floatType operator()(const Point& start, const Point& end, floatType r0, floatType r1) const {
+        const floatType length = distance(start, end);
+        return PI * (r0 + r1) * std::sqrt((r0 - r1) * (r0 - r1) + length * length);
+    }
+};
+
+/** Call function(section, segment, value) on every segment, sections split among threads **/
+template <typename Kernel, typename Function>
+void forEachSegment(const property::Properties& properties,
+                    unsigned int nThreads,
+                    Kernel kernel,
+                    Function function) {
+    const auto& points = properties._pointLevel._points;
+    const auto& diameters = properties._pointLevel._diameters;
+    const std::vector<uint32_t> offsets = pointOffsets(properties);
+    const size_t nSections = offsets.size() - 1;
+    nThreads = detail::threadCount(points.size(), detail::kMinPointsPerThread, nThreads);
+
+    detail::parallelFor(nSections, nThreads, [&](size_t begin, size_t end) {
+        for (size_t section = begin; section < end; ++section) {
+            for (uint32_t i = offsets[section]; i + 1 < offsets[section + 1]; ++i) {
+                function(section,
+                         i - offsets[section],
+                         kernel(points[i], points[i + 1], diameters[i] / 2, diameters[i + 1] / 2));
+            }
+        }
+    });
+}
+
+template <typename Kernel>
+std::vector<floatType> perSegment(const property::Properties& properties,
+                                  unsigned int nThreads,
+                                  Kernel kernel) {
+    const std::vector<uint32_t> offsets = segmentOffsets(properties);
+    std::vector<floatType> result(offsets.back());
+    forEachSegment(properties,
+                   nThreads,
+                   kernel,
+                   [&](size_t section, uint32_t segment, floatType value) {
+                       result[offsets[section] + segment] = value;
+                   });
+    return result;
+}
+
+template <typename Kernel>
+std::vector<floatType> perSection(const property::Properties& properties,
+                                  unsigned int nThreads,
+                                  Kernel kernel) {
+    std::vector<floatType> result(properties._sectionLevel._sections.size(), 0);
+    forEachSegment(properties, nThreads, kernel, [&](size_t section, uint32_t, floatType value) {
+        result[section] += value;
+    });
+    return result;
+}
+
+/** Root of the set of node in the union-find forest, with path halving **/
+uint32_t findRoot(std::vector<uint32_t>& parents, uint32_t node) {
+    while (parents[node] != node) {
+        parents[node] = parents[parents[node]];
+        node = parents[node];
+    }
+    return node;
+}
+
+/** Throw RawDataError if a connection refers to a missing section **/
+void checkConnectivity(const property::Properties& properties) {
+    const size_t nSections = properties._sectionLevel._sections.size();
+    for (const auto& connection : properties._connectivity) {
+        if (connection[0] >= nSections || connection[1] >= nSections) {
+            throw RawDataError("Connection (" + std::to_string(connection[0]) + ", " +
+                               std::to_string(connection[1]) +
+                               ") refers to a section ID out of bounds (number of sections = " +
+                               std::to_string(nSections) + ")");
+        }
+    }
+}
+
+}  // anonymous namespace
+
+std::vector<uint32_t> segmentOffsets(const property::Properties& properties) {
+    const std::vector<uint32_t> points = pointOffsets(properties);
+    std::vector<uint32_t> offsets(points.size(), 0);
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+        const uint32_t nPoints = points[i + 1] - points[i];
+        offsets[i + 1] = offsets[i] + (nPoints > 0 ? nPoints - 1 : 0);
+    }
+    return offsets;
+}
+
+std::vector<floatType> segmentLengths(const property::Properties& properties,
+                                      unsigned int nThreads) {
+    return perSegment(properties, nThreads, SegmentLength());
+}
+
+std::vector<floatType> segmentVolumes(const property::Properties& properties,
+                                      unsigned int nThreads) {
+    return perSegment(properties, nThreads, SegmentVolume());
+}
+
+std::vector<floatType> segmentLateralAreas(const property::Properties& properties,
+                                           unsigned int nThreads) {
+    return perSegment(properties, nThreads, SegmentLateralArea());
+}
+
+std::vector<floatType> sectionLengths(const property::Properties& properties,
+                                      unsigned int nThreads) {
+    return perSection(properties, nThreads, SegmentLength());
+}
+
+std::vector<floatType> sectionVolumes(const property::Properties& properties,
+                                      unsigned int nThreads) {
+    return perSection(properties, nThreads, SegmentVolume());
+}
+
+std::vector<floatType> sectionLateralAreas(const property::Properties& properties,
+                                           unsigned int nThreads) {
+    return perSection(properties, nThreads, SegmentLateralArea());
+}
+
+std::vector<floatType> sectionMeanDiameters(const property::Properties& properties,
+                                            unsigned int nThreads) {
+    const auto& points = properties._pointLevel._points;
+    const auto& diameters = properties._pointLevel._diameters;
+    const std::vector<uint32_t> offsets = pointOffsets(properties);
+    const size_t nSections = offsets.size() - 1;
+    nThreads = detail::threadCount(points.size(), detail::kMinPointsPerThread, nThreads);
+
+    std::vector<floatType> result(nSections, 0);
+    detail::parallelFor(nSections, nThreads, [&](size_t begin, size_t end) {
+        for (size_t section = begin; section < end; ++section) {
+            const uint32_t first = offsets[section];
+            const uint32_t last = offsets[section + 1];
+            floatType length = 0;
+            floatType weighted = 0;
+            floatType sum = 0;
+            for (uint32_t i = first; i < last; ++i) {
+                sum += diameters[i];
+                if (i + 1 < last) {
+                    const floatType segment = distance(points[i], points[i + 1]);
+                    length += segment;
+                    weighted += segment * (diameters[i] + diameters[i + 1]) / 2;
+                }
+            }
+            if (length > 0) {
+                result[section] = weighted / length;
+            } else if (last > first) {
+                result[section] = sum / static_cast<floatType>(last - first);
+            }
+        }
+    });
+    return result;
+}
+
+std::vector<uint32_t> degrees(const property::Properties& properties) {
+    // From the connectivity, as vesselGraph: properties built by mut::Vasculature have no
+    // predecessor and successor arrays
+    checkConnectivity(properties);
+    std::vector<uint32_t> result(properties._sectionLevel._sections.size(), 0);
+    for (const auto& connection : properties._connectivity) {
+        ++result[connection[0]];
+        ++result[connection[1]];
+    }
+    return result;
+}
+
+VesselGraph vesselGraph(const property::Properties& properties, unsigned int nThreads) {
+    checkConnectivity(properties);
+    const size_t nSections = properties._sectionLevel._sections.size();
+
+    // Node 2 * i is the start of section i, node 2 * i + 1 its end
+    std::vector<uint32_t> parents(2 * nSections);
+    std::iota(parents.begin(), parents.end(), 0u);
+    for (const auto& connection : properties._connectivity) {
+        const uint32_t from = findRoot(parents, 2 * connection[0] + 1);
+        const uint32_t to = findRoot(parents, 2 * connection[1]);
+        if (from != to) {
+            parents[std::max(from, to)] = std::min(from, to);
+        }
+    }
+
+    VesselGraph graph;
+    std::vector<uint32_t> labels(2 * nSections, std::numeric_limits<uint32_t>::max());
+    graph.sources.resize(nSections);
+    graph.targets.resize(nSections);
+    for (uint32_t node = 0; node < 2 * nSections; ++node) {
+        uint32_t& label = labels[findRoot(parents, node)];
+        if (label == std::numeric_limits<uint32_t>::max()) {
+            label = graph.nodeCount++;
+        }
+        (node % 2 == 0 ? graph.sources : graph.targets)[node / 2] = label;
+    }
+    graph.lengths = sectionLengths(properties, nThreads);
+    graph.diameters = sectionMeanDiameters(properties, nThreads);
+    return graph;
+}
+
+}  // namespace metrics
+}  // namespace vasculature
+}  // namespace morphio
@@ -0,0 +1,214 @@
+#include <morphio/vasc/mut/vasculature.h>
+
+#include <limits>  // std::numeric_limits
+
+#include <morphio/errorMessages.h>
+#include <morphio/vasc/mut/writers.h>
+#include <morphio/vasc/vasculature.h>
+
+namespace morphio {
+namespace vasculature {
+namespace mut {
+
+namespace {
+
+/** Throw unless id is a section of the vasculature **/
+void checkSectionId(uint32_t id, size_t nSections) {
+    if (id >= nSections) {
+        throw SectionBuilderError("Section ID (" + std::to_string(id) +
+                                  ") is out of array bounds (array size = " +
+                                  std::to_string(nSections) + ")");
+    }
+}
+
+}  // anonymous namespace
+
+Vasculature::Vasculature(const std::string& source)
+    : Vasculature(vasculature::Vasculature(source)) {}
+
+Vasculature::Vasculature(const vasculature::Vasculature& vasculature)
+    : _properties(*vasculature._properties) {
+    // The adjacency is rebuilt by buildReadOnly
+    auto& sectionLevel = _properties._sectionLevel;
+    sectionLevel._predecessorOffsets = {};
+    sectionLevel._predecessors = {};
+    sectionLevel._successorOffsets = {};
+    sectionLevel._successors = {};
+}
+
+std::vector<uint32_t> Vasculature::sectionOffsets() const {
+    const auto& offsets = _properties._sectionLevel._sections;
+    std::vector<uint32_t> result(offsets.begin(), offsets.end());
+    result.push_back(static_cast<uint32_t>(points().size()));
+    return result;
+}
+
+range<Point> Vasculature::sectionPoints(uint32_t id) {
+    checkSectionId(id, sectionCount());
+    const auto& offsets = _properties._sectionLevel._sections;
+    const size_t end = id + 1 < offsets.size() ? offsets[id + 1] : points().size();
+    return {_properties._pointLevel._points.data() + offsets[id], end - offsets[id]};
+}
+
+range<const Point> Vasculature::sectionPoints(uint32_t id) const {
+    return const_cast<Vasculature*>(this)->sectionPoints(id);
+}
+
+range<morphio::floatType> Vasculature::sectionDiameters(uint32_t id) {
+    checkSectionId(id, sectionCount());
+    const auto& offsets = _properties._sectionLevel._sections;
+    const size_t end = id + 1 < offsets.size() ? offsets[id + 1] : points().size();
+    return {_properties._pointLevel._diameters.data() + offsets[id], end - offsets[id]};
+}
+
+range<const morphio::floatType> Vasculature::sectionDiameters(uint32_t id) const {
+    return const_cast<Vasculature*>(this)->sectionDiameters(id);
+}
+
+MemoryUsage Vasculature::memoryUsage() const {
+    return _properties.memoryUsage();
+}
+
+void Vasculature::shrinkToFit() {
+    _properties.shrinkToFit();
+}
+
+void Vasculature::_checkConnections(const std::vector<property::Connection::Type>& connectivity,
+                                    size_t nSections) const {
+    for (const auto& connection : connectivity) {
+        if (connection[0] >= nSections || connection[1] >= nSections) {
+            throw SectionBuilderError(
+                "Connection (" + std::to_string(connection[0]) + ", " +
+                std::to_string(connection[1]) +
+                ") refers to a section ID out of bounds (number of sections = " +
+                std::to_string(nSections) + ")");
+        }
+    }
+}
+
+uint32_t Vasculature::appendSections(const Points& points,
+                                     const std::vector<morphio::floatType>& diameters,
+                                     const std::vector<uint32_t>& pointOffsets,
+                                     const std::vector<VascularSectionType>& types,
+                                     const std::vector<property::Connection::Type>& connectivity) {
+    const readers::ErrorMessages err;
+    if (points.size() != diameters.size()) {
+        throw SectionBuilderError(err.ERROR_VECTOR_LENGTH_MISMATCH(
+            "points", points.size(), "diameters", diameters.size()));
+    }
+    if (pointOffsets.size() != types.size()) {
+        throw SectionBuilderError(err.ERROR_VECTOR_LENGTH_MISMATCH(
+            "point offsets", pointOffsets.size(), "section types", types.size()));
+    }
+    if (pointOffsets.empty() ? !points.empty() : pointOffsets.front() != 0) {
+        throw SectionBuilderError("The first new section must start at the first point");
+    }
+    for (size_t i = 0; i < pointOffsets.size(); ++i) {
+        const size_t end = i + 1 < pointOffsets.size() ? pointOffsets[i + 1] : points.size();
+        if (end <= pointOffsets[i]) {
+            throw SectionBuilderError("New section " + std::to_string(i) + " has no points");
+        }
+        if (types[i] > SECTION_CUSTOM || types[i] < 0) {
+            throw SectionBuilderError(err.ERROR_UNSUPPORTED_VASCULATURE_SECTION_TYPE(0, types[i]));
+        }
+    }
+    const size_t firstId = sectionCount();
+    _checkConnections(connectivity, firstId + pointOffsets.size());
+
+    auto& pointLevel = _properties._pointLevel;
+    auto& sectionLevel = _properties._sectionLevel;
+    const auto pointShift = static_cast<uint32_t>(pointLevel._points.size());
+    sectionLevel._sections.reserve(sectionLevel._sections.size() + pointOffsets.size());
+    for (const uint32_t offset : pointOffsets) {
+        sectionLevel._sections.push_back(offset + pointShift);
+    }
+    sectionLevel._sectionTypes.insert(sectionLevel._sectionTypes.end(), types.begin(), types.end());
+    pointLevel._points.insert(pointLevel._points.end(), points.begin(), points.end());
+    pointLevel._diameters.insert(pointLevel._diameters.end(), diameters.begin(), diameters.end());
+    _properties._connectivity.insert(_properties._connectivity.end(),
+                                     connectivity.begin(),
+                                     connectivity.end());
+    return static_cast<uint32_t>(firstId);
+}
+
+void Vasculature::appendConnections(const std::vector<property::Connection::Type>& connectivity) {
+    _checkConnections(connectivity, sectionCount());
+    _properties._connectivity.insert(_properties._connectivity.end(),
+                                     connectivity.begin(),
+                                     connectivity.end());
+}
+
+void Vasculature::deleteSections(const std::vector<uint32_t>& sectionIds) {
+    constexpr uint32_t deleted = std::numeric_limits<uint32_t>::max();
+    const size_t nSections = sectionCount();
+    std::vector<uint32_t> newIds(nSections, 0);
+    for (const uint32_t id : sectionIds) {
+        checkSectionId(id, nSections);
+        newIds[id] = deleted;
+    }
+
+    // Everything moves towards the front: compact in place, writing behind the reading cursor
+    auto& points = _properties._pointLevel._points;
+    auto& diameters = _properties._pointLevel._diameters;
+    auto& offsets = _properties._sectionLevel._sections;
+    auto& types = _properties._sectionLevel._sectionTypes;
+    const size_t nPoints = points.size();
+    uint32_t nKept = 0;
+    size_t pointCursor = 0;
+    for (uint32_t id = 0; id < nSections; ++id) {
+        if (newIds[id] == deleted) {
+            continue;
+        }
+        const size_t begin = offsets[id];
+        const size_t end = id + 1 < nSections ? offsets[id + 1] : nPoints;
+        newIds[id] = nKept;
+        offsets[nKept] = static_cast<uint32_t>(pointCursor);
+        types[nKept] = types[id];
+        ++nKept;
+        for (size_t point = begin; point < end; ++point, ++pointCursor) {
+            points[pointCursor] = points[point];
+            diameters[pointCursor] = diameters[point];
+        }
+    }
+    offsets.resize(nKept);
+    types.resize(nKept);
+    points.resize(pointCursor);
+    diameters.resize(pointCursor);
+
+    auto& connectivity = _properties._connectivity;
+    size_t nConnections = 0;
+    for (const auto& connection : connectivity) {
+        const uint32_t from = newIds[connection[0]];
+        const uint32_t to = newIds[connection[1]];
+        if (from != deleted && to != deleted) {
+            connectivity[nConnections++] = {from, to};
+        }
+    }
+    connectivity.resize(nConnections);
+}
+
+property::Properties Vasculature::buildReadOnly() const& {
+    return _properties;
+}
+
+property::Properties Vasculature::buildReadOnly() && {
+    return std::move(_properties);
+}
+
+void Vasculature::write(const std::string& filename) const {
+    const size_t pos = filename.find_last_of(".");
+    std::string extension;
+    if (pos != std::string::npos) {
+        for (char c : filename.substr(pos)) {
+            extension += my_tolower(c);
+        }
+    }
+    if (extension != ".h5") {
+        throw UnknownFileType(readers::ErrorMessages().ERROR_WRONG_EXTENSION(filename));
+    }
+    writer::h5(*this, filename);
+}
+
+}  // namespace mut
+}  // namespace vasculature
+}  // namespace morphio
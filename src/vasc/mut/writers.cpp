@@ -0,0 +1,97 @@
+#include <morphio/vasc/mut/writers.h>
+
+#include <algorithm>  // std::min
+#include <cstdint>    // int64_t
+#include <vector>     // std::vector
+
+#include <highfive/H5DataSet.hpp>
+#include <highfive/H5DataSpace.hpp>
+#include <highfive/H5File.hpp>
+
+namespace morphio {
+namespace vasculature {
+namespace mut {
+namespace writer {
+
+namespace {
+
+// Rows written per HDF5 call, as in the reader
+constexpr size_t kBlockRows = 1 << 18;
+
+/**
+   Create a dataset of nRows rows of `columns` T values and write it kBlockRows at a time,
+   fill(block, first, count) putting the rows [first, first + count) one after the other in
+   block
+**/
+template <typename T, typename Filler>
+void writeRows(HighFive::File& file,
+               const std::string& name,
+               size_t nRows,
+               size_t columns,
+               Filler fill) {
+    HighFive::DataSet dataset =
+        file.createDataSet<T>(name, HighFive::DataSpace(std::vector<size_t>{nRows, columns}));
+    std::vector<T> block(std::min(nRows, kBlockRows) * columns);
+    for (size_t first = 0; first < nRows; first += kBlockRows) {
+        const size_t count = std::min(kBlockRows, nRows - first);
+        fill(block, first, count);
+        dataset.select({first, 0}, {count, columns}).write_raw(block.data());
+    }
+}
+
+}  // anonymous namespace
+
+void h5(const Vasculature& vasculature, const std::string& filename) {
+    HighFive::File file(filename,
+                        HighFive::File::ReadWrite | HighFive::File::Create |
+                            HighFive::File::Truncate);
+
+    const auto& points = vasculature.points();
+    const auto& diameters = vasculature.diameters();
+    writeRows<morphio::floatType>(
+        file,
+        "/points",
+        points.size(),
+        4,
+        [&points, &diameters](std::vector<morphio::floatType>& block, size_t first, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const Point& point = points[first + i];
+                block[4 * i] = point[0];
+                block[4 * i + 1] = point[1];
+                block[4 * i + 2] = point[2];
+                block[4 * i + 3] = diameters[first + i];
+            }
+        });
+
+    // Offsets and types, as int64 like the datasets of the existing files
+    const std::vector<uint32_t> offsets = vasculature.sectionOffsets();
+    const auto& types = vasculature.sectionTypes();
+    writeRows<int64_t>(file,
+                       "/structure",
+                       types.size(),
+                       2,
+                       [&offsets, &types](std::vector<int64_t>& block, size_t first, size_t count) {
+                           for (size_t i = 0; i < count; ++i) {
+                               block[2 * i] = offsets[first + i];
+                               block[2 * i + 1] = types[first + i];
+                           }
+                       });
+
+    const auto& connectivity = vasculature.connectivity();
+    writeRows<int64_t>(
+        file,
+        "/connectivity",
+        connectivity.size(),
+        2,
+        [&connectivity](std::vector<int64_t>& block, size_t first, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                block[2 * i] = connectivity[first + i][0];
+                block[2 * i + 1] = connectivity[first + i][1];
+            }
+        });
+}
+
+}  // namespace writer
+}  // namespace mut
+}  // namespace vasculature
+}  // namespace morphio
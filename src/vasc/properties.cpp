@@ -6,6 +6,7 @@
 #include <morphio/shared_utils.tpp>
 #include <morphio/vasc/properties.h>
 
+#include "../memory.h"
 
 namespace morphio {
 namespace vasculature {
@@ -136,23 +137,6 @@ bool compare(const morphio::range<const morphio::Point>& vec1,
     return true;
 }
 
-template <typename T, typename U>
-bool compare(const std::map<T, U>& vec1,
-             const std::map<T, U>& vec2,
-             const std::string& name,
-             bool verbose_) {
-    if (vec1 == vec2)
-        return true;
-    if (verbose_) {
-        if (vec1.size() != vec2.size()) {
-            printError(Warning::UNDEFINED,
-                       "Error comparing " + name + ", size differs: " +
-                           std::to_string(vec1.size()) + " vs " + std::to_string(vec2.size()));
-        }
-    }
-    return false;
-}
-
 template <typename T>
 bool compare(const T& el1, const T& el2, const std::string& name, bool verbose_) {
     if (el1 == el2)
@@ -183,7 +167,15 @@ bool VascSectionLevel::operator==(const VascSectionLevel& other) const {
     return this == &other ||
            (compare_section_structure(this->_sections, other._sections, "_sections", verbose) &&
             compare(this->_sectionTypes, other._sectionTypes, "_sectionTypes", verbose) &&
+            compare(this->_predecessorOffsets,
+                    other._predecessorOffsets,
+                    "_predecessorOffsets",
+                    verbose) &&
             compare(this->_predecessors, other._predecessors, "_predecessors", verbose) &&
+            compare(this->_successorOffsets,
+                    other._successorOffsets,
+                    "_successorOffsets",
+                    verbose) &&
             compare(this->_successors, other._successors, "_successors", verbose));
 }
 
@@ -203,6 +195,33 @@ bool Properties::operator!=(const Properties& other) const {
     return !this->operator==(other);
 }
 
+MemoryUsage Properties::memoryUsage() const {
+    MemoryUsage usage;
+    morphio::detail::MemoryCounter counter(usage);
+    usage.points = counter.vector(_pointLevel._points) + counter.vector(_pointLevel._diameters);
+    usage.sections = counter.vector(_sectionLevel._sections) +
+                     counter.vector(_sectionLevel._sectionTypes);
+    usage.connectivity = counter.vector(_connectivity) + counter.vector(_edgeLevel.leakiness) +
+                         counter.vector(_sectionLevel._predecessorOffsets) +
+                         counter.vector(_sectionLevel._predecessors) +
+                         counter.vector(_sectionLevel._successorOffsets) +
+                         counter.vector(_sectionLevel._successors);
+    return usage;
+}
+
+void Properties::shrinkToFit() {
+    _pointLevel._points.shrink_to_fit();
+    _pointLevel._diameters.shrink_to_fit();
+    _edgeLevel.leakiness.shrink_to_fit();
+    _sectionLevel._sections.shrink_to_fit();
+    _sectionLevel._sectionTypes.shrink_to_fit();
+    _sectionLevel._predecessorOffsets.shrink_to_fit();
+    _sectionLevel._predecessors.shrink_to_fit();
+    _sectionLevel._successorOffsets.shrink_to_fit();
+    _sectionLevel._successors.shrink_to_fit();
+    _connectivity.shrink_to_fit();
+}
+
 template <>
 std::vector<VascSection::Type>& Properties::get<VascSection>() noexcept {
     return _sectionLevel._sections;
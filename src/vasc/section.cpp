@@ -1,4 +1,5 @@
 #include <morphio/vasc/section.h>
+#include <morphio/warning_sink.h>
 
 namespace morphio {
 namespace vasculature {
@@ -20,8 +21,7 @@ Section::Section(const uint32_t id_, const std::shared_ptr<property::Properties>
     _range = std::make_pair(start, end_);
 
     if (_range.second <= _range.first)
-        std::cerr << "Dereferencing broken properties section " << _id
-                  << "\nSection range: " << _range.first << " -> " << _range.second << '\n';
+        printError(BrokenSectionWarning(_id, _range));
 }
 
 Section& Section::operator=(const Section& section) {
@@ -55,36 +55,46 @@ range<const typename TProperty::Type> Section::get() const {
     return range<const typename TProperty::Type>(ptr_start, _range.second - _range.first);
 }
 
+range<const uint32_t> Section::predecessorIds() const noexcept {
+    return _properties->predecessors(_id);
+}
+
+range<const uint32_t> Section::successorIds() const noexcept {
+    return _properties->successors(_id);
+}
+
 std::vector<Section> Section::predecessors() const {
     std::vector<Section> result;
-    const auto it = _properties->predecessors().find(_id);
-    if (it != _properties->predecessors().end()) {
-        result.reserve(it->second.size());
-        for (const uint32_t id_ : it->second) {
-            result.emplace_back(id_, _properties);
-        }
+    const auto ids = predecessorIds();
+    result.reserve(ids.size());
+    for (const uint32_t id_ : ids) {
+        result.emplace_back(id_, _properties);
     }
     return result;
 }
 
 std::vector<Section> Section::successors() const {
     std::vector<Section> result;
-    const auto it = _properties->successors().find(_id);
-    if (it != _properties->successors().end()) {
-        result.reserve(it->second.size());
-        for (const uint32_t id_ : it->second) {
-            result.emplace_back(id_, _properties);
-        }
+    const auto ids = successorIds();
+    result.reserve(ids.size());
+    for (const uint32_t id_ : ids) {
+        result.emplace_back(id_, _properties);
     }
     return result;
 }
 
 std::vector<Section> Section::neighbors() const {
-    auto pre = this->predecessors();
-    const auto& suc = this->successors();
-    pre.reserve(pre.size() + suc.size());
-    std::copy(suc.begin(), suc.end(), std::back_inserter(pre));
-    return pre;
+    std::vector<Section> result;
+    const auto predecessors_ = predecessorIds();
+    const auto successors_ = successorIds();
+    result.reserve(predecessors_.size() + successors_.size());
+    for (const uint32_t id_ : predecessors_) {
+        result.emplace_back(id_, _properties);
+    }
+    for (const uint32_t id_ : successors_) {
+        result.emplace_back(id_, _properties);
+    }
+    return result;
 }
 
 VascularSectionType Section::type() const {
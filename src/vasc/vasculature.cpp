@@ -1,4 +1,6 @@
 #include <cstdint>   // uint32_t
+#include <limits>    // std::numeric_limits
+#include <numeric>   // std::partial_sum
 #if defined(WIN32) || defined(__WIN32__) || defined(_WIN32) || defined(_MSC_VER) || defined(__MINGW32__)
 #define F_OK    0
 #include <io.h>
@@ -6,18 +8,21 @@
 #include <unistd.h>  // access / F_OK
 #endif
 
+#include <morphio/vasc/mut/vasculature.h>
 #include <morphio/vasc/section.h>
 #include <morphio/vasc/vasculature.h>
 
+#include "../memory.h"
 #include "../readers/morphologySWC.h"
 #include "../readers/vasculatureHDF5.h"
 
 namespace morphio {
 namespace vasculature {
 
-void buildConnectivity(std::shared_ptr<property::Properties> properties);
+namespace {
 
-Vasculature::Vasculature(const std::string& source) {
+/** Throw unless source is an existing vasculature file **/
+void checkSource(const std::string& source) {
     const size_t pos = source.find_last_of(".");
     if (pos == std::string::npos) {
         throw UnknownFileType("File has no extension");
@@ -29,16 +34,97 @@ Vasculature::Vasculature(const std::string& source) {
 
     std::string extension = source.substr(pos);
 
-    property::Properties loader;
-    if (extension == ".h5") {
-        loader = readers::h5::VasculatureHDF5(source).load();
-    } else {
+    if (extension != ".h5") {
         throw UnknownFileType("File: " + source + " does not end with the .h5 extension");
     }
+}
+
+property::Properties load(const std::string& source) {
+    checkSource(source);
+    return readers::h5::VasculatureHDF5(source).load();
+}
+
+property::Properties load(const std::string& source, uint32_t firstSection, uint32_t lastSection) {
+    checkSource(source);
+    return readers::h5::VasculatureHDF5(source).load(firstSection, lastSection);
+}
+
+property::Properties load(const std::string& source, const BoundingBox& region) {
+    checkSource(source);
+    return readers::h5::VasculatureHDF5(source).load(region);
+}
 
-    _properties = std::make_shared<property::Properties>(loader);
+/**
+   Fill offsets and ids with the CSR adjacency grouping the connections by their `from` end:
+   a counting sort, so that the neighbors of a section keep the order of the connections
+**/
+void buildAdjacency(const std::vector<property::Connection::Type>& connectivity,
+                    size_t nSections,
+                    size_t from,
+                    std::vector<uint32_t>& offsets,
+                    std::vector<uint32_t>& ids) {
+    offsets.assign(nSections + 1, 0);
+    for (const auto& connection : connectivity) {
+        ++offsets[connection[from] + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
 
-    buildConnectivity(_properties);
+    ids.resize(connectivity.size());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& connection : connectivity) {
+        ids[cursor[connection[from]]++] = connection[1 - from];
+    }
+}
+
+void buildConnectivity(property::Properties& properties) {
+    const auto& connectivity = properties.get<property::Connection>();
+    const size_t nSections = properties.get<property::VascSection>().size();
+    if (connectivity.size() > std::numeric_limits<uint32_t>::max()) {
+        throw RawDataError("Too many connections: " + std::to_string(connectivity.size()));
+    }
+    for (const auto& connection : connectivity) {
+        if (connection[0] >= nSections || connection[1] >= nSections) {
+            throw RawDataError("Connection (" + std::to_string(connection[0]) + ", " +
+                               std::to_string(connection[1]) +
+                               ") refers to a section ID out of bounds (number of sections = " +
+                               std::to_string(nSections) + ")");
+        }
+    }
+
+    auto& sectionLevel = properties._sectionLevel;
+    buildAdjacency(connectivity,
+                   nSections,
+                   1,
+                   sectionLevel._predecessorOffsets,
+                   sectionLevel._predecessors);
+    buildAdjacency(
+        connectivity, nSections, 0, sectionLevel._successorOffsets, sectionLevel._successors);
+}
+
+}  // anonymous namespace
+
+Vasculature::Vasculature(const std::string& source)
+    : Vasculature(load(source)) {}
+
+Vasculature::Vasculature(const std::string& source, uint32_t firstSection, uint32_t lastSection)
+    : Vasculature(load(source, firstSection, lastSection)) {}
+
+Vasculature::Vasculature(const std::string& source, const BoundingBox& region)
+    : Vasculature(load(source, region)) {}
+
+Vasculature::Vasculature(property::Properties properties)
+    : _properties(std::make_shared<property::Properties>(std::move(properties))) {
+    buildConnectivity(*_properties);
+}
+
+Vasculature::Vasculature(const mut::Vasculature& vasculature)
+    : Vasculature(vasculature.buildReadOnly()) {}
+
+MemoryUsage Vasculature::memoryUsage() const {
+    MemoryUsage usage = _properties->memoryUsage();
+    morphio::detail::MemoryCounter counter(usage);
+    usage.objects += counter.block(morphio::detail::sharedObjectBytes<property::Properties>());
+    return usage;
 }
 
 Section Vasculature::section(const uint32_t& id) const {
@@ -55,27 +141,179 @@ std::vector<Section> Vasculature::sections() const {
     return sections_;
 }
 
-graph_iterator Vasculature::begin() const {
-    return graph_iterator(*this);
+std::vector<uint32_t> Vasculature::sectionOffsets() const {
+    const auto& offsets = _properties->get<property::VascSection>();
+    std::vector<uint32_t> indices(offsets.begin(), offsets.end());
+    indices.push_back(static_cast<uint32_t>(points().size()));
+    return indices;
 }
 
-graph_iterator Vasculature::end() const {
-    return graph_iterator();
+Vasculature Vasculature::subgraph(const std::vector<uint32_t>& sectionIds) const {
+    constexpr uint32_t removed = std::numeric_limits<uint32_t>::max();
+    const auto& offsets = _properties->get<property::VascSection>();
+    const auto& points = _properties->get<property::Point>();
+    const auto& diameters = _properties->get<property::Diameter>();
+    const auto& types = _properties->get<property::SectionType>();
+
+    std::vector<uint32_t> newIds(offsets.size(), removed);
+    for (uint32_t i = 0; i < sectionIds.size(); ++i) {
+        const uint32_t id = sectionIds[i];
+        if (id >= offsets.size()) {
+            throw RawDataError("Requested section ID (" + std::to_string(id) +
+                               ") is out of array bounds (array size = " +
+                               std::to_string(offsets.size()) + ")");
+        }
+        if (newIds[id] != removed) {
+            throw RawDataError("Section ID " + std::to_string(id) + " is repeated");
+        }
+        newIds[id] = i;
+    }
+
+    property::Properties properties;
+    size_t nPoints = 0;
+    for (const uint32_t id : sectionIds) {
+        const size_t end = id + 1 < offsets.size() ? offsets[id + 1] : points.size();
+        nPoints += end - offsets[id];
+    }
+    properties._pointLevel._points.reserve(nPoints);
+    properties._pointLevel._diameters.reserve(nPoints);
+    properties._sectionLevel._sections.reserve(sectionIds.size());
+    properties._sectionLevel._sectionTypes.reserve(sectionIds.size());
+    for (const uint32_t id : sectionIds) {
+        const auto begin = static_cast<std::ptrdiff_t>(offsets[id]);
+        const auto end = static_cast<std::ptrdiff_t>(
+            id + 1 < offsets.size() ? offsets[id + 1] : points.size());
+        properties._sectionLevel._sections.push_back(
+            static_cast<property::VascSection::Type>(properties._pointLevel._points.size()));
+        properties._sectionLevel._sectionTypes.push_back(types[id]);
+        properties._pointLevel._points.insert(properties._pointLevel._points.end(),
+                                              points.begin() + begin,
+                                              points.begin() + end);
+        properties._pointLevel._diameters.insert(properties._pointLevel._diameters.end(),
+                                                 diameters.begin() + begin,
+                                                 diameters.begin() + end);
+    }
+
+    for (const auto& connection : _properties->get<property::Connection>()) {
+        const uint32_t from = newIds[connection[0]];
+        const uint32_t to = newIds[connection[1]];
+        if (from != removed && to != removed) {
+            properties._connectivity.push_back({from, to});
+        }
+    }
+    return Vasculature(std::move(properties));
 }
 
-void buildConnectivity(std::shared_ptr<property::Properties> properties) {
-    const std::vector<std::array<unsigned int, 2>>& connectivity =
-        properties->get<property::Connection>();
-    auto& successors = properties->_sectionLevel._successors;
-    auto& predecessors = properties->_sectionLevel._predecessors;
+std::vector<uint32_t> Vasculature::depthFirstOrder() const {
+    std::vector<uint32_t> order;
+    order.reserve(_properties->get<property::VascSection>().size());
+    for (DepthFirstTraversal traversal(*_properties); !traversal.done(); traversal.advance()) {
+        order.push_back(traversal.current());
+    }
+    return order;
+}
 
-    for (const auto& connection : connectivity) {
-        uint32_t first = connection[0];
-        uint32_t second = connection[1];
-        successors[first].push_back(second);
-        predecessors[second].push_back(first);
+std::vector<uint32_t> Vasculature::breadthFirstOrder() const {
+    const auto nSections = static_cast<uint32_t>(_properties->get<property::VascSection>().size());
+    std::vector<bool> visited(nSections, false);
+    std::vector<uint32_t> order;
+    order.reserve(nSections);
+    auto discover = [&visited, &order](range<const uint32_t> ids) {
+        for (const uint32_t id : ids) {
+            if (!visited[id]) {
+                visited[id] = true;
+                order.push_back(id);
+            }
+        }
+    };
+
+    for (uint32_t id = 0; id < nSections; ++id) {
+        if (_properties->predecessors(id).empty()) {
+            visited[id] = true;
+            order.push_back(id);
+        }
+    }
+    // order doubles as the queue
+    for (size_t head = 0; head < order.size(); ++head) {
+        const uint32_t id = order[head];
+        discover(_properties->predecessors(id));
+        discover(_properties->successors(id));
+    }
+    return order;
+}
+
+std::vector<uint32_t> Vasculature::connectedComponents() const {
+    constexpr uint32_t unlabeled = std::numeric_limits<uint32_t>::max();
+    const auto nSections = static_cast<uint32_t>(_properties->get<property::VascSection>().size());
+    std::vector<uint32_t> labels(nSections, unlabeled);
+    std::vector<uint32_t> stack;
+    uint32_t nComponents = 0;
+    for (uint32_t start = 0; start < nSections; ++start) {
+        if (labels[start] != unlabeled) {
+            continue;
+        }
+        labels[start] = nComponents;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            const uint32_t id = stack.back();
+            stack.pop_back();
+            for (const auto& neighbors :
+                 {_properties->predecessors(id), _properties->successors(id)}) {
+                for (const uint32_t neighbor : neighbors) {
+                    if (labels[neighbor] == unlabeled) {
+                        labels[neighbor] = nComponents;
+                        stack.push_back(neighbor);
+                    }
+                }
+            }
+        }
+        ++nComponents;
+    }
+    return labels;
+}
+
+DepthFirstTraversal::DepthFirstTraversal(const property::Properties& properties)
+    : _properties(&properties)
+    , _visited(properties.get<property::VascSection>().size(), false) {
+    for (uint32_t id = 0; id < _visited.size(); ++id) {
+        if (properties.predecessors(id).empty()) {
+            _visited[id] = true;
+            _stack.push_back(id);
+        }
     }
 }
 
+DepthFirstTraversal::DepthFirstTraversal(const property::Properties& properties, uint32_t start)
+    : _properties(&properties)
+    , _visited(properties.get<property::VascSection>().size(), false) {
+    _visited.at(start) = true;
+    _stack.push_back(start);
+}
+
+void DepthFirstTraversal::advance() {
+    const uint32_t id = _stack.back();
+    _stack.pop_back();
+
+    // Pushed in reverse so that the first neighbor is on top
+    auto discover = [this](range<const uint32_t> ids) {
+        for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+            if (!_visited[*it]) {
+                _visited[*it] = true;
+                _stack.push_back(*it);
+            }
+        }
+    };
+    discover(_properties->successors(id));
+    discover(_properties->predecessors(id));
+}
+
+graph_iterator Vasculature::begin() const {
+    return graph_iterator(*this);
+}
+
+graph_iterator Vasculature::end() const {
+    return graph_iterator();
+}
+
 }  // namespace vasculature
 }  // namespace morphio
@@ -68,11 +68,46 @@ Points operator-=(Points& points, const Point& right) {
 /**
    Euclidian distance between two points
 **/
-floatType distance(const Point& left, const Point& right) {
+template <typename T>
+T distance(const PointT<T>& left, const PointT<T>& right) {
     return std::sqrt((left[0] - right[0]) * (left[0] - right[0]) +
                      (left[1] - right[1]) * (left[1] - right[1]) +
                      (left[2] - right[2]) * (left[2] - right[2]));
 }
+template float distance(const PointT<float>& left, const PointT<float>& right);
+template double distance(const PointT<double>& left, const PointT<double>& right);
+
+bool BoundingBox::contains(const Point& point) const noexcept {
+    for (size_t i = 0; i < 3; ++i) {
+        if (point[i] < min[i] || point[i] > max[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BoundingBox::intersects(const BoundingBox& other) const noexcept {
+    for (size_t i = 0; i < 3; ++i) {
+        if (other.max[i] < min[i] || other.min[i] > max[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BoundingBox::expand(const Point& point) noexcept {
+    for (size_t i = 0; i < 3; ++i) {
+        min[i] = std::min(min[i], point[i]);
+        max[i] = std::max(max[i], point[i]);
+    }
+}
+
+void BoundingBox::expand(const BoundingBox& other) noexcept {
+    for (size_t i = 0; i < 3; ++i) {
+        min[i] = std::min(min[i], other.min[i]);
+        max[i] = std::max(max[i], other.max[i]);
+    }
+}
 
 std::string dumpPoint(const Point& point) {
     std::ostringstream oss;
@@ -89,30 +124,35 @@ std::string dumpPoints(const Points& points) {
 }
 
 template <typename T>
-Point centerOfGravity(const T& points) {
-    Point::value_type x = 0, y = 0, z = 0;
-    const auto size = static_cast<Point::value_type>(points.size());
+typename T::value_type centerOfGravity(const T& points) {
+    using Scalar = typename T::value_type::value_type;
+    Scalar x = 0, y = 0, z = 0;
+    const auto size = static_cast<Scalar>(points.size());
     for (const auto& point : points) {
         x += point[0];
         y += point[1];
         z += point[2];
     }
-    return Point({x / size, y / size, z / size});
+    return typename T::value_type{{x / size, y / size, z / size}};
 }
-template Point centerOfGravity(const range<const Point>& points);
-template Point centerOfGravity(const Points& points);
+template PointT<float> centerOfGravity(const range<const PointT<float>>& points);
+template PointT<double> centerOfGravity(const range<const PointT<double>>& points);
+template PointT<float> centerOfGravity(const PointsT<float>& points);
+template PointT<double> centerOfGravity(const PointsT<double>& points);
 
 template <typename T>
-floatType maxDistanceToCenterOfGravity(const T& points) {
+typename T::value_type::value_type maxDistanceToCenterOfGravity(const T& points) {
+    using Scalar = typename T::value_type::value_type;
     const auto c = centerOfGravity(points);
     return std::accumulate(std::begin(points),
                            std::end(points),
-                           floatType{0},
-                           [&](morphio::floatType a, const Point& b) {
+                           Scalar{0},
+                           [&](Scalar a, const PointT<Scalar>& b) {
                                return std::max(a, distance(c, b));
                            });
 }
-template floatType maxDistanceToCenterOfGravity(const Points& points);
+template float maxDistanceToCenterOfGravity(const PointsT<float>& points);
+template double maxDistanceToCenterOfGravity(const PointsT<double>& points);
 
 template <typename T>
 Point operator*(const Point& from, T factor) {
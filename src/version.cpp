@@ -0,0 +1,25 @@
+#include <morphio/version.h>
+
+#include <string>
+namespace morphio
+{
+    std::string getVersionString() {
+        static const std::string version("");
+        return version;
+    }
+
+    int getMajor()
+    {
+        return 2;
+    }
+
+    int getMinor()
+    {
+        return 0;
+    }
+
+    int getPatch()
+    {
+        return 0;
+    }
+} // namespace morphio
@@ -0,0 +1,157 @@
+#include <iostream>  // std::cerr
+
+#include <morphio/errorMessages.h>
+#include <morphio/warning_sink.h>
+
+#include "stats.h"
+
+namespace morphio {
+namespace {
+std::atomic<int> MORPHIO_MAX_N_WARNINGS{100};
+
+/** A message formatted by the caller **/
+struct FormattedWarning: public WarningMessage {
+    FormattedWarning(Warning warning_, const std::string& text_) noexcept
+        : WarningMessage(warning_)
+        , text(text_) {}
+    std::string msg() const override {
+        return text;
+    }
+
+    const std::string& text;
+};
+
+const std::shared_ptr<WarningSink>& stderrSink() {
+    static const std::shared_ptr<WarningSink> sink = std::make_shared<StderrWarningSink>();
+    return sink;
+}
+
+/**
+   The sink of the threads without a ScopedWarningSink, only accessed with std::atomic_load and
+   std::atomic_store
+**/
+std::shared_ptr<WarningSink>& globalSink() {
+    static std::shared_ptr<WarningSink> sink = stderrSink();
+    return sink;
+}
+
+WarningSink*& scopedSink() noexcept {
+    static thread_local WarningSink* sink = nullptr;
+    return sink;
+}
+}  // namespace
+
+/**
+   Controls the maximum number of warning to be printed on screen
+   0 will print no warning
+   -1 will print them all
+**/
+void set_maximum_warnings(int n_warnings) {
+    MORPHIO_MAX_N_WARNINGS = n_warnings;
+}
+
+void printError(Warning warning, const std::string& msg) {
+    printError(FormattedWarning(warning, msg));
+}
+
+void printError(const WarningMessage& message) {
+    WarningSink* sink = scopedSink();
+    // Keeps the global sink alive while emitting, even if set_warning_sink replaces it meanwhile
+    std::shared_ptr<WarningSink> global;
+    if (sink == nullptr) {
+        global = std::atomic_load(&globalSink());
+        sink = global.get();
+    }
+    if (sink->discards() && !detail::collectingStats()) {
+        return;
+    }
+
+    if (readers::ErrorMessages::isIgnored(message.warning))
+        return;
+    detail::countWarning();
+    sink->emit(message);
+}
+
+std::string BrokenSectionWarning::msg() const {
+    return "Dereferencing broken properties section " + std::to_string(sectionId) +
+           "\nSection range: " + std::to_string(range.first) + " -> " +
+           std::to_string(range.second);
+}
+
+WarningSink::~WarningSink() = default;
+
+void StderrWarningSink::emit(const WarningMessage& message) {
+    const int maxWarnings = MORPHIO_MAX_N_WARNINGS;
+    if (maxWarnings == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (maxWarnings < 0 || _printed <= maxWarnings) {
+        std::cerr << message.msg() << '\n';
+        if (_printed == maxWarnings) {
+            std::cerr << "Maximum number of warning reached. Next warnings "
+                         "won't be displayed.\n"
+                         "You can change this number by calling:\n"
+                         "\t- C++: set_maximum_warnings(int)\n"
+                         "\t- Python: morphio.set_maximum_warnings(int)\n"
+                         "0 will print no warning. -1 will print them all\n";
+        }
+        ++_printed;
+    }
+}
+
+void CountingWarningSink::emit(const WarningMessage& message) {
+    _counts.at(static_cast<size_t>(message.warning)).fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t CountingWarningSink::count(Warning warning) const noexcept {
+    return _counts[static_cast<size_t>(warning)].load(std::memory_order_relaxed);
+}
+
+uint64_t CountingWarningSink::total() const noexcept {
+    uint64_t total_ = 0;
+    for (const auto& count_ : _counts) {
+        total_ += count_.load(std::memory_order_relaxed);
+    }
+    return total_;
+}
+
+void CountingWarningSink::clear() noexcept {
+    for (auto& count_ : _counts) {
+        count_.store(0, std::memory_order_relaxed);
+    }
+}
+
+void CollectingWarningSink::emit(const WarningMessage& message) {
+    Record record{message.warning, message.msg()};
+    std::lock_guard<std::mutex> lock(_mutex);
+    _records.push_back(std::move(record));
+}
+
+std::vector<CollectingWarningSink::Record> CollectingWarningSink::records() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _records;
+}
+
+void CollectingWarningSink::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _records.clear();
+}
+
+void set_warning_sink(std::shared_ptr<WarningSink> sink) {
+    if (!sink) {
+        sink = stderrSink();
+    }
+    std::atomic_store(&globalSink(), std::move(sink));
+}
+
+ScopedWarningSink::ScopedWarningSink(WarningSink& sink) noexcept
+    : _previous(scopedSink()) {
+    scopedSink() = &sink;
+}
+
+ScopedWarningSink::~ScopedWarningSink() {
+    scopedSink() = _previous;
+}
+
+}  // namespace morphio
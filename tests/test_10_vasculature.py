@@ -6,7 +6,10 @@ from numpy.testing import assert_array_almost_equal, assert_array_equal
 from pathlib2 import Path
 
 import morphio.vasculature as vasculature
-from morphio import RawDataError, VasculatureSectionType
+from morphio import RawDataError, SectionBuilderError, VasculatureSectionType
+from morphio.vasculature.mut import Vasculature as MutableVasculature
+
+from utils import setup_tempdir
 
 _path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
 
@@ -47,6 +50,8 @@ def test_components_vasculature():
 
     assert_equal(morphology.section(0).successors[0].id, 1)
     assert_equal(morphology.section(0).successors[1].id, 2)
+    assert_array_equal(morphology.section(0).successor_ids, [1, 2])
+    assert_array_equal(morphology.section(0).predecessor_ids, [])
 
 
 def test_section_types():
@@ -69,8 +74,101 @@ def test_iterators_vasculature():
     for sec in morphology.iter():
         all_sections.remove(sec.id)
     assert_equal(len(all_sections), 0)
+    assert_array_equal(morphology.depth_first_order(), [sec.id for sec in morphology.iter()])
+    assert_equal(sorted(morphology.breadth_first_order()), list(range(3080)))
+    assert_equal(len(morphology.connected_components()), 3080)
+
+
+def test_section_range():
+    path = os.path.join(_path, "h5/vasculature1.h5")
+    full = vasculature.Vasculature(path)
+    part = vasculature.Vasculature(path, 100, 500)
+    assert_equal(len(part.section_types), 400)
+    assert_array_equal(part.section_types, full.section_types[100:500])
+    for section_id in range(400):
+        assert_array_equal(part.section(section_id).points, full.section(section_id + 100).points)
+        expected = [i - 100 for i in full.section(section_id + 100).successor_ids if 100 <= i < 500]
+        assert_array_equal(part.section(section_id).successor_ids, expected)
+
+    assert_raises(RawDataError, vasculature.Vasculature, path, 10, 5)
+    assert_raises(RawDataError, vasculature.Vasculature, path, 0, 3081)
+
+
+def test_region():
+    path = os.path.join(_path, "h5/vasculature1.h5")
+    full = vasculature.Vasculature(path)
+    low, high = full.points.min(axis=0), full.points.max(axis=0)
+    quarter = (high - low) / 4
+    part = vasculature.Vasculature(path, low + quarter, high - quarter)
+    assert 0 < len(part.section_types) < 3080
+
+    section_ids = [section.id for section in full.sections
+                   if any(np.all(low + quarter <= point) and np.all(point <= high - quarter)
+                          for point in section.points)]
+    assert_equal(len(set(section_ids) - set(range(3080))), 0)
+    assert len(section_ids) <= len(part.section_types)
+
+
+def test_subgraph():
+    full = vasculature.Vasculature(os.path.join(_path, "h5/vasculature1.h5"))
+    sub = full.subgraph([5, 3, 10])
+    assert_array_equal(sub.section_types, full.section_types[[5, 3, 10]])
+    assert_array_equal(sub.section(1).points, full.section(3).points)
+    assert_raises(RawDataError, full.subgraph, [5, 5])
+    assert_raises(RawDataError, full.subgraph, [3080])
 
 
 def test_from_pathlib():
     vasc = vasculature.Vasculature(Path(_path, "h5/vasculature1.h5"))
     assert_equal(len(vasc.sections), 3080)
+
+
+def test_mut_bulk_edits():
+    vasc = MutableVasculature()
+    points = [[0, 0, 0], [1, 0, 0], [1, 0, 0], [2, 0, 0], [2, 1, 0]]
+    assert_equal(vasc.append_sections(points, [1, 1, 1, 1, 1], [0, 2],
+                                      [VasculatureSectionType.vein] * 2, [[0, 1]]), 0)
+    assert_equal(vasc.append_sections([[2, 0, 0], [3, 0, 0]], [1, 1], [0],
+                                      [VasculatureSectionType.artery], [[1, 2]]), 2)
+    assert_array_equal(vasc.section_offsets, [0, 2, 5, 7])
+    assert_raises(SectionBuilderError, vasc.append_connections, [[0, 3]])
+
+    vasc.delete_sections([1])
+    assert_equal(vasc.section_count, 2)
+    assert_array_equal(vasc.points, [[0, 0, 0], [1, 0, 0], [2, 0, 0], [3, 0, 0]])
+    assert_equal(vasc.connectivity, [])
+    assert_equal(len(vasc.as_immutable().sections), 2)
+
+
+def test_mut_write():
+    path = os.path.join(_path, "h5/vasculature1.h5")
+    expected = vasculature.Vasculature(path)
+    with setup_tempdir('test_vasculature_write') as tmp_folder:
+        filename = os.path.join(tmp_folder, 'vasculature.h5')
+        MutableVasculature(path).write(filename)
+        written = vasculature.Vasculature(filename)
+        assert_array_equal(written.points, expected.points)
+        assert_array_equal(written.diameters, expected.diameters)
+        assert_array_equal(written.section_types, expected.section_types)
+        assert_array_equal(written.section(10).successor_ids, expected.section(10).successor_ids)
+
+
+def test_metrics():
+    vasc = vasculature.Vasculature(os.path.join(_path, "h5/vasculature1.h5"))
+    lengths = vasc.section_lengths()
+    assert_equal(len(lengths), 3080)
+    offsets = vasc.segment_offsets
+    segments = vasc.segment_lengths(threads=2)
+    for section in (0, 10, 3079):
+        points = vasc.section(section).points
+        expected = np.linalg.norm(np.diff(points, axis=0), axis=1)
+        assert_array_almost_equal(segments[offsets[section]:offsets[section + 1]], expected, 3)
+        assert_array_almost_equal(lengths[section], expected.sum(), 3)
+    assert_equal(vasc.section_volumes().shape, (3080,))
+    assert_equal(vasc.segment_lateral_areas().shape, segments.shape)
+    assert_equal(vasc.degrees[10], len(vasc.section(10).neighbors))
+
+    node_count, sources, targets, edge_lengths, diameters = vasc.vessel_graph()
+    assert_array_almost_equal(edge_lengths, lengths)
+    assert_array_equal(diameters, vasc.section_mean_diameters())
+    assert max(sources.max(), targets.max()) < node_count
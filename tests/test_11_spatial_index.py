@@ -0,0 +1,55 @@
+import os
+
+import numpy as np
+from nose.tools import assert_almost_equal, assert_equal
+from numpy.testing import assert_array_equal
+
+from morphio import Morphology, SpatialIndex
+from morphio.vasculature import Vasculature
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+
+
+def test_spatial_index_morphology():
+    index = SpatialIndex(Morphology(os.path.join(_path, "simple.swc")))
+    assert_equal(len(index), 6)
+
+    low, high = index.bounds
+    assert_array_equal(low, [-7, -6, -2])
+    assert_array_equal(high, [8, 6.5, 2])
+
+    assert_array_equal(index.intersects_box([5.5, 4.5, -0.5], [6.5, 5.5, 0.5]), [[2, 0]])
+    assert_array_equal(index.intersects_sphere([0, 2.5, 0], 0.1), [[0, 0]])
+    assert_equal(index.intersects_sphere([0, 20, 0], 1).shape, (0, 2))
+
+    section, segment, distance = index.nearest([10, 5, 0])
+    assert_equal((section, segment), (2, 0))
+    assert_almost_equal(distance, 2.5)
+
+
+def test_spatial_index_batch():
+    index = SpatialIndex(Morphology(os.path.join(_path, "simple.swc")))
+    points = np.array([[10, 5, 0], [0, 2.5, 0], [-10, -4, 0]], dtype=np.float32)
+
+    ids, distances = index.nearest_batch(points, n_threads=2)
+    assert_array_equal(ids, [[2, 0], [0, 0], [5, 0]])
+    assert_array_equal(distances, [2.5, 0, 3])
+
+    spheres = index.intersects_sphere_batch(points, [0.1, 0.1, 0.1], n_threads=2)
+    assert_array_equal([len(ids) for ids in spheres], [0, 1, 0])
+
+    boxes = index.intersects_box_batch(points - 0.5, points + 0.5)
+    assert_array_equal(boxes[1], [[0, 0]])
+
+
+def test_spatial_index_vasculature():
+    vasc = Vasculature(os.path.join(_path, "h5/vasculature1.h5"))
+    index = SpatialIndex(vasc)
+    n_segments = sum(len(section.points) - 1 for section in vasc.sections)
+    assert_equal(len(index), n_segments)
+
+    section, segment, distance = index.nearest(vasc.section(0).points[3])
+    assert_equal(distance, 0)
+    hits = index.intersects_sphere(vasc.section(0).points[3], 0).tolist()
+    assert [0, 2] in hits
+    assert [0, 3] in hits
@@ -0,0 +1,62 @@
+import os
+from threading import Thread
+
+from nose.tools import assert_equal, assert_raises
+from numpy.testing import assert_array_almost_equal, assert_array_equal
+
+from morphio import MorphologyCache, Option, RawDataError
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+SIMPLE = os.path.join(_path, "simple.swc")
+
+
+def test_cache_hits_and_misses():
+    cache = MorphologyCache(1 << 20)
+    first = cache.get(SIMPLE)
+    second = cache.get(SIMPLE)
+    assert_array_equal(first.points, second.points)
+    cache.get(SIMPLE, Option.two_points_sections)
+
+    stats = cache.stats
+    assert_equal(stats['hits'], 1)
+    assert_equal(stats['misses'], 2)
+    assert_equal(stats['evictions'], 0)
+    assert_equal(stats['entries'], 2)
+
+    assert_raises(RawDataError, cache.get, os.path.join(_path, "missing.swc"))
+
+    cache.clear()
+    assert_equal(cache.stats['entries'], 0)
+
+
+def test_cache_eviction():
+    probe = MorphologyCache(1 << 20)
+    probe.get(SIMPLE)
+
+    cache = MorphologyCache(probe.stats['bytes'])
+    first = cache.get(SIMPLE)
+    cache.get(SIMPLE, Option.soma_sphere)
+    assert_equal(cache.stats['evictions'], 1)
+    assert_equal(cache.stats['entries'], 1)
+    assert_equal(len(first.points), 12)
+
+
+def test_cache_threads():
+    cache = MorphologyCache(1 << 20)
+    threads = [Thread(target=cache.get, args=(SIMPLE,)) for _ in range(8)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert_equal(cache.stats['misses'], 1)
+    assert_equal(cache.stats['hits'], 7)
+
+
+def test_cache_quantize_points():
+    exact = MorphologyCache(1 << 20)
+    exact.get(SIMPLE)
+    cache = MorphologyCache(1 << 20, quantize_points=True)
+    assert cache.quantize_points
+    morphology = cache.get(SIMPLE)
+    assert cache.stats['bytes'] < exact.stats['bytes']
+    assert_array_almost_equal(morphology.points, exact.get(SIMPLE).points, decimal=3)
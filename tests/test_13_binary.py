@@ -0,0 +1,42 @@
+import os
+
+from nose.tools import assert_equal, assert_raises
+from numpy.testing import assert_array_equal
+
+from morphio import Morphology, MorphologyVersion, Option, RawDataError
+from morphio.mut import Morphology as MutableMorphology
+
+from utils import setup_tempdir
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+
+
+def test_binary_round_trip():
+    with setup_tempdir('test_binary_round_trip') as tmp_folder:
+        filename = os.path.join(tmp_folder, 'nrn_ordering.mbin')
+        MutableMorphology(os.path.join(_path, 'nrn_ordering.swc')).write(filename)
+
+        expected = Morphology(os.path.join(_path, 'nrn_ordering.swc'))
+        loaded = Morphology(filename)
+        assert_equal(loaded.version, MorphologyVersion.MORPHOLOGY_VERSION_BINARY_1)
+        assert_array_equal(loaded.points, expected.points)
+        assert_array_equal(loaded.diameters, expected.diameters)
+        assert_array_equal(loaded.section_types, expected.section_types)
+        assert_array_equal(loaded.section_offsets, expected.section_offsets)
+        assert_array_equal(loaded.soma.points, expected.soma.points)
+        assert_equal(loaded.soma_type, expected.soma_type)
+
+        assert_array_equal(Morphology(filename, Option.nrn_order).points,
+                           Morphology(os.path.join(_path, 'nrn_ordering.swc'),
+                                      Option.nrn_order).points)
+
+
+def test_binary_truncated():
+    with setup_tempdir('test_binary_truncated') as tmp_folder:
+        filename = os.path.join(tmp_folder, 'simple.mbin')
+        MutableMorphology(os.path.join(_path, 'simple.swc')).write(filename)
+        with open(filename, 'rb') as f:
+            data = f.read()
+        with open(filename, 'wb') as f:
+            f.write(data[:100])
+        assert_raises(RawDataError, Morphology, filename)
@@ -0,0 +1,57 @@
+import os
+from threading import Thread
+
+from nose.tools import assert_equal, assert_raises, ok_
+
+import morphio
+from morphio import Morphology, Stats, stats_enabled
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+SIMPLE = os.path.join(_path, "simple.swc")
+
+
+def test_stats_collect_loads():
+    with Stats() as stats:
+        Morphology(SIMPLE)
+        Morphology(SIMPLE, morphio.Option.nrn_order)
+    Morphology(SIMPLE)
+
+    result = stats.as_dict()
+    if not stats_enabled():
+        assert_equal(result['loads'], 0)
+        return
+
+    assert_equal(result['loads'], 2)
+    assert_equal(result['bytes_read'], 2 * os.path.getsize(SIMPLE))
+    ok_(result['allocated_bytes'] > 0)
+    assert_equal(result['calls']['load'], 2)
+    assert_equal(result['calls']['modifiers'], 1)
+    assert_equal(result['calls']['probe'], 0)
+    ok_(result['seconds']['load'] > 0)
+    ok_(result['seconds']['load'] >= sum(seconds for phase, seconds in result['seconds'].items()
+                                         if phase != 'load'))
+
+
+def test_stats_nested():
+    stats = Stats()
+    with stats:
+        assert_raises(RuntimeError, stats.__enter__)
+
+
+def test_stats_per_thread():
+    all_stats = [Stats() for _ in range(4)]
+
+    def load(stats):
+        with stats:
+            Morphology(SIMPLE)
+
+    threads = [Thread(target=load, args=(stats,)) for stats in all_stats]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    total = Stats()
+    for stats in all_stats:
+        total += stats
+    assert_equal(total.as_dict()['loads'], 4 if stats_enabled() else 0)
@@ -0,0 +1,35 @@
+import os
+
+from nose.tools import assert_equal, ok_
+
+import morphio.vasculature as vasculature
+from morphio import Morphology, Option, PointLevel, SectionType
+from morphio.mut import Morphology as MutableMorphology
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+SIMPLE = os.path.join(_path, "simple.swc")
+
+COMPONENTS = ('points', 'soma', 'sections', 'children', 'annotations', 'mitochondria',
+              'endoplasmic_reticulum', 'connectivity', 'objects')
+
+
+def test_memory_usage():
+    usage = Morphology(SIMPLE).memory_usage()
+    ok_(usage['points'] > 0)
+    assert_equal(Morphology(SIMPLE, Option.shrink_to_fit).memory_usage()['unused'], 0)
+    assert_equal(usage['total'],
+                 sum(usage[component] for component in COMPONENTS) + usage['allocator_overhead'])
+
+
+def test_mut_shrink_to_fit():
+    morphology = MutableMorphology(SIMPLE)
+    morphology.append_root_section(PointLevel([[0, 0, 0], [0, 1, 0]], [1, 1]), SectionType.axon)
+    morphology.shrink_to_fit()
+    assert_equal(morphology.memory_usage()['unused'], 0)
+
+
+def test_vasculature_memory_usage():
+    usage = vasculature.Vasculature(os.path.join(_path, "h5", "vasculature1.h5")).memory_usage()
+    ok_(usage['connectivity'] > 0)
+    assert_equal(usage['total'],
+                 sum(usage[component] for component in COMPONENTS) + usage['allocator_overhead'])
@@ -0,0 +1,28 @@
+import os
+
+from nose.tools import assert_equal, assert_raises, ok_
+
+from morphio import Morphology, Warning, WarningCollector
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+
+
+def test_warnings_collected():
+    with WarningCollector() as warnings:
+        Morphology(os.path.join(_path, 'neurite_wrong_root_point.swc'))
+    Morphology(os.path.join(_path, 'neurite_wrong_root_point.swc'))
+
+    records = warnings.records()
+    ok_(len(records) > 0)
+    for warning, message in records:
+        assert_equal(warning, Warning.wrong_root_point)
+        ok_('neurite_wrong_root_point.swc' in message)
+
+    warnings.clear()
+    assert_equal(warnings.records(), [])
+
+
+def test_warnings_nested():
+    warnings = WarningCollector()
+    with warnings:
+        assert_raises(RuntimeError, warnings.__enter__)
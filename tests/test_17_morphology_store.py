@@ -0,0 +1,48 @@
+import os
+from tempfile import TemporaryDirectory
+
+from nose.tools import assert_equal, assert_raises
+from numpy.testing import assert_array_equal
+
+from morphio import Morphology, MorphioError, MorphologyStore, RawDataError
+
+_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+SIMPLE = os.path.join(_path, "simple.swc")
+
+
+def test_store_deduplicates():
+    store = MorphologyStore()
+    store.add("first", Morphology(SIMPLE))
+    store.add("second", Morphology(SIMPLE))
+
+    moved = Morphology(SIMPLE).as_mutable()
+    points = moved.section(1).points
+    points[1, 0] += 1
+    moved.section(1).points = points
+    store.add("third", moved)
+
+    assert_equal(len(store), 3)
+    assert_equal(store.names, ["first", "second", "third"])
+    assert_equal(store.stats["unique"], 2)
+    assert_equal(store.stats["saved_bytes"], Morphology(SIMPLE).memory_usage()["total"])
+    assert "second" in store
+    assert "fourth" not in store
+    assert_raises(MorphioError, store.get, "fourth")
+
+
+def test_store_archive():
+    store = MorphologyStore()
+    store.add("first", Morphology(SIMPLE))
+    store.add("second", Morphology(SIMPLE))
+
+    with TemporaryDirectory() as folder:
+        path = os.path.join(folder, "store.mstore")
+        store.write(path)
+        loaded = MorphologyStore(path)
+
+    assert_equal(loaded.names, store.names)
+    assert_equal(loaded.stats["unique"], 1)
+    assert_array_equal(loaded["first"].points, store["first"].points)
+    assert_equal(loaded["second"], store["second"])
+
+    assert_raises(RawDataError, MorphologyStore, os.path.join(_path, "missing.mstore"))
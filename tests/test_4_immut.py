@@ -6,7 +6,7 @@ from nose.tools import assert_dict_equal, assert_equal, ok_, assert_raises
 from numpy.testing import assert_array_almost_equal, assert_array_equal
 from pathlib2 import Path
 
-from morphio import IterType, Morphology, GlialCell, CellFamily, RawDataError
+from morphio import IterType, Morphology, GlialCell, CellFamily, RawDataError, load_as
 
 _path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
 
@@ -147,3 +147,35 @@ def test_glia():
 
     assert_raises(RawDataError, GlialCell, Path(_path, 'simple.swc'))
     assert_raises(RawDataError, GlialCell, Path(_path, 'h5/v1/simple.h5'))
+
+
+def test_load_as():
+    cell = CELLS['swc']
+    for dtype in (np.float32, np.float64):
+        geometry = load_as(os.path.join(_path, "simple.swc"), dtype)
+        assert_equal(geometry['points'].dtype, dtype)
+        assert_equal(geometry['points'].shape, cell.points.shape)
+        assert_equal(geometry['diameters'].dtype, dtype)
+        assert_array_almost_equal(geometry['points'], cell.points)
+        assert_array_almost_equal(geometry['diameters'], cell.diameters)
+        assert_array_equal(geometry['section_offsets'], cell.section_offsets[:-1])
+        assert_equal(geometry['soma_type'], cell.soma_type)
+
+    assert_raises(ValueError, load_as, os.path.join(_path, "simple.swc"), np.int32)
+
+
+def test_content_hash():
+    cell = Morphology(os.path.join(_path, "simple.swc"))
+    same = Morphology(os.path.join(_path, "simple.swc"))
+    assert_equal(hash(cell), hash(same))
+    assert_equal(cell.content_hash(), same.content_hash())
+    ok_(cell == same)
+    assert_equal(len({cell, same}), 1)
+
+    moved = cell.as_mutable()
+    moved.section(1).points = moved.section(1).points + 1
+    moved = moved.as_immutable()
+    ok_(cell != moved)
+    ok_(cell.content_hash() != moved.content_hash())
+    assert_equal(cell.content_hash(points=False), moved.content_hash(points=False))
+    ok_(cell.content_hash(tolerance=0.01) != moved.content_hash(tolerance=0.01))
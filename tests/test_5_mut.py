@@ -392,6 +392,25 @@ def test_annotation():
     annotation = n.annotations[0]
     assert_equal(annotation.type, morphio.AnnotationType.single_child)
 
+
+def test_annotation_point_range():
+    morpho = Morphology()
+    root = morpho.append_root_section(PointLevel([[0, 0, 0], [0, 1, 0]], [1, 1]),
+                                      SectionType.axon)
+    child = root.append_section(PointLevel([[0, 1, 0], [0, 2, 0], [0, 3, 0]], [1, 1, 1]))
+    child.append_section(PointLevel([[0, 3, 0], [1, 4, 0]], [1, 1]))
+    child.append_section(PointLevel([[0, 3, 0], [-1, 4, 0]], [1, 1]))
+
+    with captured_output():
+        with ostream_redirect(stdout=True, stderr=True):
+            morpho.sanitize(copy_annotation_points=False)
+    assert_equal(len(morpho.annotations), 1)
+    annotation = morpho.annotations[0]
+    assert_equal(annotation.section_id, root.id)
+    assert_equal(annotation.point_range, (2, 4))
+    assert_equal(len(annotation.points), 0)
+    assert_equal(len(root.points), 4)
+
 def test_section___str__():
     assert_equal(str(SIMPLE.root_sections[0]),
                  'Section(id=0, points=[(0 0 0),..., (0 5 0)])')
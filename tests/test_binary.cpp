@@ -0,0 +1,238 @@
+#include "contrib/catch.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <morphio/endoplasmic_reticulum.h>
+#include <morphio/mitochondria.h>
+#include <morphio/morphology.h>
+#include <morphio/mut/endoplasmic_reticulum.h>
+#include <morphio/mut/mitochondria.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/soma.h>
+#include <morphio/warning_sink.h>
+
+namespace {
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<char>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+// Return the position of the entry of a block, found by id in the block table after the header
+size_t findBlock(const std::vector<char>& data, uint32_t id) {
+    const size_t headerSize = 64;
+    const size_t entrySize = 24;
+    for (size_t entry = headerSize; entry + entrySize <= data.size(); entry += entrySize) {
+        uint32_t entryId;
+        std::memcpy(&entryId, data.data() + entry, sizeof(entryId));
+        if (entryId == id) {
+            return entry;
+        }
+    }
+    FAIL("No block " << id);
+    return 0;
+}
+
+// Decrement the element count of a block
+std::vector<char> shortenBlock(std::vector<char> data, uint32_t id) {
+    const size_t entry = findBlock(data, id);
+    uint64_t count;
+    std::memcpy(&count, data.data() + entry + 16, sizeof(count));
+    --count;
+    std::memcpy(data.data() + entry + 16, &count, sizeof(count));
+    return data;
+}
+
+// Set the parent of a section, in block 4: SECTIONS of (offset, parent) pairs
+std::vector<char> setParent(std::vector<char> data, size_t section, int32_t parent) {
+    uint64_t offset;
+    std::memcpy(&offset, data.data() + findBlock(data, 4) + 8, sizeof(offset));
+    std::memcpy(data.data() + offset + section * 8 + 4, &parent, sizeof(parent));
+    return data;
+}
+
+}  // anonymous namespace
+
+
+TEST_CASE("BinaryRoundTrip", "[binary]") {
+    const std::string path = "binary_round_trip.mbin";
+
+    morphio::mut::Morphology mutable_morph("data/nrn_ordering.swc");
+    mutable_morph.mitochondria().appendRootSection(
+        morphio::Property::MitochondriaPointLevel({0, 0, 1},
+                                                  {0.5f, 0.75f, 0.25f},
+                                                  {1.f, 2.f, 3.f}));
+    mutable_morph.endoplasmicReticulum().sectionIndices() = {1, 2};
+    mutable_morph.endoplasmicReticulum().volumes() = {10.f, 20.f};
+    mutable_morph.endoplasmicReticulum().surfaceAreas() = {1.f, 2.f};
+    mutable_morph.endoplasmicReticulum().filamentCounts() = {3, 4};
+    mutable_morph.write(path);
+
+    const morphio::Morphology expected("data/nrn_ordering.swc");
+    const morphio::Morphology loaded(path);
+
+    REQUIRE(loaded.version() == morphio::MORPHOLOGY_VERSION_BINARY_1);
+    REQUIRE(loaded.cellFamily() == expected.cellFamily());
+    REQUIRE(loaded.soma().type() == expected.soma().type());
+    REQUIRE(loaded.soma().points() == expected.soma().points());
+    REQUIRE(loaded.soma().diameters() == expected.soma().diameters());
+    REQUIRE(loaded.points() == expected.points());
+    REQUIRE(loaded.diameters() == expected.diameters());
+    REQUIRE(loaded.sectionTypes() == expected.sectionTypes());
+    REQUIRE(loaded.sectionOffsets() == expected.sectionOffsets());
+    REQUIRE(loaded.rootSections().size() == expected.rootSections().size());
+    for (size_t i = 0; i < expected.sections().size(); ++i) {
+        const auto section = expected.section(static_cast<uint32_t>(i));
+        const auto loadedSection = loaded.section(static_cast<uint32_t>(i));
+        REQUIRE(loadedSection.isRoot() == section.isRoot());
+        if (!section.isRoot()) {
+            REQUIRE(loadedSection.parent().id() == section.parent().id());
+        }
+        REQUIRE(loadedSection.children().size() == section.children().size());
+    }
+
+    const auto mitochondria = loaded.mitochondria().rootSections();
+    REQUIRE(mitochondria.size() == 1);
+    REQUIRE(mitochondria[0].diameters() == morphio::range<const morphio::floatType>{
+                                               std::vector<morphio::floatType>{1.f, 2.f, 3.f}});
+    REQUIRE(loaded.endoplasmicReticulum().volumes() ==
+            std::vector<morphio::floatType>{10.f, 20.f});
+    REQUIRE(loaded.endoplasmicReticulum().filamentCounts() == std::vector<uint32_t>{3, 4});
+
+    // Modifiers go through the mutable morphology
+    const morphio::Morphology twoPoints(path, morphio::TWO_POINTS_SECTIONS);
+    const morphio::Morphology twoPointsSwc("data/nrn_ordering.swc", morphio::TWO_POINTS_SECTIONS);
+    REQUIRE(twoPoints.points() == twoPointsSwc.points());
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BinaryCorruptedFiles", "[binary]") {
+    const std::string path = "binary_corrupted.mbin";
+    morphio::mut::Morphology("data/simple.swc").write(path);
+    const std::vector<char> data = readFile(path);
+    REQUIRE(morphio::Morphology(path).points().size() == 12);
+
+    SECTION("truncated") {
+        writeFile(path, std::vector<char>(data.begin(), data.begin() + 100));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("bad magic") {
+        std::vector<char> corrupted = data;
+        corrupted[0] = 'X';
+        writeFile(path, corrupted);
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("format versions") {
+        // The version follows the 8 bytes magic. Files of version 1 differ only in their
+        // annotations, which this one does not have
+        std::vector<char> version1 = data;
+        const uint32_t one = 1;
+        std::memcpy(version1.data() + 8, &one, sizeof(one));
+        writeFile(path, version1);
+        REQUIRE(morphio::Morphology(path).points().size() == 12);
+
+        std::vector<char> future = data;
+        const uint32_t unknown = 100;
+        std::memcpy(future.data() + 8, &unknown, sizeof(unknown));
+        writeFile(path, future);
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("diameters shorter than the points") {
+        // Block 2: DIAMETERS
+        writeFile(path, shortenBlock(data, 2));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("section types shorter than the sections") {
+        // Block 5: SECTION_TYPES
+        writeFile(path, shortenBlock(data, 5));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    // simple.swc has two neurites: sections 0 to 2, then 3 to 5
+    SECTION("section that is its own parent") {
+        writeFile(path, setParent(data, 1, 1));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("parent after the section") {
+        writeFile(path, setParent(data, 1, 2));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("neurite split apart") {
+        writeFile(path, setParent(data, 4, 0));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("not sanitized") {
+        // Sections 3 and 4 get a single child each: 5 is merged into 4, without its first point
+        writeFile(path, setParent(data, 5, 4));
+        morphio::CollectingWarningSink warnings;
+        morphio::ScopedWarningSink scope(warnings);
+        const morphio::Morphology morphology(path);
+        REQUIRE(!warnings.records().empty());
+        REQUIRE(morphology.sections().size() == 4);
+        REQUIRE(morphology.points().size() == 11);
+
+        // The points read in double are merged along
+        const auto geometry = morphio::load_as<double>(path);
+        REQUIRE(geometry._sectionLevel._sections.size() == 4);
+        REQUIRE(geometry._pointLevel._points.size() == 11);
+        for (size_t i = 0; i < geometry._pointLevel._points.size(); ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                REQUIRE(static_cast<morphio::floatType>(geometry._pointLevel._points[i][j]) ==
+                        morphology.points()[i][j]);
+            }
+        }
+    }
+
+    SECTION("empty") {
+        writeFile(path, {});
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BinaryCorruptedOrganelles", "[binary]") {
+    const std::string path = "binary_corrupted_organelles.mbin";
+    morphio::mut::Morphology mutable_morph("data/simple.swc");
+    mutable_morph.mitochondria().appendRootSection(
+        morphio::Property::MitochondriaPointLevel({0, 0}, {0.5f, 0.75f}, {1.f, 2.f}));
+    mutable_morph.endoplasmicReticulum().sectionIndices() = {1, 2};
+    mutable_morph.endoplasmicReticulum().volumes() = {10.f, 20.f};
+    mutable_morph.endoplasmicReticulum().surfaceAreas() = {1.f, 2.f};
+    mutable_morph.endoplasmicReticulum().filamentCounts() = {3, 4};
+    mutable_morph.write(path);
+    const std::vector<char> data = readFile(path);
+    REQUIRE(morphio::Morphology(path).mitochondria().rootSections().size() == 1);
+
+    SECTION("mitochondrial diameters") {
+        // Block 11: MITO_DIAMETERS
+        writeFile(path, shortenBlock(data, 11));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    SECTION("endoplasmic reticulum") {
+        // Block 14: ER_VOLUMES
+        writeFile(path, shortenBlock(data, 14));
+        REQUIRE_THROWS_AS(morphio::Morphology(path), morphio::RawDataError);
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,90 @@
+#include "contrib/catch.hpp"
+
+#include <morphio/memory_usage.h>
+#include <morphio/morphology.h>
+#include <morphio/morphology_cache.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/synthetic.h>
+#include <morphio/vasc/vasculature.h>
+
+namespace {
+size_t components(const morphio::MemoryUsage& usage) {
+    return usage.points + usage.soma + usage.sections + usage.children + usage.annotations +
+           usage.mitochondria + usage.endoplasmicReticulum + usage.connectivity + usage.objects;
+}
+}  // namespace
+
+TEST_CASE("MemoryUsageMorphology", "[memory_usage]") {
+    const morphio::Morphology morphology("data/simple.swc");
+    const auto usage = morphology.memoryUsage();
+
+    REQUIRE(usage.points >= morphology.points().size() * sizeof(morphio::Point) +
+                                morphology.diameters().size() * sizeof(morphio::floatType));
+    REQUIRE(usage.soma >= sizeof(morphio::Point));
+    REQUIRE(usage.sections >= morphology.sections().size() * 2 * sizeof(int));
+    REQUIRE(usage.children > 0);
+    REQUIRE(usage.objects >= sizeof(morphio::Property::Properties));
+    REQUIRE(usage.mitochondria == 0);
+    REQUIRE(usage.allocatorOverhead > 0);
+    REQUIRE(usage.total() == components(usage) + usage.allocatorOverhead);
+
+    // Loads keep the capacity reserved while reading, unless asked to release it
+    const morphio::Morphology shrunk("data/simple.swc", morphio::SHRINK_TO_FIT);
+    REQUIRE(shrunk.memoryUsage().unused == 0);
+    REQUIRE(shrunk.memoryUsage().total() <= usage.total());
+    REQUIRE(shrunk.points() == morphology.points());
+
+    morphio::MorphologyCache cache(1 << 20);
+    cache.get("data/simple.swc");
+    REQUIRE(cache.stats().bytes == usage.total());
+}
+
+TEST_CASE("MemoryUsageMutMorphology", "[memory_usage]") {
+    const morphio::Morphology immutable("data/simple.swc");
+    morphio::mut::Morphology morphology(immutable);
+
+    // The sections share the points of the immutable morphology until modified
+    auto usage = morphology.memoryUsage();
+    REQUIRE(usage.points == immutable.memoryUsage().points);
+    REQUIRE(usage.sections > morphology.sections().size() * sizeof(morphio::mut::Section));
+    REQUIRE(usage.total() == components(usage) + usage.allocatorOverhead);
+
+    morphio::Property::PointLevel points({{0, 0, 0}, {0, 1, 0}}, {1, 1});
+    auto section = morphology.appendRootSection(points, morphio::SectionType::SECTION_AXON);
+    section->points().reserve(1000);
+    section->diameters().reserve(1000);
+    usage = morphology.memoryUsage();
+    REQUIRE(usage.unused >= 998 * (sizeof(morphio::Point) + sizeof(morphio::floatType)));
+
+    morphology.shrinkToFit();
+    const auto shrunk = morphology.memoryUsage();
+    REQUIRE(shrunk.unused == 0);
+    REQUIRE(shrunk.points < usage.points);
+    REQUIRE(section->points().size() == 2);
+
+    // Shrinking does not copy shared points
+    REQUIRE(shrunk.points - immutable.memoryUsage().points <
+            2 * (sizeof(morphio::Point) + sizeof(morphio::floatType)) + 64);
+}
+
+TEST_CASE("MemoryUsageVasculature", "[memory_usage]") {
+    morphio::synthetic::VasculatureParameters parameters;
+    parameters.sections = 100;
+    auto vasculature = morphio::synthetic::vasculature(parameters);
+    const auto usage = vasculature.memoryUsage();
+    REQUIRE(usage.points >= vasculature.points().size() * sizeof(morphio::Point));
+    REQUIRE(usage.connectivity >= vasculature.connectivity().size() * 2 * sizeof(uint32_t));
+    REQUIRE(usage.objects == 0);
+
+    vasculature.shrinkToFit();
+    REQUIRE(vasculature.memoryUsage().unused == 0);
+
+    const morphio::vasculature::Vasculature readOnly(vasculature);
+    const auto readOnlyUsage = readOnly.memoryUsage();
+    REQUIRE(readOnlyUsage.unused == 0);
+    REQUIRE(readOnlyUsage.objects > 0);
+    // The adjacency of the sections comes on top of the connections
+    REQUIRE(readOnlyUsage.connectivity > vasculature.memoryUsage().connectivity);
+    REQUIRE(readOnlyUsage.total() == components(readOnlyUsage) + readOnlyUsage.allocatorOverhead);
+}
@@ -0,0 +1,85 @@
+#include "../src/modifiers.h"
+#include "../src/readers/morphologyHDF5.h"
+#include "contrib/catch.hpp"
+
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/soma.h>
+
+namespace {
+
+void requireEqual(const morphio::Property::Properties& a, const morphio::Property::Properties& b) {
+    REQUIRE((a._pointLevel._points == b._pointLevel._points));
+    REQUIRE((a._pointLevel._diameters == b._pointLevel._diameters));
+    REQUIRE((a._pointLevel._perimeters == b._pointLevel._perimeters));
+    REQUIRE(a._sectionLevel == b._sectionLevel);
+    REQUIRE((a._somaLevel._points == b._somaLevel._points));
+    REQUIRE((a._somaLevel._diameters == b._somaLevel._diameters));
+}
+
+}  // anonymous namespace
+
+
+TEST_CASE("FlatModifiersMatchMutable", "[modifiers]") {
+    for (const char* path : {"data/complexe.swc",
+                             "data/nrn_ordering.swc",
+                             "data/reversed_NRN_neurite_order.swc",
+                             "data/three_point_soma.swc"}) {
+        for (unsigned int options = 0; options < 16; ++options) {
+            for (unsigned int nThreads : {1u, 4u}) {
+                morphio::mut::Morphology reference(path);
+                reference.applyModifiers(options);
+
+                morphio::Property::Properties properties =
+                    morphio::mut::Morphology(path).buildReadOnly();
+                morphio::modifiers::apply(properties, options, nThreads);
+
+                requireEqual(properties, reference.buildReadOnly());
+            }
+        }
+    }
+}
+
+TEST_CASE("IsSanitized", "[modifiers]") {
+    morphio::Property::Properties properties =
+        morphio::mut::Morphology("data/nrn_ordering.swc").buildReadOnly();
+    REQUIRE(morphio::modifiers::isSanitized(properties, true));
+
+    // The NO_DUPLICATES layout is sanitized but for the duplicates
+    morphio::modifiers::apply(properties, morphio::NO_DUPLICATES);
+    REQUIRE(!morphio::modifiers::isSanitized(properties, true));
+    REQUIRE(morphio::modifiers::isSanitized(properties, false));
+
+    // A section listed before its parent
+    properties = morphio::mut::Morphology("data/nrn_ordering.swc").buildReadOnly();
+    auto& sections = properties._sectionLevel._sections;
+    REQUIRE(sections.size() > 2);
+    std::swap(sections[1], sections[2]);
+    REQUIRE(!morphio::modifiers::isSanitized(properties, false));
+}
+
+TEST_CASE("H5ModifiersMatchMutable", "[modifiers]") {
+    // Already sanitized files skip the mutable round trip, the others do not
+    REQUIRE(morphio::modifiers::isSanitized(morphio::readers::h5::load("data/h5/v1/simple.h5"),
+                                            true));
+    REQUIRE(!morphio::modifiers::isSanitized(
+        morphio::readers::h5::load("data/h5/v1/two_child_unmerged.h5"), false));
+
+    for (const char* path : {"data/h5/v1/simple.h5",
+                             "data/h5/v1/Neuron.h5",
+                             "data/h5/v1/two_child_unmerged.h5"}) {
+        for (unsigned int options = 0; options < 16; ++options) {
+            morphio::mut::Morphology reference(path);
+            reference.applyModifiers(options);
+
+            const morphio::Morphology expected(reference);
+            const morphio::Morphology loaded(path, options);
+            REQUIRE((loaded.points() == expected.points()));
+            REQUIRE((loaded.diameters() == expected.diameters()));
+            REQUIRE((loaded.perimeters() == expected.perimeters()));
+            REQUIRE((loaded.sectionOffsets() == expected.sectionOffsets()));
+            REQUIRE((loaded.sectionTypes() == expected.sectionTypes()));
+            REQUIRE((loaded.soma().points() == expected.soma().points()));
+        }
+    }
+}
@@ -1,9 +1,44 @@
 #include "../src/readers/morphologyHDF5.h"
 #include "contrib/catch.hpp"
 
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+
 #include <highfive/H5File.hpp>
 #include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/section.h>
+#include <morphio/soma.h>
+#include <morphio/synthetic.h>
+#include <morphio/tools.h>
+#include <morphio/warning_sink.h>
+
+namespace {
+using OtherPrecision =
+    std::conditional<std::is_same<morphio::floatType, float>::value, double, float>::type;
 
+// The values are the same once rounded to float
+void requireRounded(const morphio::Property::PointLevelT<OtherPrecision>& values,
+                    const morphio::Property::PointLevel& expected) {
+    const morphio::Property::PointLevelT<float> rounded(values);
+    const morphio::Property::PointLevelT<float> roundedExpected(expected);
+    REQUIRE((rounded._points == roundedExpected._points));
+    REQUIRE((rounded._diameters == roundedExpected._diameters));
+    REQUIRE((rounded._perimeters == roundedExpected._perimeters));
+}
+
+// Loaded in the other precision, the morphology has the same structure and values
+void requireLoadAs(const std::string& path, unsigned int options) {
+    const auto expected = morphio::load_as<morphio::floatType>(path, options);
+    const auto geometry = morphio::load_as<OtherPrecision>(path, options);
+    REQUIRE(geometry._sectionLevel == expected._sectionLevel);
+    REQUIRE(geometry._cellLevel == expected._cellLevel);
+    requireRounded(geometry._pointLevel, expected._pointLevel);
+    requireRounded(geometry._somaLevel, expected._somaLevel);
+}
+}  // anonymous namespace
 
 TEST_CASE("LoadH5Morphology", "[morphology]") {
     const morphio::Morphology m("data/h5/v1/Neuron.h5");
@@ -35,3 +70,131 @@ TEST_CASE("LoadMergedMorphology", "[morphology]") {
     morphio::Morphology m(g);
     REQUIRE(m.rootSections().size() == 8);
 }
+
+TEST_CASE("LoadAsMorphology", "[morphology]") {
+    const morphio::Morphology m("data/simple.swc");
+    const auto singlePrecision = morphio::load_as<float>("data/simple.swc");
+    const auto doublePrecision = morphio::load_as<double>("data/simple.swc");
+
+    REQUIRE(doublePrecision._pointLevel._points.size() == m.points().size());
+    REQUIRE(doublePrecision._pointLevel._diameters.size() == m.diameters().size());
+    REQUIRE(doublePrecision._somaLevel._points.size() == m.soma().points().size());
+    REQUIRE(doublePrecision._sectionLevel == singlePrecision._sectionLevel);
+    REQUIRE(doublePrecision._cellLevel._somaType == m.somaType());
+    REQUIRE((morphio::load_as<morphio::floatType>("data/simple.swc")._pointLevel._points ==
+             m.points()));
+    for (size_t i = 0; i < m.points().size(); ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            REQUIRE(static_cast<float>(doublePrecision._pointLevel._points[i][j]) ==
+                    singlePrecision._pointLevel._points[i][j]);
+        }
+    }
+
+    const morphio::Property::PointLevelT<double> last(doublePrecision._pointLevel, {11, 12});
+    REQUIRE(last._points.size() == 1);
+    REQUIRE(morphio::distance(last._points[0], morphio::PointT<double>{{0., 0., 0.}}) > 0);
+
+    // The options are applied in the other precision as well, merged sections included
+    for (const auto path : {"data/simple.swc",
+                            "data/complexe.swc",
+                            "data/nrn_ordering.swc",
+                            "data/simple.asc",
+                            "data/nested_single_children.asc",
+                            "data/multiple_point_section.asc"}) {
+        requireLoadAs(path, morphio::NO_MODIFIER);
+        requireLoadAs(path, morphio::NO_DUPLICATES | morphio::NRN_ORDER);
+        requireLoadAs(path, morphio::TWO_POINTS_SECTIONS);
+    }
+}
+
+TEST_CASE("LoadAsPrecision", "[morphology]") {
+    // The values are parsed in the requested precision, not converted from floatType
+    const std::string swc = "load_as_precision.swc";
+    const std::string asc = "load_as_precision.asc";
+    {
+        std::ofstream file(swc);
+        file << "1 1 0.1 0.2 0.3 0.55 -1\n"
+                "2 3 0.1 0.2 0.3 0.55 1\n"
+                "3 3 1.1 1.2 1.3 0.35 2\n";
+    }
+    {
+        std::ofstream file(asc);
+        file << "((Dendrite)\n"
+                " (0.1 0.2 0.3 1.1)\n"
+                " (1.1 1.2 1.3 0.7)\n"
+                ")\n";
+    }
+    for (const auto& path : {swc, asc}) {
+        const auto doublePrecision = morphio::load_as<double>(path)._pointLevel;
+        REQUIRE(doublePrecision._points.size() == 2);
+        REQUIRE((doublePrecision._points[0] == morphio::PointT<double>{{0.1, 0.2, 0.3}}));
+        REQUIRE((doublePrecision._points[1] == morphio::PointT<double>{{1.1, 1.2, 1.3}}));
+        REQUIRE((doublePrecision._diameters == std::vector<double>{1.1, 0.7}));
+
+        const auto singlePrecision = morphio::load_as<float>(path)._pointLevel;
+        REQUIRE((singlePrecision._points[1] == morphio::PointT<float>{{1.1f, 1.2f, 1.3f}}));
+        REQUIRE((singlePrecision._diameters == std::vector<float>{1.1f, 0.7f}));
+    }
+    std::remove(swc.c_str());
+    std::remove(asc.c_str());
+}
+
+TEST_CASE("ContentHashMorphology", "[morphology]") {
+    const morphio::Morphology m("data/simple.swc");
+    const morphio::Morphology same("data/simple.swc");
+    REQUIRE(m.contentHash() == same.contentHash());
+    REQUIRE(!morphio::diff(m, same));
+
+    morphio::Property::HashOptions structure;
+    structure.points = false;
+    morphio::Property::HashOptions rounded;
+    rounded.tolerance = morphio::floatType{1} / 100;
+
+    morphio::mut::Morphology moved(m);
+    REQUIRE(moved.section(0)->points()[0][1] == 0);
+    moved.section(0)->points()[0][1] = -0.f;
+    REQUIRE(morphio::Morphology(moved).contentHash() == m.contentHash());
+
+    moved.section(0)->points()[0][0] += morphio::epsilon / 2;
+    const morphio::Morphology movedSlightly(moved);
+    REQUIRE(movedSlightly.contentHash() != m.contentHash());
+    REQUIRE(movedSlightly.contentHash(rounded) == m.contentHash(rounded));
+    REQUIRE(movedSlightly.contentHash(structure) == m.contentHash(structure));
+    REQUIRE(!morphio::diff(m, movedSlightly));
+
+    moved.section(1)->points()[1][0] += 1;
+    const morphio::Morphology movedFar(moved);
+    REQUIRE(movedFar.contentHash(rounded) != m.contentHash(rounded));
+    REQUIRE(movedFar.contentHash(structure) == m.contentHash(structure));
+    {
+        // The differences are logged, not raised as warnings
+        morphio::CountingWarningSink warnings;
+        morphio::ScopedWarningSink scope(warnings);
+        REQUIRE(morphio::diff(m, movedFar));
+        REQUIRE(warnings.total() == 0);
+    }
+    REQUIRE(morphio::diff(m.rootSections()[0], movedFar.rootSections()[0]));
+    REQUIRE(!morphio::diff(m.rootSections()[1], movedFar.rootSections()[1]));
+    REQUIRE(morphio::mut::diff(moved, morphio::mut::Morphology(m)));
+    REQUIRE(!morphio::mut::diff(*moved.section(2), *morphio::mut::Morphology(m).section(2)));
+
+    moved.deleteSection(moved.section(3));
+    const morphio::Morphology pruned(moved);
+    REQUIRE(pruned.contentHash(structure) != m.contentHash(structure));
+    REQUIRE(morphio::diff(m, pruned));
+}
+
+TEST_CASE("ContentHashOrganelles", "[morphology]") {
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.maxSections = 50;
+    parameters.mitochondria = 5;
+    const morphio::Morphology m(morphio::synthetic::neuron(parameters));
+    morphio::Property::HashOptions organelles;
+    organelles.organelles = true;
+    REQUIRE(m.contentHash(organelles) != m.contentHash());
+
+    parameters.seed = 1;
+    const morphio::Morphology other(morphio::synthetic::neuron(parameters));
+    REQUIRE(other.contentHash() != m.contentHash());
+    REQUIRE(morphio::diff(m, other));
+}
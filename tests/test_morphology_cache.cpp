@@ -0,0 +1,118 @@
+#include "contrib/catch.hpp"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <morphio/morphology_cache.h>
+
+
+TEST_CASE("MorphologyCacheSharesProperties", "[morphology_cache]") {
+    morphio::MorphologyCache cache(1 << 20);
+
+    const auto first = cache.get("data/simple.swc");
+    const auto second = cache.get("data/../data/simple.swc");
+    REQUIRE(first.points().data() == second.points().data());
+
+    // Options are part of the key
+    const auto twoPoints = cache.get("data/simple.swc", morphio::TWO_POINTS_SECTIONS);
+    REQUIRE(twoPoints.points().data() != first.points().data());
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.evictions == 0);
+    REQUIRE(stats.entries == 2);
+    REQUIRE(stats.bytes > 0);
+
+    REQUIRE_THROWS_AS(cache.get("data/missing.swc"), morphio::RawDataError);
+
+    cache.clear();
+    REQUIRE(cache.stats().entries == 0);
+    REQUIRE(cache.get("data/simple.swc").points().data() != first.points().data());
+}
+
+TEST_CASE("MorphologyCacheEviction", "[morphology_cache]") {
+    morphio::MorphologyCache probe(1 << 20);
+    probe.get("data/simple.swc");
+    const size_t oneEntry = probe.stats().bytes;
+
+    morphio::MorphologyCache cache(oneEntry);
+    const auto first = cache.get("data/simple.swc");
+    cache.get("data/simple.swc", morphio::SOMA_SPHERE);
+    auto stats = cache.stats();
+    REQUIRE(stats.evictions == 1);
+    REQUIRE(stats.entries == 1);
+
+    // the evicted morphology is still usable
+    REQUIRE(first.points().size() == 12);
+
+    cache.get("data/simple.swc");
+    REQUIRE(cache.stats().misses == 3);
+
+    // Entries larger than the budget are not cached
+    morphio::MorphologyCache tiny(1);
+    tiny.get("data/simple.swc");
+    tiny.get("data/simple.swc");
+    REQUIRE(tiny.stats().misses == 2);
+    REQUIRE(tiny.stats().entries == 0);
+}
+
+TEST_CASE("MorphologyCacheConcurrentLookups", "[morphology_cache]") {
+    morphio::MorphologyCache cache(1 << 20);
+    std::vector<const void*> data(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < data.size(); ++i) {
+        threads.emplace_back([&cache, &data, i]() {
+            data[i] = cache.get("data/nrn_ordering.swc").points().data();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& pointer : data) {
+        REQUIRE(pointer == data[0]);
+    }
+    REQUIRE(cache.stats().misses == 1);
+    REQUIRE(cache.stats().hits == 7);
+}
+
+TEST_CASE("MorphologyCacheQuantizedPoints", "[morphology_cache]") {
+    const std::string path = "data/nrn_ordering.swc";
+    const morphio::Morphology exact(path);
+    morphio::Property::PointLevel level;
+    level._points.assign(exact.points().begin(), exact.points().end());
+    level._diameters.assign(exact.diameters().begin(), exact.diameters().end());
+    const morphio::Property::QuantizedPointLevel quantized(level);
+
+    morphio::MorphologyCache full(1 << 20);
+    full.get(path);
+    morphio::MorphologyCache cache(1 << 20, true);
+    REQUIRE(cache.quantizePoints());
+
+    std::vector<morphio::Point> points;
+    {
+        const auto first = cache.get(path);
+        REQUIRE(cache.stats().bytes < full.stats().bytes);
+        REQUIRE((first.sectionOffsets() == exact.sectionOffsets()));
+        REQUIRE(first.points().size() == exact.points().size());
+        for (size_t i = 0; i < exact.points().size(); ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                REQUIRE(std::fabs(first.points()[i][j] - exact.points()[i][j]) <=
+                        quantized.pointTolerance());
+            }
+            REQUIRE(std::fabs(first.diameters()[i] - exact.diameters()[i]) <=
+                    quantized.diameterTolerance());
+        }
+
+        // Shared while a morphology refers to them
+        REQUIRE(cache.get(path).points().data() == first.points().data());
+        points.assign(first.points().begin(), first.points().end());
+    }
+
+    // Decoded again once they are released
+    const auto again = cache.get(path);
+    REQUIRE((std::vector<morphio::Point>(again.points().begin(), again.points().end()) == points));
+    REQUIRE(cache.stats().misses == 1);
+    REQUIRE(cache.stats().hits == 2);
+}
@@ -0,0 +1,139 @@
+#include "contrib/catch.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <morphio/morphology_store.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/synthetic.h>
+#include <morphio/tools.h>
+
+namespace {
+/** Copy the archive at source to path, with the uint64 at offset replaced by value **/
+void corrupt(const std::string& source, const std::string& path, size_t offset, uint64_t value) {
+    std::ifstream in(source, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::memcpy(&data[offset], &value, sizeof(value));
+    std::ofstream out(path, std::ios::binary);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+}  // namespace
+
+TEST_CASE("MorphologyStoreDeduplicates", "[morphology_store]") {
+    morphio::MorphologyStore store;
+
+    const auto first = store.add("first", morphio::Morphology("data/simple.swc"));
+    const auto second = store.add("second", morphio::Morphology("data/simple.swc"));
+    REQUIRE(first.points().data() == second.points().data());
+    REQUIRE(store.get("second").points().data() == first.points().data());
+
+    morphio::mut::Morphology moved{morphio::Morphology("data/simple.swc")};
+    moved.section(1)->points()[1][0] += 1;
+    const auto third = store.add("third", moved);
+    REQUIRE(third.points().data() != first.points().data());
+
+    auto stats = store.stats();
+    REQUIRE(stats.names == 3);
+    REQUIRE(stats.unique == 2);
+    REQUIRE(stats.savedBytes == first.memoryUsage().total());
+    REQUIRE(stats.bytes == first.memoryUsage().total() + third.memoryUsage().total());
+    REQUIRE(store.names() == std::vector<std::string>{"first", "second", "third"});
+
+    // Renaming the last name of a morphology drops it
+    store.add("third", first);
+    stats = store.stats();
+    REQUIRE(stats.unique == 1);
+    REQUIRE(store.get("third").points().data() == first.points().data());
+
+    REQUIRE(store.contains("first"));
+    REQUIRE(!store.contains("fourth"));
+    REQUIRE_THROWS_AS(store.get("fourth"), morphio::MorphioError);
+}
+
+TEST_CASE("MorphologyStoreArchive", "[morphology_store]") {
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.maxSections = 100;
+    parameters.mitochondria = 3;
+    parameters.reticulumRate = morphio::floatType{1} / 2;
+
+    morphio::MorphologyStore store;
+    for (uint32_t i = 0; i < 6; ++i) {
+        // Three distinct morphologies, twice each
+        parameters.seed = i % 3;
+        store.add("neuron_" + std::to_string(i), morphio::synthetic::neuron(parameters));
+    }
+    store.add("simple", morphio::Morphology("data/simple.swc"));
+    REQUIRE(store.stats().unique == 4);
+
+    const std::string path = "store_archive.mstore";
+    store.write(path);
+
+    const morphio::MorphologyStore loaded(path);
+    REQUIRE(loaded.names() == store.names());
+    const auto stats = loaded.stats();
+    REQUIRE(stats.names == 7);
+    REQUIRE(stats.unique == 4);
+    for (const auto& name : store.names()) {
+        REQUIRE(!morphio::diff(loaded.get(name), store.get(name)));
+        REQUIRE(loaded.get(name).contentHash() == store.get(name).contentHash());
+    }
+    REQUIRE(loaded.get("neuron_0").points().data() == loaded.get("neuron_3").points().data());
+    REQUIRE(loaded.get("neuron_0").mitochondria().rootSections().size() ==
+            store.get("neuron_0").mitochondria().rootSections().size());
+    REQUIRE(!loaded.get("neuron_0").mitochondria().rootSections().empty());
+
+    // Reading into a store merges the archive
+    morphio::MorphologyStore merged;
+    merged.add("other", morphio::Morphology("data/simple.swc"));
+    merged.read(path);
+    REQUIRE(merged.stats().names == 8);
+    REQUIRE(merged.stats().unique == 4);
+    std::remove(path.c_str());
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "MORPHIOB and more bytes that do not make an archive, padded to 64 bytes.......";
+    }
+    REQUIRE_THROWS_AS(morphio::MorphologyStore(path), morphio::RawDataError);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(morphio::MorphologyStore(path), morphio::RawDataError);
+}
+
+TEST_CASE("MorphologyStoreCorrupted", "[morphology_store]") {
+    morphio::MorphologyStore store;
+    store.add("simple", morphio::Morphology("data/simple.swc"));
+    const std::string source = "store_source.mstore";
+    const std::string path = "store_corrupted.mstore";
+    store.write(source);
+
+    // Header: the number of morphologies at 16, of names at 24 and the size of the names at 32.
+    // The morphology table follows, from 64: offset, then size
+    const uint64_t huge = uint64_t{1} << 62;
+    for (const size_t offset : {16, 24, 32, 64, 72}) {
+        for (const uint64_t value : {huge, ~uint64_t{0}}) {
+            corrupt(source, path, offset, value);
+            REQUIRE_THROWS_AS(morphio::MorphologyStore(path), morphio::RawDataError);
+        }
+    }
+
+    // The name table follows the morphology table, from 88: morphology index, then name size
+    corrupt(source, path, 96, ~uint64_t{0});
+    REQUIRE_THROWS_AS(morphio::MorphologyStore(path), morphio::RawDataError);
+
+    // A corrupted entry after valid ones leaves the store unchanged: the second name refers to
+    // a morphology that does not exist
+    store.add("twin", morphio::Morphology("data/simple.swc"));
+    store.write(source);
+    corrupt(source, path, 104, 1);
+    morphio::MorphologyStore existing;
+    existing.add("existing", morphio::Morphology("data/simple.swc"));
+    REQUIRE_THROWS_AS(existing.read(path), morphio::RawDataError);
+    REQUIRE((existing.names() == std::vector<std::string>{"existing"}));
+    REQUIRE(existing.stats().unique == 1);
+
+    std::remove(source.c_str());
+    std::remove(path.c_str());
+}
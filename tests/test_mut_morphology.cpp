@@ -0,0 +1,255 @@
+#include "contrib/catch.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <morphio/errorMessages.h>
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+
+
+TEST_CASE("MutSectionsOutliveMorphology", "[mut]") {
+    std::shared_ptr<morphio::mut::Section> section;
+    {
+        morphio::mut::Morphology morpho("data/simple.swc");
+        section = morpho.rootSections().front()->children().front();
+    }
+    // The section storage is released with the last section, not with the morphology
+    REQUIRE(section->points().size() == 2);
+    REQUIRE(section->points().back() == morphio::Point({-5.f, 5.f, 0.f}));
+}
+
+TEST_CASE("MutSectionsRecycled", "[mut]") {
+    morphio::mut::Morphology morpho("data/simple.swc");
+    const size_t nSections = morpho.sections().size();
+
+    for (int i = 0; i < 10; ++i) {
+        const auto root = morpho.rootSections().back();
+        morphio::mut::Morphology other;
+        const auto copy = other.appendRootSection(root, true);
+        morpho.deleteSection(root, true);
+        morpho.appendRootSection(copy, true);
+    }
+
+    REQUIRE(morpho.sections().size() == nSections);
+    std::vector<morphio::Point> points;
+    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
+        for (const auto& point : (*it)->points()) {
+            points.push_back(point);
+        }
+    }
+    REQUIRE(points.size() == 12);
+}
+
+TEST_CASE("MutDeleteSection", "[mut]") {
+    morphio::mut::Morphology morpho("data/simple.swc");
+    REQUIRE(morpho.connectivity() ==
+            std::unordered_map<int, std::vector<unsigned int>>{{-1, {0, 3}},
+                                                               {0, {1, 2}},
+                                                               {3, {4, 5}}});
+
+    SECTION("recursive") {
+        morpho.deleteSection(morpho.section(3), true);
+        REQUIRE(morpho.sections().size() == 3);
+        REQUIRE(morpho.connectivity() ==
+                std::unordered_map<int, std::vector<unsigned int>>{{-1, {0}}, {0, {1, 2}}});
+    }
+
+    SECTION("children re-attached to the grand-parent") {
+        const auto child = morpho.section(1);
+        morpho.deleteSection(morpho.section(1), false);
+        morpho.deleteSection(child, false);  // no longer part of the tree
+        REQUIRE(morpho.sections().size() == 5);
+
+        // Children of a deleted root become roots
+        morpho.deleteSection(morpho.section(0), false);
+        REQUIRE(morpho.connectivity() ==
+                std::unordered_map<int, std::vector<unsigned int>>{{-1, {3, 2}}, {3, {4, 5}}});
+        REQUIRE(morpho.section(2)->isRoot());
+        REQUIRE_THROWS_AS(morpho.section(2)->parent(), std::out_of_range);
+        REQUIRE(morpho.section(4)->parent() == morpho.section(3));
+    }
+}
+
+TEST_CASE("MutSanitizeChains", "[mut]") {
+    morphio::mut::Morphology morpho;
+    const auto root = morpho.appendRootSection(
+        morphio::Property::PointLevel({{0.f, 0.f, 0.f}, {0.f, 1.f, 0.f}}, {1.f, 1.f}),
+        morphio::SECTION_AXON);
+    auto current = root;
+    for (int i = 1; i < 4; ++i) {
+        const auto y = static_cast<morphio::floatType>(i);
+        current = current->appendSection(
+            morphio::Property::PointLevel({{0.f, y, 0.f}, {0.f, y + 1, 0.f}}, {1.f, 1.f}));
+    }
+    const auto leaf1 = current->appendSection(
+        morphio::Property::PointLevel({{0.f, 4.f, 0.f}, {1.f, 5.f, 0.f}}, {1.f, 1.f}));
+    const auto leaf2 = current->appendSection(
+        morphio::Property::PointLevel({{0.f, 4.f, 0.f}, {-1.f, 5.f, 0.f}}, {1.f, 1.f}));
+
+    morphio::set_ignored_warning(morphio::Warning::ONLY_CHILD, true);
+
+    SECTION("point copies") {
+        morpho.sanitize();
+        REQUIRE(morpho.annotations().size() == 3);
+        REQUIRE(morpho.annotations()[0]._sectionId == 1);
+        REQUIRE(morpho.annotations()[0]._points._points.size() == 2);
+    }
+
+    SECTION("point ranges") {
+        morpho.sanitize(morphio::readers::DebugInfo(), false);
+        REQUIRE(morpho.annotations().size() == 3);
+        for (size_t i = 0; i < 3; ++i) {
+            REQUIRE(morpho.annotations()[i]._sectionId == 0);
+            REQUIRE(morpho.annotations()[i]._points._points.empty());
+            REQUIRE(morpho.annotations()[i]._pointRange ==
+                    morphio::SectionRange(2 + i, 3 + i));
+        }
+    }
+
+    morphio::set_ignored_warning(morphio::Warning::ONLY_CHILD, false);
+
+    REQUIRE(morpho.sections().size() == 3);
+    REQUIRE(root->points().size() == 5);
+    REQUIRE(root->points().back() == morphio::Point({0.f, 4.f, 0.f}));
+    REQUIRE(root->children() == std::vector<std::shared_ptr<morphio::mut::Section>>{leaf1, leaf2});
+    REQUIRE(leaf1->parent() == root);
+}
+
+namespace {
+struct CountingWarning: public morphio::WarningMessage {
+    explicit CountingWarning(int& formatted_)
+        : WarningMessage(morphio::Warning::UNDEFINED)
+        , formatted(formatted_) {}
+    std::string msg() const override {
+        ++formatted;
+        return "Warning: lazy";
+    }
+
+    int& formatted;
+};
+}  // namespace
+
+TEST_CASE("MutLazyWarnings", "[mut]") {
+    // Messages are only formatted when printed
+    int formatted = 0;
+    morphio::set_maximum_warnings(0);
+    morphio::printError(CountingWarning(formatted));
+    REQUIRE(formatted == 0);
+
+    morphio::set_maximum_warnings(-1);
+    morphio::set_ignored_warning(morphio::Warning::UNDEFINED, true);
+    morphio::printError(CountingWarning(formatted));
+    REQUIRE(formatted == 0);
+
+    morphio::set_ignored_warning(morphio::Warning::UNDEFINED, false);
+    morphio::printError(CountingWarning(formatted));
+    REQUIRE(formatted == 1);
+    morphio::set_maximum_warnings(100);
+}
+
+TEST_CASE("MutCopyOnWrite", "[mut]") {
+    const morphio::Morphology immutable("data/nrn_ordering.swc");
+    const std::vector<morphio::Point> immutablePoints(immutable.points().begin(),
+                                                      immutable.points().end());
+    morphio::mut::Morphology morpho(immutable);
+    const morphio::mut::Morphology copy(morpho);
+
+    // Untouched, the sections are written back as they were read
+    REQUIRE((morpho.buildReadOnly()._pointLevel._points == immutablePoints));
+
+    const morphio::Point moved({100.f, 100.f, 100.f});
+    morpho.section(1)->points()[0] = moved;
+    morpho.section(1)->diameters()[0] = 42.f;
+    morpho.deleteSection(morpho.section(3));
+
+    // The immutable morphology and the copy still see the original points
+    REQUIRE(immutable.section(1).points()[0] != moved);
+    REQUIRE(copy.section(1)->points()[0] == immutable.section(1).points()[0]);
+    REQUIRE((copy.buildReadOnly()._pointLevel._points == immutablePoints));
+
+    std::vector<morphio::Point> expectedPoints;
+    std::vector<morphio::floatType> expectedDiameters;
+    size_t movedPoint = 0;
+    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
+        const auto section = immutable.section((*it)->id());
+        if ((*it)->id() == 1) {
+            movedPoint = expectedPoints.size();
+        }
+        expectedPoints.insert(expectedPoints.end(),
+                              section.points().begin(),
+                              section.points().end());
+        expectedDiameters.insert(expectedDiameters.end(),
+                                 section.diameters().begin(),
+                                 section.diameters().end());
+    }
+    expectedPoints[movedPoint] = moved;
+    expectedDiameters[movedPoint] = 42.f;
+
+    const morphio::Property::Properties edited = morpho.buildReadOnly();
+    REQUIRE((edited._pointLevel._points == expectedPoints));
+    REQUIRE((edited._pointLevel._diameters == expectedDiameters));
+}
+
+namespace {
+// Exposes the properties of an immutable morphology to watch their lifetime
+class WatchedMorphology: public morphio::Morphology
+{
+  public:
+    using morphio::Morphology::Morphology;
+
+    std::weak_ptr<morphio::Property::Properties> properties() const {
+        return _properties;
+    }
+};
+}  // anonymous namespace
+
+TEST_CASE("MutCopyOnWriteRelease", "[mut]") {
+    std::unique_ptr<WatchedMorphology> immutable(new WatchedMorphology("data/nrn_ordering.swc"));
+    const auto properties = immutable->properties();
+    morphio::mut::Morphology morpho(*immutable);
+    immutable.reset();
+    REQUIRE(!properties.expired());
+
+    // Editing every section drops the last references to the immutable properties
+    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
+        (*it)->diameters()[0] += 1;
+    }
+    REQUIRE(properties.expired());
+    REQUIRE(morpho.section(0)->points().size() ==
+            morphio::Morphology("data/nrn_ordering.swc").section(0).points().size());
+}
+
+TEST_CASE("MutBuildReadOnlyRvalue", "[mut]") {
+    morphio::mut::Morphology morpho("data/nrn_ordering.swc");
+    morpho.section(2)->points()[0] = morphio::Point({1.f, 2.f, 3.f});
+    morpho.deleteSection(morpho.section(5));
+    morpho.sanitize();
+    morpho.addAnnotation(morphio::Property::Annotation(
+        morphio::AnnotationType::SINGLE_CHILD, 0, morphio::SectionRange(0, 1), "", 1));
+
+    const morphio::Property::Properties expected = morpho.buildReadOnly();
+    const morphio::Morphology immutable(morpho);
+    REQUIRE(immutable.points().size() == expected._pointLevel._points.size());
+    REQUIRE(immutable.sections().size() == expected._sectionLevel._sections.size());
+
+    const morphio::Property::Properties moved = std::move(morpho).buildReadOnly();
+    REQUIRE((moved._pointLevel._points == expected._pointLevel._points));
+    REQUIRE((moved._pointLevel._diameters == expected._pointLevel._diameters));
+    REQUIRE((moved._pointLevel._perimeters == expected._pointLevel._perimeters));
+    REQUIRE((moved._somaLevel._points == expected._somaLevel._points));
+    REQUIRE(moved._sectionLevel == expected._sectionLevel);
+    REQUIRE(moved._annotations.size() == expected._annotations.size());
+
+    // A soma shared with another morphology is copied, not emptied
+    morphio::mut::Morphology owner("data/simple.swc");
+    morphio::mut::Morphology sharing("data/simple.swc");
+    sharing.soma() = owner.soma();
+    const auto somaPoints = owner.soma()->points();
+    REQUIRE(!somaPoints.empty());
+    REQUIRE((std::move(owner).buildReadOnly()._somaLevel._points == somaPoints));
+    REQUIRE((sharing.soma()->points() == somaPoints));
+}
@@ -0,0 +1,77 @@
+#include "contrib/catch.hpp"
+
+#include <cmath>
+
+#include <morphio/quantized_point_level.h>
+#include <morphio/synthetic.h>
+
+namespace {
+void requireWithin(const morphio::Property::PointLevel& original,
+                   const morphio::Property::QuantizedPointLevel& quantized,
+                   size_t offset = 0) {
+    for (size_t i = 0; i < original._points.size(); ++i) {
+        const auto point = quantized.point(offset + i);
+        for (size_t j = 0; j < 3; ++j) {
+            REQUIRE(std::fabs(point[j] - original._points[i][j]) <= quantized.pointTolerance());
+        }
+        REQUIRE(std::fabs(quantized.diameter(offset + i) - original._diameters[i]) <=
+                quantized.diameterTolerance());
+    }
+}
+}  // namespace
+
+TEST_CASE("QuantizedPointLevelPrecision", "[quantized]") {
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.maxSections = 500;
+    const auto morphology = morphio::synthetic::neuron(parameters);
+    const auto properties = morphology.buildReadOnly();
+    const auto& level = properties._pointLevel;
+
+    const morphio::Property::QuantizedPointLevel quantized(level);
+    REQUIRE(quantized.size() == level._points.size());
+    REQUIRE(quantized.pointTolerance() > 0);
+    requireWithin(level, quantized);
+
+    const auto decoded = quantized.decode();
+    REQUIRE(decoded._points.size() == level._points.size());
+    REQUIRE(decoded._perimeters.empty());
+    for (size_t i = 0; i < level._points.size(); ++i) {
+        REQUIRE(decoded._points[i] == quantized.point(i));
+        REQUIRE(decoded._diameters[i] == quantized.diameter(i));
+    }
+
+    // Decoding a section reuses the buffer
+    morphio::Property::PointLevel buffer;
+    quantized.decode({10, 20}, buffer);
+    REQUIRE(buffer._points.size() == 10);
+    quantized.decode({20, 25}, buffer);
+    REQUIRE(buffer._points.size() == 5);
+    REQUIRE(buffer._points[0] == quantized.point(20));
+    requireWithin(morphio::Property::PointLevel(level, {20, 25}), quantized, 20);
+
+    const auto usage = quantized.memoryUsage();
+    REQUIRE(usage.points < morphology.memoryUsage().points);
+    REQUIRE(usage.points >= level._points.size() * 4 * sizeof(uint16_t));
+}
+
+TEST_CASE("QuantizedPointLevelEdgeCases", "[quantized]") {
+    REQUIRE(morphio::Property::QuantizedPointLevel().decode()._points.empty());
+
+    // Constant values and minimums decode exactly
+    const morphio::Property::PointLevel level({{1, 2, 3}, {1, 1000, -3}, {1, 2, 3}},
+                                              {2, 2, 2},
+                                              {0, 5, 10});
+    const morphio::Property::QuantizedPointLevel quantized(level);
+    REQUIRE(quantized.point(0)[0] == 1);
+    REQUIRE(quantized.point(0)[1] == 2);
+    REQUIRE(quantized.point(1)[2] == -3);
+    REQUIRE(quantized.diameter(1) == 2);
+    REQUIRE(quantized.perimeter(0) == 0);
+    requireWithin(level, quantized);
+    for (size_t i = 0; i < 3; ++i) {
+        REQUIRE(std::fabs(quantized.perimeter(i) - level._perimeters[i]) <=
+                quantized.perimeterTolerance());
+    }
+    REQUIRE(quantized.pointTolerance() < 1000.f / 65535);
+    REQUIRE(quantized.decode()._perimeters.size() == 3);
+}
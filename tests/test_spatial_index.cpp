@@ -0,0 +1,83 @@
+#include "contrib/catch.hpp"
+
+#include <morphio/morphology.h>
+#include <morphio/spatial_index.h>
+
+using morphio::operator+;
+using morphio::operator-;
+using morphio::operator*;
+
+
+TEST_CASE("SpatialIndexQueries", "[spatial_index]") {
+    const morphio::Morphology m("data/simple.swc");
+    const morphio::SpatialIndex index(m);
+
+    REQUIRE(index.size() == 6);
+
+    const auto bounds = index.bounds();
+    REQUIRE(bounds.min == morphio::Point({-7.f, -6.f, -2.f}));
+    REQUIRE(bounds.max == morphio::Point({8.f, 6.5f, 2.f}));
+
+    const morphio::BoundingBox box{{5.5f, 4.5f, -0.5f}, {6.5f, 5.5f, 0.5f}};
+    REQUIRE(index.intersects(box) == std::vector<morphio::SegmentId>{{2, 0}});
+
+    REQUIRE(index.intersects(morphio::Point{0.f, 2.5f, 0.f}, 0.1f) ==
+            std::vector<morphio::SegmentId>{{0, 0}});
+    REQUIRE(index.intersects(morphio::Point{0.f, 20.f, 0.f}, 1.f).empty());
+
+    const auto nearest = index.nearest({10.f, 5.f, 0.f});
+    REQUIRE(nearest.id == morphio::SegmentId{2, 0});
+    REQUIRE(nearest.distance == Approx(2.5));
+}
+
+TEST_CASE("SpatialIndexMatchesBruteForce", "[spatial_index]") {
+    const morphio::Morphology m("data/nrn_ordering.swc");
+    const morphio::SpatialIndex index(m);
+
+    const auto& points = m.points();
+    const auto offsets = m.sectionOffsets();
+    const auto bounds = index.bounds();
+
+    morphio::Points centers;
+    std::vector<morphio::floatType> radii;
+    for (size_t i = 0; i < 200; ++i) {
+        // deterministic pseudo-random query points spread over the bounds
+        const auto t = static_cast<morphio::floatType>((i * 7919) % 1000) / 1000;
+        const auto u = static_cast<morphio::floatType>((i * 104729) % 1000) / 1000;
+        const auto w = static_cast<morphio::floatType>((i * 1299709) % 1000) / 1000;
+        centers.push_back({bounds.min[0] + t * (bounds.max[0] - bounds.min[0]),
+                           bounds.min[1] + u * (bounds.max[1] - bounds.min[1]),
+                           bounds.min[2] + w * (bounds.max[2] - bounds.min[2])});
+        radii.push_back(static_cast<morphio::floatType>(5 + i % 20));
+    }
+
+    const auto spheres = index.intersects(centers, radii, 4);
+    const auto nearest = index.nearest(centers, 4);
+    REQUIRE(spheres.size() == centers.size());
+
+    for (size_t q = 0; q < centers.size(); ++q) {
+        std::vector<morphio::SegmentId> expected;
+        morphio::floatType best = std::numeric_limits<morphio::floatType>::max();
+        for (uint32_t s = 0; s + 1 < offsets.size(); ++s) {
+            for (uint32_t i = offsets[s]; i + 1 < offsets[s + 1]; ++i) {
+                const auto radius = std::max(m.diameters()[i], m.diameters()[i + 1]) / 2;
+                const auto axis = points[i + 1] - points[i];
+                const auto length2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+                const auto delta = centers[q] - points[i];
+                auto t = length2 > 0
+                             ? (delta[0] * axis[0] + delta[1] * axis[1] + delta[2] * axis[2]) /
+                                   length2
+                             : 0;
+                t = std::min(std::max(t, morphio::floatType{0}), morphio::floatType{1});
+                const auto distance = morphio::distance(centers[q], points[i] + axis * t);
+                if (distance <= radii[q] + radius) {
+                    expected.push_back({s, i - offsets[s]});
+                }
+                best = std::min(best, std::max(distance - radius, morphio::floatType{0}));
+            }
+        }
+        REQUIRE(spheres[q] == expected);
+        REQUIRE(nearest[q].distance == Approx(best));
+        REQUIRE(nearest[q].id == index.nearest(centers[q]).id);
+    }
+}
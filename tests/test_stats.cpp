@@ -0,0 +1,140 @@
+#include "contrib/catch.hpp"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/soma.h>
+#include <morphio/stats.h>
+
+namespace {
+double phasesSeconds(const morphio::Stats& stats) {
+    double seconds = 0;
+    for (size_t i = morphio::Stats::READ; i < morphio::Stats::PHASE_COUNT; ++i) {
+        seconds += stats.seconds[i];
+    }
+    return seconds;
+}
+}  // namespace
+
+TEST_CASE("StatsCollectLoads", "[stats]") {
+    morphio::Stats stats;
+    {
+        morphio::StatsCollector collector(stats);
+        morphio::Morphology("data/simple.swc");
+        morphio::Morphology("data/simple.swc", morphio::NRN_ORDER);
+        morphio::Morphology("data/neurite_wrong_root_point.swc");
+    }
+    morphio::Morphology("data/simple.swc");
+
+    if (!morphio::statsEnabled()) {
+        REQUIRE(stats.loads == 0);
+        REQUIRE(stats.calls[morphio::Stats::LOAD] == 0);
+        return;
+    }
+
+    REQUIRE(stats.loads == 3);
+    REQUIRE(stats.calls[morphio::Stats::LOAD] == 3);
+    REQUIRE(stats.calls[morphio::Stats::SANITIZE] == 3);
+    REQUIRE(stats.calls[morphio::Stats::BUILD_READ_ONLY] == 3);
+    REQUIRE(stats.calls[morphio::Stats::BUILD_CHILDREN] == 3);
+    REQUIRE(stats.calls[morphio::Stats::MODIFIERS] == 1);
+    REQUIRE(stats.calls[morphio::Stats::PARSE] > 0);
+    REQUIRE(stats.calls[morphio::Stats::PROBE] == 0);
+    REQUIRE(stats.bytesRead == 610 + 610 + 270);
+    REQUIRE(stats.allocatedBytes > 0);
+    REQUIRE(stats.warnings == 1);
+
+    // The other phases run within the loads, one at a time
+    REQUIRE(stats.seconds[morphio::Stats::LOAD] > 0);
+    REQUIRE(phasesSeconds(stats) <= stats.seconds[morphio::Stats::LOAD]);
+}
+
+TEST_CASE("StatsH5Load", "[stats]") {
+    morphio::Stats stats;
+    morphio::StatsCollector collector(stats);
+    const morphio::Morphology morphology("data/h5/v1/simple.h5");
+
+    if (morphio::statsEnabled()) {
+        REQUIRE(stats.loads == 1);
+        REQUIRE(stats.calls[morphio::Stats::PROBE] == 1);
+        REQUIRE(stats.calls[morphio::Stats::READ] == 1);
+        REQUIRE(stats.calls[morphio::Stats::PARSE] == 0);
+        // Rows of 4 floats for the points, of 3 ints for the structure including the soma
+        const size_t nPoints = morphology.soma().points().size() + morphology.points().size();
+        REQUIRE(stats.bytesRead == nPoints * 4 * sizeof(morphio::floatType) +
+                                       (morphology.sections().size() + 1) * 3 * sizeof(int));
+    }
+}
+
+TEST_CASE("StatsBinaryLoad", "[stats]") {
+    const std::string path = "stats_simple.mbin";
+    morphio::mut::Morphology("data/simple.swc").write(path);
+
+    morphio::Stats stats;
+    {
+        morphio::StatsCollector collector(stats);
+        morphio::Morphology morphology(path);
+    }
+    std::remove(path.c_str());
+
+    if (morphio::statsEnabled()) {
+        REQUIRE(stats.loads == 1);
+        REQUIRE(stats.calls[morphio::Stats::PARSE] == 1);
+        REQUIRE(stats.calls[morphio::Stats::SANITIZE] == 0);
+        REQUIRE(stats.bytesRead > 0);
+    }
+}
+
+TEST_CASE("StatsCollectorsNest", "[stats]") {
+    morphio::Stats outer;
+    morphio::Stats inner;
+    {
+        morphio::StatsCollector outerCollector(outer);
+        morphio::Morphology("data/simple.swc");
+        {
+            morphio::StatsCollector innerCollector(inner);
+            morphio::Morphology("data/simple.swc");
+            morphio::Morphology("data/simple.swc");
+        }
+        morphio::Morphology("data/simple.swc");
+    }
+
+    const uint64_t enabled = morphio::statsEnabled() ? 1 : 0;
+    REQUIRE(outer.loads == 2 * enabled);
+    REQUIRE(inner.loads == 2 * enabled);
+
+    outer += inner;
+    REQUIRE(outer.loads == 4 * enabled);
+    REQUIRE(outer.bytesRead == 4 * 610 * enabled);
+}
+
+TEST_CASE("StatsPerThread", "[stats]") {
+    // Each thread collects its own loads; the batch total is their sum
+    const size_t nThreads = 4;
+    std::vector<morphio::Stats> stats(nThreads);
+    morphio::Stats mainStats;
+    morphio::StatsCollector collector(mainStats);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; ++i) {
+        threads.emplace_back([&stats, i]() {
+            morphio::StatsCollector threadCollector(stats[i]);
+            for (size_t j = 0; j <= i; ++j) {
+                morphio::Morphology("data/simple.swc");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    morphio::Stats total;
+    for (const auto& threadStats : stats) {
+        total += threadStats;
+    }
+    REQUIRE(mainStats.loads == 0);
+    REQUIRE(total.loads == (morphio::statsEnabled() ? 10 : 0));
+}
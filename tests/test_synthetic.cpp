@@ -0,0 +1,115 @@
+#include "contrib/catch.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <morphio/exceptions.h>
+#include <morphio/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/section.h>
+#include <morphio/synthetic.h>
+#include <morphio/vasc/section.h>
+#include <morphio/vasc/vasculature.h>
+
+TEST_CASE("SyntheticNeuronShape", "[synthetic]") {
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.neurites = 3;
+    parameters.maxDepth = 4;
+
+    SECTION("complete trees") {
+        const auto neuron = parameters.neurites * ((1u << (parameters.maxDepth + 1)) - 1);
+        REQUIRE(morphio::synthetic::neuron(parameters).sections().size() == neuron);
+    }
+
+    SECTION("section limit") {
+        parameters.maxSections = 20;
+        REQUIRE(morphio::synthetic::neuron(parameters).sections().size() == 20);
+    }
+
+    SECTION("chains") {
+        parameters.unifurcationRate = 1;
+        const auto neuron = morphio::synthetic::neuron(parameters);
+        REQUIRE(neuron.sections().size() == parameters.neurites * (parameters.maxDepth + 1));
+        for (const auto& section : neuron.sections()) {
+            REQUIRE(section.second->children().size() <= 1);
+            REQUIRE(section.second->points().size() == parameters.pointsPerSection);
+        }
+    }
+
+    SECTION("organelles") {
+        parameters.mitochondria = 5;
+        parameters.reticulumRate = 1;
+        const auto neuron = morphio::synthetic::neuron(parameters);
+        REQUIRE(neuron.mitochondria().rootSections().size() == 5);
+        REQUIRE(neuron.endoplasmicReticulum().sectionIndices().size() ==
+                neuron.sections().size());
+    }
+
+    SECTION("invalid parameters") {
+        parameters.fanOut = 0;
+        REQUIRE_THROWS_AS(morphio::synthetic::neuron(parameters), morphio::SectionBuilderError);
+    }
+}
+
+TEST_CASE("SyntheticNeuronDeterministic", "[synthetic]") {
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.maxDepth = 5;
+    const morphio::Morphology first(morphio::synthetic::neuron(parameters));
+    const morphio::Morphology second(morphio::synthetic::neuron(parameters));
+    REQUIRE(first.points() == second.points());
+    REQUIRE(first.diameters() == second.diameters());
+
+    parameters.seed = 1;
+    const morphio::Morphology other(morphio::synthetic::neuron(parameters));
+    REQUIRE(other.points().size() == first.points().size());
+    REQUIRE(other.points() != first.points());
+}
+
+TEST_CASE("SyntheticNeuronDeep", "[synthetic]") {
+    // Combs deep enough to overflow the stack of recursive traversals
+    morphio::synthetic::NeuronParameters parameters;
+    parameters.neurites = 1;
+    parameters.maxDepth = 5000;
+    parameters.leafRate = 1;
+    parameters.pointsPerSection = 2;
+    const morphio::Morphology neuron(morphio::synthetic::neuron(parameters));
+    REQUIRE(neuron.sections().size() == 1 + 2 * parameters.maxDepth);
+
+    const auto root = neuron.rootSections().front();
+    REQUIRE(std::distance(root.depth_begin(), root.depth_end()) == 1 + 2 * parameters.maxDepth);
+
+    auto deepest = root;
+    while (!deepest.children().empty()) {
+        const auto children = deepest.children();
+        deepest = *std::max_element(children.begin(),
+                                    children.end(),
+                                    [](const morphio::Section& a, const morphio::Section& b) {
+                                        return a.children().size() < b.children().size();
+                                    });
+    }
+    REQUIRE(std::distance(deepest.upstream_begin(), deepest.upstream_end()) ==
+            parameters.maxDepth + 1);
+}
+
+TEST_CASE("SyntheticVasculature", "[synthetic]") {
+    morphio::synthetic::VasculatureParameters parameters;
+    parameters.sections = 500;
+    parameters.window = 20;
+    const auto vasculature = morphio::synthetic::vasculature(parameters);
+    REQUIRE(vasculature.sectionCount() == 500);
+    REQUIRE(vasculature.points().size() == 500 * parameters.pointsPerSection);
+    REQUIRE(vasculature.connectivity().size() >= 499);
+    for (const auto& connection : vasculature.connectivity()) {
+        REQUIRE(connection[0] < connection[1]);
+        REQUIRE(connection[1] - connection[0] <= parameters.window);
+    }
+
+    const morphio::vasculature::Vasculature readOnly(vasculature);
+    REQUIRE(readOnly.sections().size() == 500);
+    REQUIRE(readOnly.points() == morphio::synthetic::vasculature(parameters).points());
+
+    parameters.window = 0;
+    REQUIRE_THROWS_AS(morphio::synthetic::vasculature(parameters),
+                      morphio::SectionBuilderError);
+}
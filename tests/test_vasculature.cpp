@@ -0,0 +1,392 @@
+#include "contrib/catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <morphio/vasc/metrics.h>
+#include <morphio/vasc/mut/vasculature.h>
+#include <morphio/vasc/section.h>
+#include <morphio/vasc/vasculature.h>
+
+namespace {
+
+std::vector<uint32_t> ids(const std::vector<morphio::vasculature::Section>& sections) {
+    std::vector<uint32_t> result;
+    for (const auto& section : sections) {
+        result.push_back(section.id());
+    }
+    return result;
+}
+
+std::vector<uint32_t> ids(morphio::range<const uint32_t> range) {
+    return {range.begin(), range.end()};
+}
+
+morphio::vasculature::property::Properties diamond() {
+    // 0 -> 1, 0 -> 2, 1 -> 3, 2 -> 3: one point per section is enough for the graph
+    morphio::vasculature::property::Properties properties;
+    properties._pointLevel._points = {{0.f, 0.f, 0.f},
+                                      {1.f, 1.f, 0.f},
+                                      {1.f, -1.f, 0.f},
+                                      {2.f, 0.f, 0.f}};
+    properties._pointLevel._diameters = {1.f, 1.f, 1.f, 1.f};
+    properties._sectionLevel._sections = {0, 1, 2, 3};
+    properties._sectionLevel._sectionTypes = {morphio::SECTION_ARTERY,
+                                              morphio::SECTION_ARTERIOLE,
+                                              morphio::SECTION_ARTERIOLE,
+                                              morphio::SECTION_VEIN};
+    properties._connectivity = {{0, 2}, {0, 1}, {2, 3}, {1, 3}};
+    return properties;
+}
+
+/** Elementwise comparison of floating point arrays **/
+bool approxEqual(const std::vector<morphio::floatType>& actual,
+                 const std::vector<morphio::floatType>& expected) {
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (actual[i] != Approx(expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+TEST_CASE("VasculatureAdjacency", "[vasculature]") {
+    const morphio::vasculature::Vasculature vasculature(diamond());
+
+    // Neighbors come in the order of the connectivity
+    REQUIRE(ids(vasculature.section(0).successorIds()) == std::vector<uint32_t>{2, 1});
+    REQUIRE(ids(vasculature.section(0).predecessorIds()).empty());
+    REQUIRE(ids(vasculature.section(3).predecessorIds()) == std::vector<uint32_t>{2, 1});
+    REQUIRE(ids(vasculature.section(3).successorIds()).empty());
+
+    REQUIRE(ids(vasculature.section(1).predecessors()) == std::vector<uint32_t>{0});
+    REQUIRE(ids(vasculature.section(1).successors()) == std::vector<uint32_t>{3});
+    REQUIRE(ids(vasculature.section(2).neighbors()) == std::vector<uint32_t>{0, 3});
+}
+
+TEST_CASE("VasculatureTraversal", "[vasculature]") {
+    const morphio::vasculature::Vasculature vasculature(diamond());
+
+    std::vector<uint32_t> visited;
+    for (auto it = vasculature.begin(); it != vasculature.end(); ++it) {
+        visited.push_back((*it).id());
+    }
+    REQUIRE(visited == (std::vector<uint32_t>{0, 2, 3, 1}));
+    REQUIRE(vasculature.depthFirstOrder() == visited);
+    REQUIRE(vasculature.breadthFirstOrder() == (std::vector<uint32_t>{0, 2, 1, 3}));
+
+    // Starting from a section, predecessors come first and the start is visited once
+    visited.clear();
+    const auto section = vasculature.section(3);
+    for (auto it = section.begin(); it != section.end(); ++it) {
+        visited.push_back((*it).id());
+    }
+    REQUIRE(visited == (std::vector<uint32_t>{3, 2, 0, 1}));
+
+    // One step from 1 or from 2, 3 and 0 are pending but the visited sections differ
+    auto fromOne = ++vasculature.section(1).begin();
+    auto fromTwo = ++vasculature.section(2).begin();
+    REQUIRE((*fromOne).id() == (*fromTwo).id());
+    REQUIRE(fromOne != fromTwo);
+    REQUIRE(fromOne == ++vasculature.section(1).begin());
+
+    REQUIRE(vasculature.connectedComponents() == (std::vector<uint32_t>{0, 0, 0, 0}));
+}
+
+TEST_CASE("VasculatureComponents", "[vasculature]") {
+    // Two diamonds, the second one missing its 4 -> 6 connection: 5 has no predecessor
+    auto properties = diamond();
+    const auto other = diamond();
+    for (size_t i = 0; i < 4; ++i) {
+        properties._pointLevel._points.push_back(other._pointLevel._points[i]);
+        properties._pointLevel._diameters.push_back(other._pointLevel._diameters[i]);
+        properties._sectionLevel._sections.push_back(static_cast<uint32_t>(4 + i));
+        properties._sectionLevel._sectionTypes.push_back(other._sectionLevel._sectionTypes[i]);
+    }
+    properties._connectivity.insert(properties._connectivity.end(), {{4, 5}, {6, 7}, {5, 7}});
+    const morphio::vasculature::Vasculature vasculature(properties);
+
+    REQUIRE(vasculature.connectedComponents() ==
+            (std::vector<uint32_t>{0, 0, 0, 0, 1, 1, 1, 1}));
+    // Roots 0, 4 and 6: the last one first
+    REQUIRE(vasculature.depthFirstOrder() == (std::vector<uint32_t>{6, 7, 5, 4, 0, 2, 3, 1}));
+    REQUIRE(vasculature.breadthFirstOrder() == (std::vector<uint32_t>{0, 4, 6, 2, 1, 5, 7, 3}));
+
+    std::vector<uint32_t> visited;
+    const auto section = vasculature.section(5);
+    for (auto it = section.begin(); it != section.end(); ++it) {
+        visited.push_back((*it).id());
+    }
+    REQUIRE(visited == (std::vector<uint32_t>{5, 4, 7, 6}));
+}
+
+TEST_CASE("VasculatureBadConnectivity", "[vasculature]") {
+    auto properties = diamond();
+    properties._connectivity.push_back({3, 4});
+    REQUIRE_THROWS_AS(morphio::vasculature::Vasculature(properties), morphio::RawDataError);
+}
+
+TEST_CASE("VasculatureSectionRange", "[vasculature]") {
+    const morphio::vasculature::Vasculature full("data/h5/vasculature1.h5");
+    const morphio::vasculature::Vasculature part("data/h5/vasculature1.h5", 100, 500);
+    const auto offsets = full.sectionOffsets();
+
+    REQUIRE(part.sectionTypes().size() == 400);
+    REQUIRE(part.points().size() == offsets[500] - offsets[100]);
+    for (uint32_t id = 0; id < 400; ++id) {
+        REQUIRE(part.sectionTypes()[id] == full.sectionTypes()[id + 100]);
+        REQUIRE(part.sectionOffsets()[id] == offsets[id + 100] - offsets[100]);
+        std::vector<uint32_t> successors;
+        for (const uint32_t successor : full.section(id + 100).successorIds()) {
+            if (successor >= 100 && successor < 500) {
+                successors.push_back(successor - 100);
+            }
+        }
+        REQUIRE(ids(part.section(id).successorIds()) == successors);
+    }
+    REQUIRE((part.points().front() == full.points()[offsets[100]]));
+    REQUIRE((part.points().back() == full.points()[offsets[500] - 1]));
+
+    REQUIRE_THROWS_AS(morphio::vasculature::Vasculature("data/h5/vasculature1.h5", 10, 5),
+                      morphio::RawDataError);
+    REQUIRE_THROWS_AS(morphio::vasculature::Vasculature("data/h5/vasculature1.h5", 0, 3081),
+                      morphio::RawDataError);
+}
+
+TEST_CASE("VasculatureSubgraph", "[vasculature]") {
+    const morphio::vasculature::Vasculature vasculature(diamond());
+    const auto subgraph = vasculature.subgraph({3, 1, 0});
+
+    REQUIRE(subgraph.sectionTypes() == (std::vector<morphio::VascularSectionType>{
+                                           morphio::SECTION_VEIN,
+                                           morphio::SECTION_ARTERIOLE,
+                                           morphio::SECTION_ARTERY}));
+    REQUIRE((subgraph.points() ==
+             morphio::Points{{2.f, 0.f, 0.f}, {1.f, 1.f, 0.f}, {0.f, 0.f, 0.f}}));
+    // 0 -> 1 and 1 -> 3 remain, as 2 -> 1 and 1 -> 0
+    REQUIRE(ids(subgraph.section(2).successorIds()) == std::vector<uint32_t>{1});
+    REQUIRE(ids(subgraph.section(1).successorIds()) == std::vector<uint32_t>{0});
+    REQUIRE(ids(subgraph.section(0).successorIds()).empty());
+    REQUIRE(subgraph.connectedComponents() == (std::vector<uint32_t>{0, 0, 0}));
+
+    REQUIRE(vasculature.subgraph({}).points().empty());
+    REQUIRE_THROWS_AS(vasculature.subgraph({0, 4}), morphio::RawDataError);
+    REQUIRE_THROWS_AS(vasculature.subgraph({1, 2, 1}), morphio::RawDataError);
+}
+
+TEST_CASE("VasculatureRegion", "[vasculature]") {
+    const morphio::vasculature::Vasculature full("data/h5/vasculature1.h5");
+    morphio::BoundingBox bounds{full.points().front(), full.points().front()};
+    for (const auto& point : full.points()) {
+        bounds.expand(point);
+    }
+    // The central half of the vasculature along each axis
+    morphio::BoundingBox region = bounds;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const morphio::floatType quarter = (bounds.max[axis] - bounds.min[axis]) / 4;
+        region.min[axis] += quarter;
+        region.max[axis] -= quarter;
+    }
+
+    std::vector<uint32_t> expected;
+    for (const auto& section : full.sections()) {
+        const auto points = section.points();
+        const auto diameters = section.diameters();
+        auto box = [&points, &diameters](size_t i) {
+            morphio::BoundingBox result{points[i], points[i]};
+            for (size_t axis = 0; axis < 3; ++axis) {
+                result.min[axis] -= diameters[i] / 2;
+                result.max[axis] += diameters[i] / 2;
+            }
+            return result;
+        };
+        for (size_t i = 0; i < points.size(); ++i) {
+            morphio::BoundingBox segment = box(i);
+            segment.expand(box(std::min(i + 1, points.size() - 1)));
+            if (region.intersects(segment)) {
+                expected.push_back(section.id());
+                break;
+            }
+        }
+    }
+    REQUIRE(!expected.empty());
+    REQUIRE(expected.size() < full.sectionTypes().size());
+
+    const morphio::vasculature::Vasculature loaded("data/h5/vasculature1.h5", region);
+    const auto subgraph = full.subgraph(expected);
+    REQUIRE(loaded.sectionTypes() == subgraph.sectionTypes());
+    REQUIRE(loaded.sectionOffsets() == subgraph.sectionOffsets());
+    REQUIRE((loaded.points() == subgraph.points()));
+    REQUIRE(loaded.diameters() == subgraph.diameters());
+    for (uint32_t id = 0; id < expected.size(); ++id) {
+        REQUIRE(ids(loaded.section(id).successorIds()) == ids(subgraph.section(id).successorIds()));
+    }
+}
+
+TEST_CASE("MutVasculatureBulk", "[vasculature]") {
+    using Connections = std::vector<morphio::vasculature::property::Connection::Type>;
+    const auto properties = diamond();
+    const auto& points = properties._pointLevel._points;
+    const auto& diameters = properties._pointLevel._diameters;
+    const auto& types = properties._sectionLevel._sectionTypes;
+
+    morphio::vasculature::mut::Vasculature vasculature;
+    REQUIRE(vasculature.appendSections(
+                points, diameters, {0, 1, 2, 3}, types, properties._connectivity) == 0);
+    // Two more sections of two points, connected to the first diamond
+    const morphio::Points newPoints{
+        {2.f, 0.f, 0.f}, {3.f, 0.f, 0.f}, {3.f, 0.f, 0.f}, {4.f, 0.f, 0.f}};
+    REQUIRE(vasculature.appendSections(newPoints,
+                                       {1.f, 1.f, 1.f, 1.f},
+                                       {0, 2},
+                                       {morphio::SECTION_VEIN, morphio::SECTION_VEIN},
+                                       {{3, 4}, {4, 5}}) == 4);
+    vasculature.appendConnections({{0, 5}});
+    REQUIRE(vasculature.sectionCount() == 6);
+    REQUIRE(vasculature.sectionOffsets() == (std::vector<uint32_t>{0, 1, 2, 3, 4, 6, 8}));
+    REQUIRE(vasculature.connectivity().size() == 7);
+
+    SECTION("invalid appends leave the vasculature unchanged") {
+        REQUIRE_THROWS_AS(vasculature.appendSections(points, {1.f}, {0}, {types[0]}),
+                          morphio::SectionBuilderError);
+        REQUIRE_THROWS_AS(vasculature.appendSections(points, diameters, {0, 2, 2, 3}, types),
+                          morphio::SectionBuilderError);
+        REQUIRE_THROWS_AS(
+            vasculature.appendSections(points, diameters, {0, 1, 2, 3}, types, {{0, 10}}),
+            morphio::SectionBuilderError);
+        REQUIRE_THROWS_AS(vasculature.appendConnections({{6, 0}}), morphio::SectionBuilderError);
+        REQUIRE(vasculature.sectionCount() == 6);
+        REQUIRE(vasculature.points().size() == 8);
+        REQUIRE(vasculature.connectivity().size() == 7);
+    }
+
+    SECTION("delete sections") {
+        vasculature.deleteSections({1, 4});
+        REQUIRE(vasculature.sectionCount() == 4);
+        REQUIRE(vasculature.sectionOffsets() == (std::vector<uint32_t>{0, 1, 2, 3, 5}));
+        REQUIRE((vasculature.points() == morphio::Points{{0.f, 0.f, 0.f},
+                                                         {1.f, -1.f, 0.f},
+                                                         {2.f, 0.f, 0.f},
+                                                         {3.f, 0.f, 0.f},
+                                                         {4.f, 0.f, 0.f}}));
+        REQUIRE(vasculature.sectionTypes() == (std::vector<morphio::VascularSectionType>{
+                                                  morphio::SECTION_ARTERY,
+                                                  morphio::SECTION_ARTERIOLE,
+                                                  morphio::SECTION_VEIN,
+                                                  morphio::SECTION_VEIN}));
+        // Old 0 -> 2, 2 -> 3 and 0 -> 5 remain
+        REQUIRE((vasculature.connectivity() == Connections{{0, 1}, {1, 2}, {0, 3}}));
+        REQUIRE_THROWS_AS(vasculature.deleteSections({4}), morphio::SectionBuilderError);
+
+        const morphio::vasculature::Vasculature readOnly(vasculature);
+        REQUIRE(ids(readOnly.section(0).successorIds()) == (std::vector<uint32_t>{1, 3}));
+        REQUIRE(ids(readOnly.section(3).predecessorIds()) == std::vector<uint32_t>{0});
+    }
+
+    SECTION("edit in place and build") {
+        vasculature.sectionPoints(5)[0] = {5.f, 0.f, 0.f};
+        vasculature.sectionDiameters(5)[1] = 3.f;
+        REQUIRE_THROWS_AS(vasculature.sectionPoints(6), morphio::SectionBuilderError);
+
+        const auto copy = vasculature.buildReadOnly();
+        const auto moved = std::move(vasculature).buildReadOnly();
+        REQUIRE(copy == moved);
+        REQUIRE((moved._pointLevel._points[6] == morphio::Point{5.f, 0.f, 0.f}));
+        REQUIRE(moved._pointLevel._diameters[7] == 3.f);
+        REQUIRE(vasculature.points().empty());
+    }
+}
+
+TEST_CASE("MutVasculatureWrite", "[vasculature]") {
+    const std::string path = "vasculature_round_trip.h5";
+    const morphio::vasculature::Vasculature expected("data/h5/vasculature1.h5");
+    morphio::vasculature::mut::Vasculature vasculature("data/h5/vasculature1.h5");
+    vasculature.write(path);
+
+    const morphio::vasculature::Vasculature loaded(path);
+    REQUIRE((loaded.points() == expected.points()));
+    REQUIRE(loaded.diameters() == expected.diameters());
+    REQUIRE(loaded.sectionTypes() == expected.sectionTypes());
+    REQUIRE(loaded.sectionOffsets() == expected.sectionOffsets());
+    for (uint32_t id = 0; id < expected.sectionTypes().size(); ++id) {
+        REQUIRE(ids(loaded.section(id).predecessorIds()) ==
+                ids(expected.section(id).predecessorIds()));
+        REQUIRE(ids(loaded.section(id).successorIds()) ==
+                ids(expected.section(id).successorIds()));
+    }
+
+    REQUIRE_THROWS_AS(vasculature.write("vasculature.swc"), morphio::UnknownFileType);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("VasculatureMetrics", "[vasculature]") {
+    namespace metrics = morphio::vasculature::metrics;
+    const morphio::floatType pi = morphio::PI;
+
+    // A bend with two branches at its end, and a lone one point section
+    morphio::vasculature::property::Properties properties;
+    properties._pointLevel._points = {{0.f, 0.f, 0.f},
+                                      {3.f, 0.f, 0.f},
+                                      {3.f, 4.f, 0.f},
+                                      {3.f, 4.f, 0.f},
+                                      {3.f, 4.f, 1.f},
+                                      {3.f, 4.f, 0.f},
+                                      {3.f, 5.f, 0.f},
+                                      {9.f, 9.f, 9.f}};
+    properties._pointLevel._diameters = {2.f, 2.f, 2.f, 2.f, 4.f, 2.f, 2.f, 1.f};
+    properties._sectionLevel._sections = {0, 3, 5, 7};
+    properties._sectionLevel._sectionTypes.assign(4, morphio::SECTION_ARTERY);
+    properties._connectivity = {{0, 1}, {0, 2}};
+    const morphio::vasculature::Vasculature vasculature(properties);
+    const auto& built = vasculature.properties();
+
+    REQUIRE(metrics::segmentOffsets(built) == (std::vector<uint32_t>{0, 2, 3, 4, 4}));
+    REQUIRE(approxEqual(metrics::segmentLengths(built), {3.f, 4.f, 1.f, 1.f}));
+    REQUIRE(approxEqual(metrics::sectionLengths(built), {7.f, 1.f, 1.f, 0.f}));
+    REQUIRE(approxEqual(metrics::segmentVolumes(built), {3 * pi, 4 * pi, 7 * pi / 3, pi}));
+    REQUIRE(approxEqual(metrics::sectionVolumes(built), {7 * pi, 7 * pi / 3, pi, 0.f}));
+    REQUIRE(approxEqual(metrics::segmentLateralAreas(built),
+                        {6 * pi, 8 * pi, 3 * std::sqrt(2.f) * pi, 2 * pi}));
+    REQUIRE(approxEqual(metrics::sectionLateralAreas(built),
+                        {14 * pi, 3 * std::sqrt(2.f) * pi, 2 * pi, 0.f}));
+    REQUIRE(approxEqual(metrics::sectionMeanDiameters(built), {2.f, 3.f, 2.f, 1.f}));
+    REQUIRE(metrics::degrees(built) == (std::vector<uint32_t>{2, 1, 1, 0}));
+    // Without the predecessor and successor arrays, as built by mut::Vasculature
+    REQUIRE(metrics::degrees(properties) == metrics::degrees(built));
+    auto broken = properties;
+    broken._connectivity.push_back({0, 4});
+    REQUIRE_THROWS_AS(metrics::degrees(broken), morphio::RawDataError);
+    REQUIRE_THROWS_AS(metrics::vesselGraph(broken), morphio::RawDataError);
+
+    const auto graph = metrics::vesselGraph(built);
+    REQUIRE(graph.nodeCount == 6);
+    REQUIRE(graph.sources == (std::vector<uint32_t>{0, 1, 1, 4}));
+    REQUIRE(graph.targets == (std::vector<uint32_t>{1, 2, 3, 5}));
+    REQUIRE(approxEqual(graph.lengths, {7.f, 1.f, 1.f, 0.f}));
+    REQUIRE(approxEqual(graph.diameters, {2.f, 3.f, 2.f, 1.f}));
+
+    SECTION("threads") {
+        const morphio::vasculature::Vasculature file("data/h5/vasculature1.h5");
+        const auto lengths = metrics::sectionLengths(file.properties(), 1);
+        REQUIRE(metrics::sectionLengths(file.properties(), 4) == lengths);
+        REQUIRE(metrics::segmentVolumes(file.properties(), 1) ==
+                metrics::segmentVolumes(file.properties(), 3));
+        const auto segments = metrics::segmentLengths(file.properties(), 4);
+        const auto offsets = metrics::segmentOffsets(file.properties());
+        for (uint32_t i = 0; i < lengths.size(); ++i) {
+            morphio::floatType sum = 0;
+            for (uint32_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+                sum += segments[j];
+            }
+            REQUIRE(lengths[i] == Approx(sum));
+            REQUIRE(lengths[i] >= file.section(i).length() * (1 - morphio::epsilon));
+        }
+    }
+}
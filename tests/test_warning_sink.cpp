@@ -0,0 +1,132 @@
+#include "contrib/catch.hpp"
+
+#include <memory>
+#include <thread>
+
+#include <morphio/errorMessages.h>
+#include <morphio/morphology.h>
+#include <morphio/warning_sink.h>
+
+TEST_CASE("WarningSinkCollect", "[warning_sink]") {
+    morphio::CollectingWarningSink warnings;
+    {
+        morphio::ScopedWarningSink scope(warnings);
+        morphio::Morphology("data/neurite_wrong_root_point.swc");
+    }
+    morphio::printError(morphio::Warning::UNDEFINED, "not collected");
+
+    const auto records = warnings.records();
+    REQUIRE(!records.empty());
+    for (const auto& record : records) {
+        REQUIRE(record.warning == morphio::Warning::WRONG_ROOT_POINT);
+        REQUIRE(record.message.find("neurite_wrong_root_point.swc") != std::string::npos);
+    }
+
+    warnings.clear();
+    REQUIRE(warnings.records().empty());
+}
+
+TEST_CASE("WarningSinkNested", "[warning_sink]") {
+    morphio::CountingWarningSink outer;
+    morphio::CountingWarningSink inner;
+    {
+        morphio::ScopedWarningSink outerScope(outer);
+        morphio::printError(morphio::Warning::ONLY_CHILD, "outer");
+        {
+            morphio::ScopedWarningSink innerScope(inner);
+            morphio::printError(morphio::Warning::ONLY_CHILD, "inner");
+            morphio::printError(morphio::Warning::WRONG_DUPLICATE, "inner");
+        }
+        morphio::printError(morphio::Warning::ONLY_CHILD, "outer");
+    }
+    REQUIRE(outer.count(morphio::Warning::ONLY_CHILD) == 2);
+    REQUIRE(outer.total() == 2);
+    REQUIRE(inner.count(morphio::Warning::ONLY_CHILD) == 1);
+    REQUIRE(inner.count(morphio::Warning::WRONG_DUPLICATE) == 1);
+    REQUIRE(inner.total() == 2);
+
+    // Ignored warnings reach no sink
+    morphio::set_ignored_warning(morphio::Warning::ONLY_CHILD, true);
+    {
+        morphio::ScopedWarningSink scope(outer);
+        morphio::printError(morphio::Warning::ONLY_CHILD, "ignored");
+    }
+    morphio::set_ignored_warning(morphio::Warning::ONLY_CHILD, false);
+    REQUIRE(outer.total() == 2);
+}
+
+TEST_CASE("WarningSinkPerThread", "[warning_sink]") {
+    const auto global = std::make_shared<morphio::CountingWarningSink>();
+    morphio::CountingWarningSink scoped;
+    morphio::set_warning_sink(global);
+    {
+        morphio::ScopedWarningSink scope(scoped);
+        std::thread other([]() { morphio::printError(morphio::Warning::UNDEFINED, "other"); });
+        other.join();
+        morphio::printError(morphio::Warning::UNDEFINED, "scoped");
+    }
+    morphio::printError(morphio::Warning::UNDEFINED, "global");
+    morphio::set_warning_sink(nullptr);
+    morphio::printError(morphio::Warning::UNDEFINED, "stderr");
+
+    REQUIRE(global->count(morphio::Warning::UNDEFINED) == 2);
+    REQUIRE(scoped.count(morphio::Warning::UNDEFINED) == 1);
+}
+
+TEST_CASE("WarningSinkReleased", "[warning_sink]") {
+    auto sink = std::make_shared<morphio::NullWarningSink>();
+    const std::weak_ptr<morphio::NullWarningSink> watched = sink;
+    morphio::set_warning_sink(std::move(sink));
+    morphio::printError(morphio::Warning::UNDEFINED, "dropped");
+    REQUIRE(!watched.expired());
+    morphio::set_warning_sink(nullptr);
+    REQUIRE(watched.expired());
+}
+
+TEST_CASE("WarningSinkCallback", "[warning_sink]") {
+    int formatted = 0;
+    int emitted = 0;
+    morphio::CallbackWarningSink callback(
+        [&emitted](const morphio::WarningMessage& message) {
+            REQUIRE(message.warning == morphio::Warning::BROKEN_SECTION);
+            ++emitted;
+        });
+    morphio::NullWarningSink null;
+    REQUIRE(null.discards());
+    REQUIRE(!callback.discards());
+
+    struct Message: public morphio::WarningMessage {
+        explicit Message(int& formatted_)
+            : morphio::WarningMessage(morphio::Warning::BROKEN_SECTION)
+            , formatted(formatted_) {}
+        std::string msg() const override {
+            ++formatted;
+            return "broken";
+        }
+        int& formatted;
+    };
+
+    {
+        morphio::ScopedWarningSink scope(callback);
+        morphio::printError(Message(formatted));
+    }
+    {
+        morphio::ScopedWarningSink scope(null);
+        morphio::printError(Message(formatted));
+    }
+    REQUIRE(emitted == 1);
+    REQUIRE(formatted == 0);
+}
+
+TEST_CASE("WarningSinkBrokenSection", "[warning_sink]") {
+    morphio::CollectingWarningSink warnings;
+    {
+        morphio::ScopedWarningSink scope(warnings);
+        morphio::printError(morphio::BrokenSectionWarning(3, {5, 5}));
+    }
+    const auto records = warnings.records();
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].warning == morphio::Warning::BROKEN_SECTION);
+    REQUIRE(records[0].message ==
+            "Dereferencing broken properties section 3\nSection range: 5 -> 5");
+}
@@ -0,0 +1,163 @@
+#include <cerrno>     // errno, ERANGE
+#include <cstdlib>    // std::strtod, std::strtoull
+#include <cstring>    // std::strcmp
+#include <iostream>   // std::cout, std::cerr
+#include <limits>     // std::numeric_limits
+#include <stdexcept>  // std::invalid_argument, std::out_of_range
+#include <string>     // std::string
+
+#include <morphio/errorMessages.h>
+#include <morphio/exceptions.h>
+#include <morphio/synthetic.h>
+
+namespace {
+
+void usage(const char* program) {
+    std::cout
+        << "Usage: " << program << " neuron OUTPUT [OPTIONS]\n"
+        << "       " << program << " vasculature OUTPUT.h5 [OPTIONS]\n"
+        << "Writes a synthetic morphology, in the format given by the extension of OUTPUT\n\n"
+        << "Common options:\n"
+        << "  --seed N                seed of the random generator (0)\n"
+        << "  --points N              points per section (neuron: 10, vasculature: 4)\n\n"
+        << "Neuron options:\n"
+        << "  --neurites N            number of neurites (4)\n"
+        << "  --max-depth N           depth of the deepest sections, roots being at 0 (10)\n"
+        << "  --fan-out N             children per branching section (2)\n"
+        << "  --max-sections N        stop at N sections, 0 for no limit (0)\n"
+        << "  --segment-length X      distance between consecutive points (2)\n"
+        << "  --unifurcation-rate X   probability of a single child (0)\n"
+        << "  --leaf-rate X           probability for each child but the first to be a leaf (0)\n"
+        << "  --mitochondria N        number of mitochondria (0)\n"
+        << "  --reticulum-rate X      fraction of sections with endoplasmic reticulum (0)\n\n"
+        << "Vasculature options:\n"
+        << "  --sections N            number of sections (1000)\n"
+        << "  --window N              sections continue one of the N sections before (1000)\n"
+        << "  --loop-rate X           probability of a second predecessor (0.1)\n";
+}
+
+/**
+   Parse the value of an option, throwing std::invalid_argument if it is not a number and
+   std::out_of_range if it does not fit in 32 bits
+**/
+uint32_t toCount(const std::string& option, const char* value) {
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long result = std::strtoull(value, &end, 10);
+    if (*value == '\0' || *end != '\0' || *value == '-') {
+        throw std::invalid_argument(option + " expects a positive integer, got: " + value);
+    }
+    if (errno == ERANGE || result > std::numeric_limits<uint32_t>::max()) {
+        throw std::out_of_range(option + " expects at most " +
+                                std::to_string(std::numeric_limits<uint32_t>::max()) +
+                                ", got: " + value);
+    }
+    return static_cast<uint32_t>(result);
+}
+
+morphio::floatType toReal(const std::string& option, const char* value) {
+    char* end = nullptr;
+    const double result = std::strtod(value, &end);
+    if (*value == '\0' || *end != '\0') {
+        throw std::invalid_argument(option + " expects a number, got: " + value);
+    }
+    return static_cast<morphio::floatType>(result);
+}
+
+/** Set the neuron parameter named by option, return false if there is none **/
+bool setNeuronParameter(morphio::synthetic::NeuronParameters& parameters,
+                        const std::string& option,
+                        const char* value) {
+    if (option == "--seed") {
+        parameters.seed = toCount(option, value);
+    } else if (option == "--points") {
+        parameters.pointsPerSection = toCount(option, value);
+    } else if (option == "--neurites") {
+        parameters.neurites = toCount(option, value);
+    } else if (option == "--max-depth") {
+        parameters.maxDepth = toCount(option, value);
+    } else if (option == "--fan-out") {
+        parameters.fanOut = toCount(option, value);
+    } else if (option == "--max-sections") {
+        parameters.maxSections = toCount(option, value);
+    } else if (option == "--segment-length") {
+        parameters.segmentLength = toReal(option, value);
+    } else if (option == "--unifurcation-rate") {
+        parameters.unifurcationRate = toReal(option, value);
+    } else if (option == "--leaf-rate") {
+        parameters.leafRate = toReal(option, value);
+    } else if (option == "--mitochondria") {
+        parameters.mitochondria = toCount(option, value);
+    } else if (option == "--reticulum-rate") {
+        parameters.reticulumRate = toReal(option, value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/** Set the vasculature parameter named by option, return false if there is none **/
+bool setVasculatureParameter(morphio::synthetic::VasculatureParameters& parameters,
+                             const std::string& option,
+                             const char* value) {
+    if (option == "--seed") {
+        parameters.seed = toCount(option, value);
+    } else if (option == "--points") {
+        parameters.pointsPerSection = toCount(option, value);
+    } else if (option == "--sections") {
+        parameters.sections = toCount(option, value);
+    } else if (option == "--window") {
+        parameters.window = toCount(option, value);
+    } else if (option == "--loop-rate") {
+        parameters.loopRate = toReal(option, value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3 || std::strcmp(argv[1], "--help") == 0) {
+        usage(argv[0]);
+        return argc < 3 ? 1 : 0;
+    }
+    const std::string kind = argv[1];
+    const std::string output = argv[2];
+    if (kind != "neuron" && kind != "vasculature") {
+        usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        morphio::synthetic::NeuronParameters neuronParameters;
+        morphio::synthetic::VasculatureParameters vasculatureParameters;
+        for (int i = 3; i < argc; i += 2) {
+            const std::string option = argv[i];
+            if (i + 1 == argc) {
+                throw std::invalid_argument(option + " expects a value");
+            }
+            const bool known = kind == "neuron"
+                                   ? setNeuronParameter(neuronParameters, option, argv[i + 1])
+                                   : setVasculatureParameter(vasculatureParameters,
+                                                             option,
+                                                             argv[i + 1]);
+            if (!known) {
+                throw std::invalid_argument("Unknown option for a " + kind + ": " + option);
+            }
+        }
+
+        if (kind == "neuron") {
+            // Unifurcations and organelles are written as asked, without warnings
+            morphio::set_maximum_warnings(0);
+            morphio::synthetic::neuron(neuronParameters).write(output);
+        } else {
+            morphio::synthetic::vasculature(vasculatureParameters).write(output);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}